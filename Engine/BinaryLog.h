@@ -0,0 +1,85 @@
+#pragma once
+#include "DataStructrue.h"
+#include <cstdint>
+#include <cstring>
+
+// 二进制遥测日志格式: 64 字节文件头 + 若干 64 字节定长记录, 小端存储
+
+const char BINARY_LOG_MAGIC[8] = {'E', 'N', 'G', 'L', 'O', 'G', 'B', '1'};
+const uint32_t BINARY_LOG_VERSION = 1;
+
+// 记录中状态未知 (调用方未提供 EngineState) 时的取值
+const uint8_t RECORD_STATE_UNKNOWN = 0xFF;
+
+enum class RecordKind : uint8_t
+{
+    SAMPLE = 1, // 每个仿真步的数值数据
+    ALERT = 2,  // 报警事件
+};
+
+struct BinaryLogHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t record_size;
+    uint8_t reserved[48];
+};
+
+struct TelemetryRecord
+{
+    uint8_t kind;      // RecordKind
+    uint8_t state;     // EngineState 或 RECORD_STATE_UNKNOWN
+    uint16_t validity; // packSensorValidity 格式
+    uint32_t reserved;
+    double time;
+    union
+    {
+        // rpm_1, rpm_2, egt1_temp, egt2_temp, fuel_v, fuel_c (与 CSV 列顺序一致)
+        double values[6];
+        char text[48]; // 报警文本, 以 '\0' 结尾, 超长截断
+    } payload;
+};
+
+static_assert(sizeof(BinaryLogHeader) == 64, "BinaryLogHeader must be 64 bytes");
+static_assert(sizeof(TelemetryRecord) == 64, "TelemetryRecord must be 64 bytes");
+
+inline TelemetryRecord makeSampleRecord(double time, const EngineSnapshot &data, uint8_t state)
+{
+    TelemetryRecord rec;
+    rec.kind = (uint8_t)RecordKind::SAMPLE;
+    rec.state = state;
+    rec.validity = packSensorValidity(data);
+    rec.reserved = 0;
+    rec.time = time;
+    rec.payload.values[0] = data.rpm_1;
+    rec.payload.values[1] = data.rpm_2;
+    rec.payload.values[2] = data.egt1_temp;
+    rec.payload.values[3] = data.egt2_temp;
+    rec.payload.values[4] = data.fuel_v;
+    rec.payload.values[5] = data.fuel_c;
+    return rec;
+}
+
+inline TelemetryRecord makeAlertRecord(double time, const char *msg, size_t len)
+{
+    TelemetryRecord rec;
+    rec.kind = (uint8_t)RecordKind::ALERT;
+    rec.state = RECORD_STATE_UNKNOWN;
+    rec.validity = 0;
+    rec.reserved = 0;
+    rec.time = time;
+    std::memset(rec.payload.text, 0, sizeof(rec.payload.text));
+    std::memcpy(rec.payload.text, msg, len < sizeof(rec.payload.text) ? len : sizeof(rec.payload.text) - 1);
+    return rec;
+}
+
+inline void recordToSnapshot(const TelemetryRecord &rec, EngineSnapshot &data)
+{
+    data.rpm_1 = rec.payload.values[0];
+    data.rpm_2 = rec.payload.values[1];
+    data.egt1_temp = rec.payload.values[2];
+    data.egt2_temp = rec.payload.values[3];
+    data.fuel_v = rec.payload.values[4];
+    data.fuel_c = rec.payload.values[5];
+    unpackSensorValidity(rec.validity, data);
+}
@@ -0,0 +1,213 @@
+#include "BinaryLogger.h"
+#include "Logger.h"
+#include <chrono>
+#include <cstring>
+#include <vector>
+
+BinaryLogger::BinaryLogger()
+    : file(nullptr), stop_requested(false), records_pushed(0), ring_overflows(0), records_written(0),
+      bytes_written(0), write_calls(0), max_lag_records(0), max_write_ns(0)
+{
+}
+
+BinaryLogger::~BinaryLogger()
+{
+    close();
+}
+
+bool BinaryLogger::open(const std::string &path, size_t ring_capacity)
+{
+    close();
+
+    file = std::fopen(path.c_str(), "wb");
+    if (!file)
+        return false;
+
+    // 由本类自行攒成整块, 关闭 stdio 缓冲
+    std::setvbuf(file, nullptr, _IONBF, 0);
+
+    BinaryLogHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, BINARY_LOG_MAGIC, sizeof(header.magic));
+    header.version = BINARY_LOG_VERSION;
+    header.record_size = sizeof(TelemetryRecord);
+    std::fwrite(&header, sizeof(header), 1, file);
+
+    ring.reset(new SpscRing<TelemetryRecord>(ring_capacity));
+    block.reset(new Block);
+    stop_requested.store(false);
+    writer = std::thread(&BinaryLogger::writerLoop, this);
+    return true;
+}
+
+void BinaryLogger::close()
+{
+    if (writer.joinable())
+    {
+        stop_requested.store(true, std::memory_order_release);
+        writer.join();
+    }
+    if (file)
+    {
+        std::fclose(file);
+        file = nullptr;
+    }
+}
+
+bool BinaryLogger::isOpen() const
+{
+    return file != nullptr;
+}
+
+bool BinaryLogger::push(const TelemetryRecord &record)
+{
+    if (!ring)
+        return false;
+    if (!ring->tryPush(record))
+    {
+        ring_overflows.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    records_pushed.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void BinaryLogger::writeRecords(const TelemetryRecord *records, size_t count)
+{
+    auto begin = std::chrono::steady_clock::now();
+    size_t bytes = count * sizeof(TelemetryRecord);
+    std::fwrite(records, 1, bytes, file);
+    auto end = std::chrono::steady_clock::now();
+
+    uint64_t ns = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count();
+    if (ns > max_write_ns.load(std::memory_order_relaxed))
+        max_write_ns.store(ns, std::memory_order_relaxed);
+
+    records_written.fetch_add(count, std::memory_order_relaxed);
+    bytes_written.fetch_add(bytes, std::memory_order_relaxed);
+    write_calls.fetch_add(1, std::memory_order_relaxed);
+}
+
+void BinaryLogger::writerLoop()
+{
+    size_t filled = 0;
+
+    while (true)
+    {
+        // 先读停止标志, 保证停止前压入的记录都能取到
+        bool stopping = stop_requested.load(std::memory_order_acquire);
+
+        uint64_t lag = ring->size();
+        if (lag > max_lag_records.load(std::memory_order_relaxed))
+            max_lag_records.store(lag, std::memory_order_relaxed);
+
+        size_t n = ring->popBatch(block->records + filled, RECORDS_PER_BLOCK - filled);
+        filled += n;
+
+        if (filled == RECORDS_PER_BLOCK)
+        {
+            writeRecords(block->records, filled);
+            filled = 0;
+            continue;
+        }
+
+        if (n == 0)
+        {
+            if (stopping)
+                break;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    if (filled > 0)
+        writeRecords(block->records, filled);
+    std::fflush(file);
+}
+
+BinaryLoggerStats BinaryLogger::getStats() const
+{
+    BinaryLoggerStats stats;
+    stats.records_pushed = records_pushed.load(std::memory_order_relaxed);
+    stats.records_written = records_written.load(std::memory_order_relaxed);
+    stats.ring_overflows = ring_overflows.load(std::memory_order_relaxed);
+    stats.bytes_written = bytes_written.load(std::memory_order_relaxed);
+    stats.write_calls = write_calls.load(std::memory_order_relaxed);
+    stats.max_lag_records = max_lag_records.load(std::memory_order_relaxed);
+    stats.max_write_ms = max_write_ns.load(std::memory_order_relaxed) / 1e6;
+    return stats;
+}
+
+bool BinaryLogger::convertToCsv(const std::string &binary_path, const std::string &csv_path)
+{
+    BinaryLogReader reader;
+    if (!reader.open(binary_path))
+        return false;
+
+    Logger csv(csv_path);
+    if (!csv.isOpen())
+        return false;
+
+    std::vector<TelemetryRecord> batch(RECORDS_PER_BLOCK);
+    EngineSnapshot data = {};
+    size_t n;
+    while ((n = reader.read(batch.data(), batch.size())) > 0)
+    {
+        for (size_t i = 0; i < n; i++)
+        {
+            const TelemetryRecord &rec = batch[i];
+            if (rec.kind == (uint8_t)RecordKind::SAMPLE)
+            {
+                recordToSnapshot(rec, data);
+                csv.log(rec.time, data);
+            }
+            else if (rec.kind == (uint8_t)RecordKind::ALERT)
+            {
+                // 读自文件的记录不一定以 '\0' 结尾 (损坏或其他程序写出), 长度不超过字段大小
+                csv.logAlert(rec.time, rec.payload.text, strnlen(rec.payload.text, sizeof(rec.payload.text)));
+            }
+        }
+    }
+    return true;
+}
+
+BinaryLogReader::BinaryLogReader() : file(nullptr) {}
+
+BinaryLogReader::~BinaryLogReader()
+{
+    close();
+}
+
+bool BinaryLogReader::open(const std::string &path)
+{
+    close();
+
+    file = std::fopen(path.c_str(), "rb");
+    if (!file)
+        return false;
+
+    BinaryLogHeader header;
+    if (std::fread(&header, sizeof(header), 1, file) != 1 ||
+        std::memcmp(header.magic, BINARY_LOG_MAGIC, sizeof(header.magic)) != 0 ||
+        header.record_size != sizeof(TelemetryRecord))
+    {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void BinaryLogReader::close()
+{
+    if (file)
+    {
+        std::fclose(file);
+        file = nullptr;
+    }
+}
+
+size_t BinaryLogReader::read(TelemetryRecord *out, size_t max_count)
+{
+    if (!file)
+        return 0;
+    return std::fread(out, sizeof(TelemetryRecord), max_count, file);
+}
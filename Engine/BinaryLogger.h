@@ -0,0 +1,86 @@
+#pragma once
+#include "BinaryLog.h"
+#include "SpscRing.h"
+#include <atomic>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+
+struct BinaryLoggerStats
+{
+    uint64_t records_pushed;  // 仿真线程成功写入环形缓冲区的记录数
+    uint64_t records_written; // 写线程已落盘的记录数
+    uint64_t ring_overflows;  // 缓冲区满而丢弃的记录数
+    uint64_t bytes_written;
+    uint64_t write_calls;
+    uint64_t max_lag_records; // 写线程落后的最大记录数 (缓冲区占用高水位)
+    double max_write_ms;      // 单次写盘的最长耗时
+};
+
+// 异步二进制日志: 仿真线程只向无锁环形缓冲区压入定长记录, 后台线程成批整块写盘
+class BinaryLogger
+{
+public:
+    BinaryLogger();
+    ~BinaryLogger();
+
+    bool open(const std::string &path, size_t ring_capacity = 1 << 16);
+    void close();
+    bool isOpen() const;
+
+    // 仿真线程调用, 不阻塞; 缓冲区满时丢弃并计入 ring_overflows
+    bool push(const TelemetryRecord &record);
+
+    BinaryLoggerStats getStats() const;
+
+    // 将二进制日志转换为 Logger 的 CSV 格式
+    static bool convertToCsv(const std::string &binary_path, const std::string &csv_path);
+
+private:
+    // 每次写盘的块大小, 按页对齐
+    static const size_t BLOCK_SIZE = 64 * 1024;
+    static const size_t RECORDS_PER_BLOCK = BLOCK_SIZE / sizeof(TelemetryRecord);
+
+    struct alignas(4096) Block
+    {
+        TelemetryRecord records[RECORDS_PER_BLOCK];
+    };
+
+    void writerLoop();
+    void writeRecords(const TelemetryRecord *records, size_t count);
+
+    std::FILE *file;
+    std::unique_ptr<SpscRing<TelemetryRecord>> ring;
+    std::unique_ptr<Block> block;
+    std::thread writer;
+    std::atomic<bool> stop_requested;
+
+    // 仿真线程写入
+    std::atomic<uint64_t> records_pushed;
+    std::atomic<uint64_t> ring_overflows;
+
+    // 写线程写入
+    std::atomic<uint64_t> records_written;
+    std::atomic<uint64_t> bytes_written;
+    std::atomic<uint64_t> write_calls;
+    std::atomic<uint64_t> max_lag_records;
+    std::atomic<uint64_t> max_write_ns;
+};
+
+// 顺序读取二进制日志, 内存占用固定
+class BinaryLogReader
+{
+public:
+    BinaryLogReader();
+    ~BinaryLogReader();
+
+    bool open(const std::string &path);
+    void close();
+
+    // 读取最多 max_count 条记录, 返回实际条数, 0 表示结束
+    size_t read(TelemetryRecord *out, size_t max_count);
+
+private:
+    std::FILE *file;
+};
@@ -0,0 +1,61 @@
+#pragma once
+#include <cstdint>
+
+// 列式压缩遥测日志格式: 64 字节文件头 + 若干数据块, 小端存储
+// 每块最多 chunk_rows 行, 块内按列分段存放: 时间用二阶差分编码; 数值通道按块选择编码方式,
+// 块内都是 decimals 位小数时按整数差分编码, 否则用 Gorilla 式异或编码; 第二路转速 / 温度先与第一路相减或异或;
+// 传感器有效位和发动机状态按游程编码, 报警事件原样存放; 每段长度记在块头中, 读取时可只解码需要的列
+
+const char COLUMN_LOG_MAGIC[8] = {'E', 'N', 'G', 'L', 'O', 'G', 'C', '1'};
+const uint32_t COLUMN_LOG_VERSION = 1;
+const char COLUMN_CHUNK_MAGIC[4] = {'C', 'C', 'H', 'K'};
+
+// 数值通道数: rpm_1, rpm_2, egt1_temp, egt2_temp, fuel_v, fuel_c (与 CSV 列顺序一致)
+const int COLUMN_LOG_CHANNELS = 6;
+
+// 块内各段的顺序
+enum class ColumnStream : uint8_t
+{
+    TIME = 0,
+    CHANNEL_0 = 1, // 之后依次为 6 个数值通道
+    FLAGS = COLUMN_LOG_CHANNELS + 1, // 有效位与状态的游程
+    ALERTS,
+};
+
+const int COLUMN_STREAM_COUNT = (int)ColumnStream::ALERTS + 1;
+
+// 选择解码哪些列: 1 << ColumnStream 的组合
+const uint32_t COLUMN_SELECT_ALL = (1u << COLUMN_STREAM_COUNT) - 1;
+
+// 一列在块内的编码方式
+enum class ColumnMode : uint8_t
+{
+    RAW_BITS = 0,       // 数值通道: double 原始位的 Gorilla 式异或编码; 时间: 原始位当作整数做二阶差分
+    DECIMAL_DELTA = 1,  // 块内都是 decimals 位小数: 整数 (值 * 10^decimals) 的一阶差分
+    DECIMAL_DELTA2 = 2, // 同上, 二阶差分 (时间列总是二阶差分)
+};
+
+struct ColumnLogHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t chunk_rows; // 每块最多行数
+    int32_t decimals;    // 写入时数值取整到的小数位数, < 0 表示按原始位存储
+    uint8_t reserved[44];
+};
+
+struct ColumnChunkHeader
+{
+    char magic[4];
+    uint32_t row_count;
+    uint32_t alert_count;
+    uint32_t payload_size; // 块头之后各段的总字节数
+    double first_time;
+    double last_time;
+    uint32_t stream_size[COLUMN_STREAM_COUNT];
+    uint8_t column_mode[8]; // ColumnMode: 时间与 6 个数值通道
+    uint32_t reserved;
+};
+
+static_assert(sizeof(ColumnLogHeader) == 64, "ColumnLogHeader must be 64 bytes");
+static_assert(sizeof(ColumnChunkHeader) == 80, "ColumnChunkHeader must be 80 bytes");
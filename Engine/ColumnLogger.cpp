@@ -0,0 +1,950 @@
+#include "ColumnLogger.h"
+#include "BinaryLog.h"
+#include "CsvWriter.h"
+#include "LogIndex.h"
+#include "LogReplay.h"
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+// 行数上限, 防止损坏的块头导致过大的分配
+static const uint32_t MAX_CHUNK_ROWS = 1u << 20;
+
+static inline int leadingZeros(uint64_t v)
+{
+#if defined(__GNUC__)
+    return __builtin_clzll(v);
+#else
+    unsigned long index;
+    _BitScanReverse64(&index, v);
+    return 63 - (int)index;
+#endif
+}
+
+static inline int trailingZeros(uint64_t v)
+{
+#if defined(__GNUC__)
+    return __builtin_ctzll(v);
+#else
+    unsigned long index;
+    _BitScanForward64(&index, v);
+    return (int)index;
+#endif
+}
+
+static inline uint64_t zigzag(int64_t v)
+{
+    return ((uint64_t)v << 1) ^ (uint64_t)(v >> 63);
+}
+
+static inline int64_t unzigzag(uint64_t v)
+{
+    return (int64_t)(v >> 1) ^ -(int64_t)(v & 1);
+}
+
+static inline uint64_t doubleBits(double v)
+{
+    uint64_t bits;
+    std::memcpy(&bits, &v, sizeof(bits));
+    return bits;
+}
+
+static inline double bitsDouble(uint64_t bits)
+{
+    double v;
+    std::memcpy(&v, &bits, sizeof(v));
+    return v;
+}
+
+// ---- 位流: 高位在前 ----
+
+class BitWriter
+{
+public:
+    explicit BitWriter(std::vector<uint8_t> &out) : out(out), acc(0), used(0) {}
+
+    // bits <= 32
+    void write(uint64_t value, int bits)
+    {
+        acc = (acc << bits) | (value & ((1ull << bits) - 1));
+        used += bits;
+        while (used >= 8)
+        {
+            used -= 8;
+            out.push_back((uint8_t)(acc >> used));
+        }
+    }
+
+    void write64(uint64_t value, int bits)
+    {
+        if (bits > 32)
+        {
+            write(value >> 32, bits - 32);
+            write(value, 32);
+        }
+        else
+        {
+            write(value, bits);
+        }
+    }
+
+    // 末尾不足一字节的部分补零
+    void finish()
+    {
+        if (used > 0)
+            out.push_back((uint8_t)(acc << (8 - used)));
+        used = 0;
+    }
+
+private:
+    std::vector<uint8_t> &out;
+    uint64_t acc;
+    int used;
+};
+
+class BitReader
+{
+public:
+    BitReader(const uint8_t *begin, const uint8_t *end) : p(begin), end(end), acc(0), avail(0) {}
+
+    // bits <= 32; 越过段尾时读出 0
+    uint64_t read(int bits)
+    {
+        while (avail < bits)
+        {
+            acc = (acc << 8) | (p < end ? *p++ : 0);
+            avail += 8;
+        }
+        avail -= bits;
+        return (acc >> avail) & ((1ull << bits) - 1);
+    }
+
+    uint64_t read64(int bits)
+    {
+        if (bits > 32)
+        {
+            uint64_t high = read(bits - 32);
+            return (high << 32) | read(32);
+        }
+        return read(bits);
+    }
+
+private:
+    const uint8_t *p;
+    const uint8_t *end;
+    uint64_t acc;
+    int avail;
+};
+
+static void putVarint(std::vector<uint8_t> &out, uint64_t v)
+{
+    while (v >= 0x80)
+    {
+        out.push_back((uint8_t)(v | 0x80));
+        v >>= 7;
+    }
+    out.push_back((uint8_t)v);
+}
+
+static bool getVarint(const uint8_t *&p, const uint8_t *end, uint64_t &v)
+{
+    v = 0;
+    for (int shift = 0; shift < 64 && p < end; shift += 7)
+    {
+        uint8_t b = *p++;
+        v |= (uint64_t)(b & 0x7F) << shift;
+        if (!(b & 0x80))
+            return true;
+    }
+    return false;
+}
+
+// ---- 整数: 一阶 / 二阶差分 ----
+// 残差按 zigzag 变为无符号数: 0 写 '0'; 否则位数不超过当前窗口且浪费不多时写 '10' + 窗口宽度的位,
+// 否则写 '11' + 位数 - 1 (6 位) + 各位, 并以该位数作为新窗口. 首值原样写 64 位
+
+static inline int bitLength(uint64_t z)
+{
+    return z ? 64 - leadingZeros(z) : 0;
+}
+
+// 无符号回绕运算, 对任意 64 位整数都可逆
+static inline uint64_t residual(const uint64_t *x, uint32_t i, int order)
+{
+    uint64_t delta = x[i] - x[i - 1];
+    if (order == 1 || i == 1)
+        return delta;
+    return delta - (x[i - 1] - x[i - 2]);
+}
+
+// 按残差位数之和估计一阶、二阶差分哪种更短
+static int chooseOrder(const uint64_t *x, uint32_t count)
+{
+    uint64_t cost_1 = 0, cost_2 = 0;
+    for (uint32_t i = 1; i < count; i++)
+    {
+        cost_1 += bitLength(zigzag((int64_t)residual(x, i, 1)));
+        cost_2 += bitLength(zigzag((int64_t)residual(x, i, 2)));
+    }
+    return cost_2 < cost_1 ? 2 : 1;
+}
+
+static void encodeInts(const uint64_t *x, uint32_t count, int order, std::vector<uint8_t> &out)
+{
+    BitWriter bits(out);
+    int window = 0;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (i == 0)
+        {
+            bits.write64(x[0], 64);
+            continue;
+        }
+        uint64_t z = zigzag((int64_t)residual(x, i, order));
+        if (z == 0)
+        {
+            bits.write(0, 1);
+            continue;
+        }
+        int length = bitLength(z);
+        if (length <= window && window - length <= 6)
+        {
+            bits.write(0x2, 2);
+            bits.write64(z, window);
+            continue;
+        }
+        bits.write(0x3, 2);
+        bits.write((uint64_t)(length - 1), 6);
+        bits.write64(z, length);
+        window = length;
+    }
+    bits.finish();
+}
+
+static void decodeInts(const uint8_t *begin, const uint8_t *end, uint32_t count, int order, uint64_t *x)
+{
+    BitReader bits(begin, end);
+    int window = 0;
+    uint64_t prev_delta = 0;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (i == 0)
+        {
+            x[0] = bits.read64(64);
+            continue;
+        }
+        uint64_t z = 0;
+        if (bits.read(1) != 0)
+        {
+            if (bits.read(1) != 0)
+                window = (int)bits.read(6) + 1;
+            z = bits.read64(window);
+        }
+        uint64_t r = (uint64_t)unzigzag(z);
+        uint64_t delta = (order == 1 || i == 1) ? r : prev_delta + r;
+        x[i] = x[i - 1] + delta;
+        prev_delta = delta;
+    }
+}
+
+// ---- 数值: Gorilla 式异或 ----
+// 与上一值异或: 相同写 '0'; 否则有效位落在上一个窗口内时写 '10' + 窗口内的位,
+// 不在窗口内时写 '11' + 前导零个数 (5 位) + 有效位长度 - 1 (6 位) + 有效位
+
+static void encodeXor(const uint64_t *words, uint32_t count, std::vector<uint8_t> &out)
+{
+    BitWriter bits(out);
+    uint64_t prev = 0;
+    int window_lead = -1;
+    int window_trail = 0;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        uint64_t w = words[i];
+        if (i == 0)
+        {
+            bits.write64(w, 64);
+            prev = w;
+            continue;
+        }
+        uint64_t x = w ^ prev;
+        prev = w;
+        if (x == 0)
+        {
+            bits.write(0, 1);
+            continue;
+        }
+        int lead = leadingZeros(x);
+        int trail = trailingZeros(x);
+        if (lead > 31)
+            lead = 31;
+        if (window_lead >= 0 && lead >= window_lead && trail >= window_trail)
+        {
+            bits.write(0x2, 2);
+            bits.write64(x >> window_trail, 64 - window_lead - window_trail);
+            continue;
+        }
+        int length = 64 - lead - trail;
+        bits.write(0x3, 2);
+        bits.write((uint64_t)lead, 5);
+        bits.write((uint64_t)(length - 1), 6);
+        bits.write64(x >> trail, length);
+        window_lead = lead;
+        window_trail = trail;
+    }
+    bits.finish();
+}
+
+static void decodeXor(const uint8_t *begin, const uint8_t *end, uint32_t count, uint64_t *words)
+{
+    BitReader bits(begin, end);
+    uint64_t prev = 0;
+    int window_lead = 0;
+    int window_trail = 0;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (i == 0)
+        {
+            prev = bits.read64(64);
+            words[0] = prev;
+            continue;
+        }
+        if (bits.read(1) != 0)
+        {
+            if (bits.read(1) != 0)
+            {
+                window_lead = (int)bits.read(5);
+                int length = (int)bits.read(6) + 1;
+                window_trail = 64 - window_lead - length;
+                if (window_trail < 0)
+                    window_trail = 0; // 数据损坏
+            }
+            prev ^= bits.read64(64 - window_lead - window_trail) << window_trail;
+        }
+        words[i] = prev;
+    }
+}
+
+// ---- 取整与列编码方式 ----
+
+// 按 CSV 的定点输出规则 (对精确值四舍六入五成双) 取整到 1 / scale, 保留零的符号
+static double roundDecimal(double value, double scale)
+{
+    double a = std::fabs(value);
+    double r = a * scale;
+    if (!(r < 4e15))
+        return value; // 超出整数精确表示范围, 或 NaN / 无穷
+    double n = std::floor(r);
+    double f = r - n;
+    bool up = f > 0.5;
+    if (f == 0.5)
+    {
+        // 乘积恰好舍入到 .5 时用 fma 求出舍入误差, 判断精确值在哪一侧
+        double err = std::fma(a, scale, -r);
+        up = err > 0.0 || (err == 0.0 && std::fmod(n, 2.0) != 0.0);
+    }
+    if (up)
+        n += 1.0;
+    return std::copysign(n / scale, value);
+}
+
+// value 是否恰为 decimals 位小数 (值 * scale 的整数除以 scale 后与原值逐位相同)
+static bool toDecimal(double value, double scale, int64_t &n)
+{
+    double r = value * scale;
+    if (!(std::fabs(r) < 4e15))
+        return false;
+    n = std::llround(r);
+    return doubleBits((double)n / scale) == doubleBits(value);
+}
+
+// 整列都能按整数编码时写入 out 并返回 true
+static bool columnToDecimal(const double *values, uint32_t count, int decimals, double scale, uint64_t *out)
+{
+    if (decimals < 0)
+        return false;
+    int64_t n;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (!toDecimal(values[i], scale, n))
+            return false;
+        out[i] = (uint64_t)n;
+    }
+    return true;
+}
+
+// 第二路转速 / 温度先与第一路同一行的值异或, 两路相同时整列为 0
+static bool isPairedChannel(int channel)
+{
+    return channel == 1 || channel == 3;
+}
+
+static double scaleFor(int decimals)
+{
+    return decimals >= 0 ? std::pow(10.0, decimals) : 1.0;
+}
+
+// ---- ColumnLogger ----
+
+ColumnLogger::ColumnLogger()
+    : file(nullptr), decimals(3), scale(1000.0), chunk_rows(4096), rows(0), index(nullptr)
+{
+    std::memset(&stats, 0, sizeof(stats));
+}
+
+ColumnLogger::~ColumnLogger()
+{
+    close();
+}
+
+bool ColumnLogger::open(const std::string &path, int decimal_places, uint32_t rows_per_chunk)
+{
+    close();
+
+    file = std::fopen(path.c_str(), "wb");
+    if (!file)
+        return false;
+
+    decimals = decimal_places > 9 ? 9 : decimal_places;
+    scale = scaleFor(decimals);
+    chunk_rows = (rows_per_chunk == 0 || rows_per_chunk > MAX_CHUNK_ROWS) ? 4096 : rows_per_chunk;
+
+    ColumnLogHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, COLUMN_LOG_MAGIC, sizeof(header.magic));
+    header.version = COLUMN_LOG_VERSION;
+    header.chunk_rows = chunk_rows;
+    header.decimals = decimals;
+    std::fwrite(&header, sizeof(header), 1, file);
+
+    rows = 0;
+    time_column.resize(chunk_rows);
+    for (std::vector<double> &column : value_columns)
+        column.resize(chunk_rows);
+    validity_column.resize(chunk_rows);
+    state_column.resize(chunk_rows);
+    alerts.clear();
+    std::memset(&stats, 0, sizeof(stats));
+    stats.bytes_written = sizeof(header);
+    return true;
+}
+
+void ColumnLogger::close()
+{
+    if (!file)
+        return;
+    flush();
+    std::fclose(file);
+    file = nullptr;
+}
+
+bool ColumnLogger::isOpen() const
+{
+    return file != nullptr;
+}
+
+double ColumnLogger::quantize(double value) const
+{
+    return decimals >= 0 ? roundDecimal(value, scale) : value;
+}
+
+void ColumnLogger::append(double time, const EngineSnapshot &data, uint8_t state)
+{
+    if (!file)
+        return;
+    double values[COLUMN_LOG_CHANNELS] = {data.rpm_1,     data.rpm_2,  data.egt1_temp,
+                                          data.egt2_temp, data.fuel_v, data.fuel_c};
+    for (double &v : values)
+        v = quantize(v);
+    appendRow(quantize(time), values, packSensorValidity(data), state);
+}
+
+void ColumnLogger::appendRow(double time, const double *values, uint16_t validity, uint8_t state)
+{
+    // 块满后到下一行才写出, 紧跟最后一行的报警仍留在该块
+    if (rows == chunk_rows)
+        encodeChunk();
+
+    time_column[rows] = time;
+    for (int c = 0; c < COLUMN_LOG_CHANNELS; c++)
+        value_columns[c][rows] = values[c];
+    validity_column[rows] = validity;
+    state_column[rows] = state;
+    rows++;
+    stats.rows++;
+}
+
+void ColumnLogger::appendAlert(double time, const char *msg, size_t len)
+{
+    if (!file)
+        return;
+    ColumnAlert alert;
+    alert.row = rows;
+    alert.time = time;
+    alert.text.assign(msg, len);
+    alerts.push_back(alert);
+    stats.alerts++;
+}
+
+void ColumnLogger::flush()
+{
+    if (file && (rows > 0 || !alerts.empty()))
+        encodeChunk();
+    if (file)
+        std::fflush(file);
+}
+
+void ColumnLogger::encodeChunk()
+{
+    auto begin = std::chrono::steady_clock::now();
+
+    ColumnChunkHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, COLUMN_CHUNK_MAGIC, sizeof(header.magic));
+    header.row_count = rows;
+    header.alert_count = (uint32_t)alerts.size();
+    if (rows > 0)
+    {
+        header.first_time = time_column[0];
+        header.last_time = time_column[rows - 1];
+    }
+    else
+    {
+        header.first_time = alerts.front().time;
+        header.last_time = alerts.back().time;
+    }
+
+    for (std::vector<uint8_t> &s : streams)
+        s.clear();
+
+    // 时间
+    std::vector<uint64_t> words(rows);
+    const double *time = time_column.data();
+    bool time_decimal = columnToDecimal(time, rows, decimals, scale, words.data());
+    if (!time_decimal)
+    {
+        for (uint32_t i = 0; i < rows; i++)
+            words[i] = doubleBits(time[i]);
+    }
+    header.column_mode[0] = (uint8_t)(time_decimal ? ColumnMode::DECIMAL_DELTA2 : ColumnMode::RAW_BITS);
+    encodeInts(words.data(), rows, 2, streams[(int)ColumnStream::TIME]);
+
+    // 数值通道; 第二路与第一路编码方式相同时先相减 (整数) 或异或 (原始位)
+    std::vector<uint64_t> pair_words;
+    bool pair_decimal = false;
+    for (int c = 0; c < COLUMN_LOG_CHANNELS; c++)
+    {
+        const double *column = value_columns[c].data();
+        std::vector<uint8_t> &out = streams[(int)ColumnStream::CHANNEL_0 + c];
+        bool decimal = columnToDecimal(column, rows, decimals, scale, words.data());
+        if (!decimal)
+        {
+            for (uint32_t i = 0; i < rows; i++)
+                words[i] = doubleBits(column[i]);
+        }
+        if (isPairedChannel(c + 1))
+        {
+            pair_words = words;
+            pair_decimal = decimal;
+        }
+        if (isPairedChannel(c) && decimal == pair_decimal)
+        {
+            for (uint32_t i = 0; i < rows; i++)
+                words[i] = decimal ? words[i] - pair_words[i] : words[i] ^ pair_words[i];
+        }
+
+        if (decimal)
+        {
+            int order = chooseOrder(words.data(), rows);
+            header.column_mode[1 + c] = (uint8_t)(order == 2 ? ColumnMode::DECIMAL_DELTA2 : ColumnMode::DECIMAL_DELTA);
+            encodeInts(words.data(), rows, order, out);
+        }
+        else
+        {
+            header.column_mode[1 + c] = (uint8_t)ColumnMode::RAW_BITS;
+            encodeXor(words.data(), rows, out);
+        }
+    }
+
+    // 有效位与状态的游程: 游程长度 (变长整数) + 有效位 (2 字节) + 状态 (1 字节)
+    std::vector<uint8_t> &flags = streams[(int)ColumnStream::FLAGS];
+    for (uint32_t i = 0; i < rows;)
+    {
+        uint32_t run = 1;
+        while (i + run < rows && validity_column[i + run] == validity_column[i] &&
+               state_column[i + run] == state_column[i])
+            run++;
+        putVarint(flags, run);
+        flags.push_back((uint8_t)(validity_column[i] & 0xFF));
+        flags.push_back((uint8_t)(validity_column[i] >> 8));
+        flags.push_back(state_column[i]);
+        i += run;
+    }
+
+    // 报警: 所在行 (变长整数) + 时间 (8 字节) + 文本长度 (变长整数) + 文本
+    std::vector<uint8_t> &alert_stream = streams[(int)ColumnStream::ALERTS];
+    for (const ColumnAlert &a : alerts)
+    {
+        putVarint(alert_stream, a.row);
+        uint64_t t = doubleBits(a.time);
+        for (int b = 0; b < 8; b++)
+            alert_stream.push_back((uint8_t)(t >> (8 * b)));
+        putVarint(alert_stream, a.text.size());
+        alert_stream.insert(alert_stream.end(), a.text.begin(), a.text.end());
+    }
+
+    for (int s = 0; s < COLUMN_STREAM_COUNT; s++)
+    {
+        header.stream_size[s] = (uint32_t)streams[s].size();
+        header.payload_size += header.stream_size[s];
+    }
+
+    std::fwrite(&header, sizeof(header), 1, file);
+    for (const std::vector<uint8_t> &s : streams)
+    {
+        if (!s.empty())
+            std::fwrite(s.data(), 1, s.size(), file);
+    }
+
+    if (index)
+    {
+        for (const ColumnAlert &a : alerts)
+            index->addAlert(stats.bytes_written, 0, a.time, a.row, a.text.data(), a.text.size());
+        index->addChunk(stats.bytes_written, sizeof(header) + header.payload_size, header.first_time,
+                        header.last_time, rows);
+    }
+
+    stats.chunks++;
+    stats.bytes_written += sizeof(header) + header.payload_size;
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+    if (ms > stats.max_encode_ms)
+        stats.max_encode_ms = ms;
+
+    rows = 0;
+    alerts.clear();
+}
+
+ColumnLoggerStats ColumnLogger::getStats() const
+{
+    return stats;
+}
+
+void ColumnLogger::setIndex(LogIndexWriter *log_index)
+{
+    index = log_index;
+}
+
+static const char *skipToComma(const char *p, const char *end)
+{
+    const char *comma = (const char *)std::memchr(p, ',', end - p);
+    return comma ? comma : end;
+}
+
+bool ColumnLogger::convertFromCsv(const std::string &csv_path, const std::string &column_path, std::string &error)
+{
+    std::FILE *in = std::fopen(csv_path.c_str(), "rb");
+    if (!in)
+    {
+        error = "cannot open " + csv_path;
+        return false;
+    }
+    ColumnLogger out;
+    if (!out.open(column_path))
+    {
+        std::fclose(in);
+        error = "cannot write " + column_path;
+        return false;
+    }
+
+    char line[4096];
+    uint64_t line_no = 0;
+    bool ok = true;
+    while (ok && std::fgets(line, sizeof(line), in))
+    {
+        line_no++;
+        const char *begin = line;
+        const char *end = line + std::strlen(line);
+        while (end > begin && (end[-1] == '\n' || end[-1] == '\r'))
+            end--;
+        if (end == begin || *begin == 'T')
+            continue; // 空行和表头
+
+        if (*begin == 'A')
+        {
+            // ALERT,<时间>,MESSAGE:,<文本>
+            const char *p = skipToComma(begin, end);
+            double t = 0.0;
+            std::from_chars_result res = std::from_chars(p + (p < end), end, t);
+            const char *text = res.ptr;
+            for (int field = 0; field < 2 && text < end; field++)
+                text = skipToComma(text + (field > 0), end);
+            if (res.ec != std::errc() || text >= end)
+            {
+                ok = false;
+                break;
+            }
+            text++;
+            out.appendAlert(t, text, end - text);
+            continue;
+        }
+
+        double values[7];
+        const char *p = begin;
+        for (int i = 0; i < 7 && ok; i++)
+        {
+            std::from_chars_result res = std::from_chars(p, end, values[i]);
+            ok = res.ec == std::errc() && (i == 6 ? res.ptr == end : (res.ptr < end && *res.ptr == ','));
+            p = res.ptr + 1;
+        }
+        if (!ok)
+            break;
+
+        EngineSnapshot data = {};
+        data.rpm_1 = values[1];
+        data.rpm_2 = values[2];
+        data.egt1_temp = values[3];
+        data.egt2_temp = values[4];
+        data.fuel_v = values[5];
+        data.fuel_c = values[6];
+        out.appendRow(values[0], values + 1, LogReplayReader::inferValidity(data), RECORD_STATE_UNKNOWN);
+    }
+    std::fclose(in);
+    out.close();
+
+    if (!ok)
+    {
+        error = csv_path + ":" + std::to_string(line_no) + ": bad line";
+        return false;
+    }
+    return true;
+}
+
+// ---- ColumnLogReader ----
+
+ColumnLogReader::ColumnLogReader() : file(nullptr)
+{
+    std::memset(&header, 0, sizeof(header));
+}
+
+ColumnLogReader::~ColumnLogReader()
+{
+    close();
+}
+
+bool ColumnLogReader::open(const std::string &path)
+{
+    close();
+
+    file = std::fopen(path.c_str(), "rb");
+    if (!file)
+        return false;
+
+    if (std::fread(&header, sizeof(header), 1, file) != 1 ||
+        std::memcmp(header.magic, COLUMN_LOG_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != COLUMN_LOG_VERSION)
+    {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void ColumnLogReader::close()
+{
+    if (file)
+    {
+        std::fclose(file);
+        file = nullptr;
+    }
+}
+
+bool ColumnLogReader::isOpen() const
+{
+    return file != nullptr;
+}
+
+const ColumnLogHeader &ColumnLogReader::getHeader() const
+{
+    return header;
+}
+
+bool ColumnLogReader::readChunk(ColumnChunk &chunk, uint32_t select)
+{
+    if (!file)
+        return false;
+
+    ColumnChunkHeader chunk_header;
+    if (std::fread(&chunk_header, sizeof(chunk_header), 1, file) != 1)
+        return false;
+    if (std::memcmp(chunk_header.magic, COLUMN_CHUNK_MAGIC, sizeof(chunk_header.magic)) != 0 ||
+        chunk_header.row_count > MAX_CHUNK_ROWS || chunk_header.payload_size > 64 * MAX_CHUNK_ROWS)
+        return false;
+
+    payload.resize(chunk_header.payload_size);
+    if (chunk_header.payload_size > 0 && std::fread(payload.data(), 1, payload.size(), file) != payload.size())
+        return false;
+    return decodeChunk(header, chunk_header, payload.data(), chunk, select);
+}
+
+bool ColumnLogReader::decodeChunk(const ColumnLogHeader &file_header, const ColumnChunkHeader &h,
+                                  const uint8_t *payload, ColumnChunk &chunk, uint32_t select)
+{
+    uint64_t total = 0;
+    const uint8_t *stream_begin[COLUMN_STREAM_COUNT];
+    for (int s = 0; s < COLUMN_STREAM_COUNT; s++)
+    {
+        stream_begin[s] = payload + total;
+        total += h.stream_size[s];
+    }
+    if (total != h.payload_size || h.row_count > MAX_CHUNK_ROWS)
+        return false;
+
+    const uint32_t rows = h.row_count;
+    const double scale = scaleFor(file_header.decimals);
+    chunk.rows = rows;
+
+    // 第二路通道依赖第一路的值
+    for (int c = 0; c < COLUMN_LOG_CHANNELS; c++)
+    {
+        if (isPairedChannel(c) && (select & (1u << ((int)ColumnStream::CHANNEL_0 + c))))
+            select |= 1u << ((int)ColumnStream::CHANNEL_0 + c - 1);
+    }
+
+    std::vector<uint64_t> words(rows);
+    chunk.time.clear();
+    if (select & (1u << (int)ColumnStream::TIME))
+    {
+        const uint8_t *s = stream_begin[(int)ColumnStream::TIME];
+        decodeInts(s, s + h.stream_size[(int)ColumnStream::TIME], rows, 2, words.data());
+        bool decimal = h.column_mode[0] != (uint8_t)ColumnMode::RAW_BITS;
+        chunk.time.resize(rows);
+        for (uint32_t i = 0; i < rows; i++)
+            chunk.time[i] = decimal ? (double)(int64_t)words[i] / scale : bitsDouble(words[i]);
+    }
+
+    std::vector<uint64_t> pair_words;
+    for (int c = 0; c < COLUMN_LOG_CHANNELS; c++)
+    {
+        int stream = (int)ColumnStream::CHANNEL_0 + c;
+        std::vector<double> &column = chunk.values[c];
+        column.clear();
+        if (!(select & (1u << stream)))
+            continue;
+
+        const uint8_t *s = stream_begin[stream];
+        const uint8_t *s_end = s + h.stream_size[stream];
+        ColumnMode mode = (ColumnMode)h.column_mode[1 + c];
+        bool decimal = mode != ColumnMode::RAW_BITS;
+        if (decimal)
+            decodeInts(s, s_end, rows, mode == ColumnMode::DECIMAL_DELTA2 ? 2 : 1, words.data());
+        else
+            decodeXor(s, s_end, rows, words.data());
+
+        bool pair_decimal = isPairedChannel(c) && h.column_mode[c] != (uint8_t)ColumnMode::RAW_BITS;
+        if (isPairedChannel(c) && decimal == pair_decimal)
+        {
+            for (uint32_t i = 0; i < rows; i++)
+                words[i] = decimal ? words[i] + pair_words[i] : words[i] ^ pair_words[i];
+        }
+        if (isPairedChannel(c + 1))
+            pair_words = words;
+
+        column.resize(rows);
+        for (uint32_t i = 0; i < rows; i++)
+            column[i] = decimal ? (double)(int64_t)words[i] / scale : bitsDouble(words[i]);
+    }
+
+    chunk.validity.clear();
+    chunk.state.clear();
+    if (select & (1u << (int)ColumnStream::FLAGS))
+    {
+        const uint8_t *p = stream_begin[(int)ColumnStream::FLAGS];
+        const uint8_t *end = p + h.stream_size[(int)ColumnStream::FLAGS];
+        chunk.validity.resize(rows);
+        chunk.state.resize(rows);
+        uint32_t row = 0;
+        while (row < rows)
+        {
+            uint64_t run;
+            if (!getVarint(p, end, run) || end - p < 3 || run == 0 || run > rows - row)
+                return false;
+            uint16_t validity = (uint16_t)(p[0] | (p[1] << 8));
+            uint8_t state = p[2];
+            p += 3;
+            for (uint64_t k = 0; k < run; k++, row++)
+            {
+                chunk.validity[row] = validity;
+                chunk.state[row] = state;
+            }
+        }
+    }
+
+    chunk.alerts.clear();
+    if (select & (1u << (int)ColumnStream::ALERTS))
+    {
+        const uint8_t *p = stream_begin[(int)ColumnStream::ALERTS];
+        const uint8_t *end = p + h.stream_size[(int)ColumnStream::ALERTS];
+        for (uint32_t k = 0; k < h.alert_count; k++)
+        {
+            uint64_t row, len;
+            if (!getVarint(p, end, row) || end - p < 8)
+                return false;
+            uint64_t t = 0;
+            for (int b = 0; b < 8; b++)
+                t |= (uint64_t)p[b] << (8 * b);
+            p += 8;
+            if (!getVarint(p, end, len) || (uint64_t)(end - p) < len)
+                return false;
+            ColumnAlert alert;
+            alert.row = (uint32_t)row;
+            alert.time = bitsDouble(t);
+            alert.text.assign((const char *)p, (size_t)len);
+            p += len;
+            chunk.alerts.push_back(alert);
+        }
+    }
+    return true;
+}
+
+bool ColumnLogReader::convertToCsv(const std::string &column_path, const std::string &csv_path)
+{
+    ColumnLogReader reader;
+    if (!reader.open(column_path))
+        return false;
+
+    CsvWriter csv;
+    if (!csv.open(csv_path))
+        return false;
+    csv.writeHeader();
+
+    ColumnChunk chunk;
+    EngineSnapshot data = {};
+    while (reader.readChunk(chunk))
+    {
+        size_t next_alert = 0;
+        for (uint32_t i = 0; i <= chunk.rows; i++)
+        {
+            // 报警行位于第 row 行数值数据之后
+            while (next_alert < chunk.alerts.size() && chunk.alerts[next_alert].row <= i)
+            {
+                const ColumnAlert &a = chunk.alerts[next_alert++];
+                csv.writeAlert(a.time, a.text.data(), a.text.size());
+            }
+            if (i == chunk.rows)
+                break;
+            data.rpm_1 = chunk.values[0][i];
+            data.rpm_2 = chunk.values[1][i];
+            data.egt1_temp = chunk.values[2][i];
+            data.egt2_temp = chunk.values[3][i];
+            data.fuel_v = chunk.values[4][i];
+            data.fuel_c = chunk.values[5][i];
+            csv.writeSample(chunk.time[i], data);
+        }
+    }
+    csv.close();
+    return true;
+}
@@ -0,0 +1,119 @@
+#pragma once
+#include "ColumnLog.h"
+#include "DataStructrue.h"
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+class LogIndexWriter;
+
+// 块内的一条报警事件, 位于第 row 行数值数据之后
+struct ColumnAlert
+{
+    uint32_t row;
+    double time;
+    std::string text;
+};
+
+// 解码后的一块数据, 按列存放; 未选择解码的列为空
+struct ColumnChunk
+{
+    uint32_t rows;
+    std::vector<double> time;
+    std::vector<double> values[COLUMN_LOG_CHANNELS];
+    std::vector<uint16_t> validity; // packSensorValidity 格式
+    std::vector<uint8_t> state;     // EngineState 或 RECORD_STATE_UNKNOWN
+    std::vector<ColumnAlert> alerts;
+};
+
+struct ColumnLoggerStats
+{
+    uint64_t rows;
+    uint64_t alerts;
+    uint64_t chunks;
+    uint64_t bytes_written;
+    double max_encode_ms; // 单块编码写盘的最长耗时
+};
+
+// 列式压缩日志写入: 逐行追加到块缓冲区, 攒满 chunk_rows 行后在调用线程上编码并整块写盘
+// 每行只是写入各列数组, 编码开销集中在每块一次 (4096 行约 20 秒仿真时间)
+class ColumnLogger
+{
+public:
+    ColumnLogger();
+    ~ColumnLogger();
+
+    // decimals >= 0 时数值和时间先取整到该小数位数 (默认 3, 与 CSV 相同, 转换为 CSV 的结果与直接写 CSV 逐字节一致),
+    // < 0 时按 double 原始位无损存储
+    bool open(const std::string &path, int decimals = 3, uint32_t chunk_rows = 4096);
+    void close();
+    bool isOpen() const;
+
+    void append(double time, const EngineSnapshot &data, uint8_t state);
+    void appendAlert(double time, const char *msg, size_t len);
+
+    // 写出未满的块
+    void flush();
+
+    ColumnLoggerStats getStats() const;
+
+    // 每写出一块时把块和块内报警记入 index (为空时不记录)
+    void setIndex(LogIndexWriter *index);
+
+    // 将 Logger 的 CSV 日志转换为列式日志; CSV 没有的有效位按故障标志值推断, 状态记为未知
+    static bool convertFromCsv(const std::string &csv_path, const std::string &column_path, std::string &error);
+
+private:
+    void appendRow(double time, const double *values, uint16_t validity, uint8_t state);
+    double quantize(double value) const;
+    void encodeChunk();
+
+    std::FILE *file;
+    int decimals;
+    double scale;
+    uint32_t chunk_rows;
+
+    // 当前块的各列
+    uint32_t rows;
+    std::vector<double> time_column;
+    std::vector<double> value_columns[COLUMN_LOG_CHANNELS];
+    std::vector<uint16_t> validity_column;
+    std::vector<uint8_t> state_column;
+    std::vector<ColumnAlert> alerts;
+
+    // 编码缓冲区, 各块复用
+    std::vector<uint8_t> streams[COLUMN_STREAM_COUNT];
+
+    ColumnLoggerStats stats;
+    LogIndexWriter *index;
+};
+
+// 顺序读取列式日志, 每次解码一块
+class ColumnLogReader
+{
+public:
+    ColumnLogReader();
+    ~ColumnLogReader();
+
+    bool open(const std::string &path);
+    void close();
+    bool isOpen() const;
+
+    const ColumnLogHeader &getHeader() const;
+
+    // 读取并解码下一块中 select (1 << ColumnStream 的组合) 选中的列, 文件结束或数据损坏返回 false
+    bool readChunk(ColumnChunk &chunk, uint32_t select = COLUMN_SELECT_ALL);
+
+    // 解码内存中的一块 (payload 为块头之后的 header.payload_size 字节)
+    static bool decodeChunk(const ColumnLogHeader &file_header, const ColumnChunkHeader &header,
+                            const uint8_t *payload, ColumnChunk &chunk, uint32_t select = COLUMN_SELECT_ALL);
+
+    // 将列式日志转换为 Logger 的 CSV 格式
+    static bool convertToCsv(const std::string &column_path, const std::string &csv_path);
+
+private:
+    std::FILE *file;
+    ColumnLogHeader header;
+    std::vector<uint8_t> payload;
+};
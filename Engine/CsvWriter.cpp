@@ -0,0 +1,152 @@
+#include "CsvWriter.h"
+#include <charconv>
+#include <cstring>
+
+static const char CSV_HEADER[] = "Time(s),N1(RPM),N2(RPM),EGT1(C),EGT2(C),Fuel_Flow,Fuel_Quantity";
+
+CsvWriter::CsvWriter(size_t buffer_size) : file(nullptr), used(0), written(0)
+{
+    if (buffer_size < 2 * MAX_ROW_BYTES)
+        buffer_size = 2 * MAX_ROW_BYTES;
+    buffer.resize(buffer_size);
+}
+
+CsvWriter::~CsvWriter()
+{
+    close();
+}
+
+bool CsvWriter::open(const std::string &path)
+{
+    close();
+    file = std::fopen(path.c_str(), "wb");
+    if (!file)
+        return false;
+    // 缓冲由本类负责
+    std::setvbuf(file, nullptr, _IONBF, 0);
+    written = 0;
+    return true;
+}
+
+void CsvWriter::close()
+{
+    if (file)
+    {
+        flush();
+        std::fclose(file);
+        file = nullptr;
+    }
+}
+
+bool CsvWriter::isOpen() const
+{
+    return file != nullptr;
+}
+
+uint64_t CsvWriter::tell() const
+{
+    return written + used;
+}
+
+void CsvWriter::flush()
+{
+    if (file && used > 0)
+        std::fwrite(buffer.data(), 1, used, file);
+    written += used;
+    used = 0;
+}
+
+void CsvWriter::reserveRow(size_t extra)
+{
+    if (used + MAX_ROW_BYTES + extra > buffer.size())
+        flush();
+}
+
+void CsvWriter::append(const char *text, size_t len)
+{
+    if (used + len > buffer.size())
+    {
+        flush();
+        if (len > buffer.size())
+        {
+            std::fwrite(text, 1, len, file);
+            written += len;
+            return;
+        }
+    }
+    std::memcpy(buffer.data() + used, text, len);
+    used += len;
+}
+
+void CsvWriter::append(char c)
+{
+    buffer[used++] = c;
+}
+
+// 文件按二进制方式打开 (tell() 才是真实偏移), 换行自行写出:
+// 与原先文本方式打开的 std::ofstream 一致, Windows 上为 "\r\n"
+void CsvWriter::appendNewline()
+{
+#ifdef _WIN32
+    append('\r');
+#endif
+    append('\n');
+}
+
+void CsvWriter::appendFixed(double value, int precision)
+{
+    char *first = buffer.data() + used;
+    char *last = buffer.data() + buffer.size();
+    std::to_chars_result res = std::to_chars(first, last, value, std::chars_format::fixed, precision);
+    if (res.ec == std::errc())
+    {
+        used = res.ptr - buffer.data();
+        return;
+    }
+    // 理论上不会发生 (reserveRow 已预留足够空间), 退回 printf 格式化
+    int n = std::snprintf(first, last - first, "%.*f", precision, value);
+    if (n > 0)
+        used += (size_t)n < (size_t)(last - first) ? (size_t)n : (size_t)(last - first) - 1;
+}
+
+void CsvWriter::writeHeader()
+{
+    if (!file)
+        return;
+    reserveRow(0);
+    append(CSV_HEADER, sizeof(CSV_HEADER) - 1);
+    appendNewline();
+}
+
+void CsvWriter::writeSample(double time, const EngineSnapshot &data)
+{
+    if (!file)
+        return;
+    reserveRow(0);
+    appendFixed(time, 3);
+    append(',');
+    appendFixed(data.rpm_1, 3);
+    append(',');
+    appendFixed(data.rpm_2, 3);
+    append(',');
+    appendFixed(data.egt1_temp, 3);
+    append(',');
+    appendFixed(data.egt2_temp, 3);
+    append(',');
+    appendFixed(data.fuel_v, 3);
+    append(',');
+    appendFixed(data.fuel_c, 3);
+    appendNewline();
+}
+
+void CsvWriter::writeAlert(double time, const char *msg, size_t len)
+{
+    if (!file)
+        return;
+    reserveRow(len);
+    append("ALERT,", 6);
+    appendFixed(time, 1);
+    append(",MESSAGE:,", 10);
+    append(msg, len);
+    appendNewline();
+}
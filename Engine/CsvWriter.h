@@ -0,0 +1,48 @@
+#pragma once
+#include "DataStructrue.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// 不经过 iostream 的 CSV 写入器: 用 std::to_chars 格式化到复用的缓冲区, 攒满后整块写盘
+// 输出与原先 std::fixed << std::setprecision(n) 的结果逐字节一致
+class CsvWriter
+{
+public:
+    explicit CsvWriter(size_t buffer_size = 256 * 1024);
+    ~CsvWriter();
+
+    bool open(const std::string &path);
+    void close();
+    bool isOpen() const;
+
+    // 已写入的字节数 (含缓冲区中尚未写盘的部分), 即下一行在文件中的偏移
+    uint64_t tell() const;
+
+    void writeHeader();
+
+    // 数值行: 时间与各通道保留三位小数
+    void writeSample(double time, const EngineSnapshot &data);
+
+    // 报警行: ALERT,<时间, 一位小数>,MESSAGE:,<文本>
+    void writeAlert(double time, const char *msg, size_t len);
+
+    void flush();
+
+private:
+    // 单行最长字节数的保守估计 (7 个最长的定点 double)
+    static const size_t MAX_ROW_BYTES = 4096;
+
+    void reserveRow(size_t extra);
+    void appendFixed(double value, int precision);
+    void append(const char *text, size_t len);
+    void append(char c);
+    void appendNewline();
+
+    std::FILE *file;
+    std::vector<char> buffer;
+    size_t used;
+    uint64_t written;
+};
@@ -1,56 +1,198 @@
 #pragma once
-#include <vector>
+#include <cstdint>
 #include <string>
+#include <type_traits>
+#include <vector>
 
 enum class EngineState {
-    OFF,        // ػ
-    STARTING,   // ׶Σ -> 
-    RUNNING,    // ̬
-    STOPPING,   // ͣ׶Σ½
-    SHUTDOWN    // ͣ
+    OFF,        // 关机
+    STARTING,   // 启动阶段（线性 -> 对数增长）
+    RUNNING,    // 稳态（随机波动）
+    STOPPING,   // 停车阶段（对数下降）
+    SHUTDOWN    // 故障停机
 };
 
 enum class AlertLevel {
-    NORMAL,     // ɫ
-    CAUTION,    // ɫ
-    WARNING,    // ɫ
-    INVALID     // Чֵ (--)
+    NORMAL,     // 白色
+    CAUTION,    // 琥珀色
+    WARNING,    // 红色
+    INVALID     // 无效值 (--)
 };
 
 enum class ErrorType {
     NONE = 0,
-    // ---  ---
-    SENSOR_N_ONE, //һתٴ
-    SENSOR_N_TWO, //ͬһתٴ
-    SENSOR_EGT_ONE, //һ¶ȴ
-    SENSOR_EGT_TWO, //ͬһ¶ȴ
-    SENSOR_ALL, //ȫתٴȫ¶ȴ
-    SENSOR_FUEL,//ȼ
-    // --- ޹ ---
-    OVERSPEED_N1_1, //һתٳֵ
-    OVERSPEED_N1_2, //һתٳֵ
-    OVERHEAT_EGT_1, //ʱһ¶ȳֵ
-    OVERHEAT_EGT_2, //ʱһ¶ȳֵ
-    OVERHEAT_EGT_3, //̬ʱһ¶ȳֵ
-    OVERHEAT_EGT_4, //̬ʱһ¶ȳֵ
+    // --- 传感器故障 ---
+    SENSOR_N_ONE, //有一个转速传感器发生故障
+    SENSOR_N_TWO, //同一个发动机的两个转速传感器均发生故障
+    SENSOR_EGT_ONE, //有一个温度传感器发生故障
+    SENSOR_EGT_TWO, //同一个发动机的两个温度传感器均发生故障
+    SENSOR_ALL, //两个发动机的全部转速传感器或全部温度传感器发生故障
+    SENSOR_FUEL,//燃油余量传感器发生故障
+    // --- 超限故障 ---
+    OVERSPEED_N1_1, //有一个发动机的转速超过警戒值
+    OVERSPEED_N1_2, //有一个发动机的转速超过警告值
+    OVERHEAT_EGT_1, //在启动时有一个发动机排气温度超过警戒值
+    OVERHEAT_EGT_2, //在启动时有一个发动机排气温度超过警告值
+    OVERHEAT_EGT_3, //在稳态时有一个发动机排气温度超过警戒值
+    OVERHEAT_EGT_4, //在稳态时有一个发动机排气温度超过警告值
     //FUEL
-    LOW_FUEL,//ȼС500
-    OVERSPEED_FUEL,//ȼٴ50
+    LOW_FUEL,//燃油余量小于500
+    OVERSPEED_FUEL,//燃油流速大于50
 };
 
+// ErrorType 的数量 (含 NONE), 用于按类型索引的定长数组和告警位掩码
+const int ERROR_TYPE_COUNT = (int)ErrorType::OVERSPEED_FUEL + 1;
+
+inline unsigned int errorBit(ErrorType error)
+{
+    return 1u << (int)error;
+}
+
+inline int countErrorBits(unsigned int mask)
+{
+    int n = 0;
+    for (; mask; mask &= mask - 1)
+        n++;
+    return n;
+}
+
+inline const char *getEngineStateName(EngineState state)
+{
+    switch (state)
+    {
+    case EngineState::OFF:
+        return "OFF";
+    case EngineState::STARTING:
+        return "STARTING";
+    case EngineState::RUNNING:
+        return "RUNNING";
+    case EngineState::STOPPING:
+        return "STOPPING";
+    case EngineState::SHUTDOWN:
+        return "SHUTDOWN";
+    }
+    return "?";
+}
+
+// 带告警字符串的完整数据, 只在需要文本告警的地方使用; 仿真和判断的热路径使用 EngineSnapshot
 struct EngineData {
     double rpm_1;
     double rpm_2;
-    double egt1_temp; // ޸Ϊ»
-    double egt2_temp; // ޸Ϊ»
-    double fuel_c;    // ޸Ϊ»
-    double fuel_v;    // ޸Ϊ»
+    double egt1_temp; // 修改为下划线
+    double egt2_temp; // 修改为下划线
+    double fuel_c;    // 修改为下划线
+    double fuel_v;    // 修改为下划线
 
-    // ״̬ (ģ)
-    bool is_n_sensor_valid[4];   // ޸Ϊ»
-    bool is_egt_sensor_valid[4]; // ޸Ϊ»
-    bool is_fuel_valid;          // ޸Ϊ»
+    // 传感器状态标记 (用于模拟故障)
+    bool is_n_sensor_valid[4];   // 修改为下划线
+    bool is_egt_sensor_valid[4]; // 修改为下划线
+    bool is_fuel_valid;          // 修改为下划线
 
-    // ǰľϢ
+    // 当前计算出的警告信息
     std::vector<std::string> active_alerts;
-};
\ No newline at end of file
+};
+
+// 打包的传感器有效位: bit0-3 转速传感器, bit4-7 温度传感器, bit8 燃油传感器
+const unsigned short SENSOR_VALID_N_SHIFT = 0;
+const unsigned short SENSOR_VALID_EGT_SHIFT = 4;
+const unsigned short SENSOR_VALID_FUEL = 1 << 8;
+const unsigned short SENSOR_VALID_ALL = 0x1FF;
+
+inline unsigned short packSensorValidity(const EngineData &data)
+{
+    unsigned short bits = 0;
+    for (int i = 0; i < 4; i++)
+    {
+        if (data.is_n_sensor_valid[i])
+            bits |= 1 << (SENSOR_VALID_N_SHIFT + i);
+        if (data.is_egt_sensor_valid[i])
+            bits |= 1 << (SENSOR_VALID_EGT_SHIFT + i);
+    }
+    if (data.is_fuel_valid)
+        bits |= SENSOR_VALID_FUEL;
+    return bits;
+}
+
+inline void unpackSensorValidity(unsigned short bits, EngineData &data)
+{
+    for (int i = 0; i < 4; i++)
+    {
+        data.is_n_sensor_valid[i] = (bits >> (SENSOR_VALID_N_SHIFT + i)) & 1;
+        data.is_egt_sensor_valid[i] = (bits >> (SENSOR_VALID_EGT_SHIFT + i)) & 1;
+    }
+    data.is_fuel_valid = (bits & SENSOR_VALID_FUEL) != 0;
+}
+// 定长、可平凡复制的发动机数据快照, 正好占一个缓存行, 可直接 memcpy 到环形缓冲、共享内存和批量数组
+struct alignas(64) EngineSnapshot
+{
+    double rpm_1;
+    double rpm_2;
+    double egt1_temp;
+    double egt2_temp;
+    double fuel_c;
+    double fuel_v;
+
+    // 传感器有效位 (用于模拟故障), 第 i 位对应第 i 个传感器
+    uint16_t n_sensor_valid : 4;
+    uint16_t egt_sensor_valid : 4;
+    uint16_t fuel_valid : 1;
+
+    bool isNSensorValid(int i) const
+    {
+        return (n_sensor_valid >> i) & 1;
+    }
+    bool isEgtSensorValid(int i) const
+    {
+        return (egt_sensor_valid >> i) & 1;
+    }
+    void setNSensorValid(int i, bool valid)
+    {
+        n_sensor_valid = valid ? (n_sensor_valid | (1u << i)) : (n_sensor_valid & ~(1u << i));
+    }
+    void setEgtSensorValid(int i, bool valid)
+    {
+        egt_sensor_valid = valid ? (egt_sensor_valid | (1u << i)) : (egt_sensor_valid & ~(1u << i));
+    }
+};
+
+static_assert(std::is_trivially_copyable<EngineSnapshot>::value, "EngineSnapshot must be memcpy-able");
+static_assert(sizeof(EngineSnapshot) == 64, "EngineSnapshot must fit one cache line");
+
+inline unsigned short packSensorValidity(const EngineSnapshot &data)
+{
+    return (unsigned short)((data.n_sensor_valid << SENSOR_VALID_N_SHIFT) |
+                            (data.egt_sensor_valid << SENSOR_VALID_EGT_SHIFT) | (data.fuel_valid ? SENSOR_VALID_FUEL : 0));
+}
+
+inline void unpackSensorValidity(unsigned short bits, EngineSnapshot &data)
+{
+    data.n_sensor_valid = (bits >> SENSOR_VALID_N_SHIFT) & 0xF;
+    data.egt_sensor_valid = (bits >> SENSOR_VALID_EGT_SHIFT) & 0xF;
+    data.fuel_valid = (bits & SENSOR_VALID_FUEL) != 0;
+}
+
+inline EngineSnapshot makeEngineSnapshot(const EngineData &data)
+{
+    EngineSnapshot snap = {};
+    snap.rpm_1 = data.rpm_1;
+    snap.rpm_2 = data.rpm_2;
+    snap.egt1_temp = data.egt1_temp;
+    snap.egt2_temp = data.egt2_temp;
+    snap.fuel_c = data.fuel_c;
+    snap.fuel_v = data.fuel_v;
+    unpackSensorValidity(packSensorValidity(data), snap);
+    return snap;
+}
+
+inline EngineData toEngineData(const EngineSnapshot &snap)
+{
+    EngineData data;
+    data.rpm_1 = snap.rpm_1;
+    data.rpm_2 = snap.rpm_2;
+    data.egt1_temp = snap.egt1_temp;
+    data.egt2_temp = snap.egt2_temp;
+    data.fuel_c = snap.fuel_c;
+    data.fuel_v = snap.fuel_v;
+    unpackSensorValidity(packSensorValidity(snap), data);
+    return data;
+}
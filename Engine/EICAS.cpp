@@ -1,134 +1,184 @@
 #include "EICAS.h"
-#include <algorithm>
+#include "EICASBatch.h"
+#include <cstring>
 
-EICAS::EICAS() {};
-EICAS::~EICAS() {};
+static const uint32_t CRITICAL_MASK = errorBit(ErrorType::SENSOR_ALL) | errorBit(ErrorType::OVERSPEED_N1_2) |
+                                      errorBit(ErrorType::OVERHEAT_EGT_2) | errorBit(ErrorType::OVERHEAT_EGT_4);
 
-std::vector<ErrorType> EICAS::judge(const EngineData &data, EngineState state, double current_time)
+EICAS::EICAS()
 {
-    std::vector<ErrorType> current_raw_errors;
-
-    // ͳƴ
-    int fail_n1 = 0;
-    int fail_n2 = 0;
-    int fail_egt1 = 0;
-    int fail_egt2 = 0;
-
-    for (int i = 0; i < 4; i++)
+    last_raw_mask = 0;
+    pending_raised = 0;
+    active_mask = 0;
+    active_count = 0;
+    rules = &EICASRuleProgram::builtin();
+    for (int i = 0; i < ERROR_TYPE_COUNT; i++)
     {
-        if (!data.is_n_sensor_valid[i])
-            (i < 2) ? fail_n1++ : fail_n2++;
-        if (!data.is_egt_sensor_valid[i])
-            (i < 2) ? fail_egt1++ : fail_egt2++;
+        expire_time[i] = 0.0;
+        active_order[i] = ErrorType::NONE;
     }
+};
+EICAS::~EICAS() {};
 
-    // жϺɫ
-    if ((fail_n1 == 2 && fail_n2 == 2) || (fail_egt1 == 2 && fail_egt2 == 2))
-        current_raw_errors.push_back(ErrorType::SENSOR_ALL);
-
-    if (!data.is_fuel_valid)
-        current_raw_errors.push_back(ErrorType::SENSOR_FUEL);
+bool EICAS::isCritical(ErrorType error)
+{
+    return (CRITICAL_MASK & errorBit(error)) != 0;
+}
 
-    const double limit_n_red = 48000.0;
-    if (data.rpm_1 > limit_n_red || data.rpm_2 > limit_n_red)
-        current_raw_errors.push_back(ErrorType::OVERSPEED_N1_2);
+bool EICAS::hasCritical(uint32_t mask)
+{
+    return (mask & CRITICAL_MASK) != 0;
+}
 
-    double limit_egt_red = (state == EngineState::STARTING) ? 1000.0 : 1100.0;
-    if (data.egt1_temp > limit_egt_red || data.egt2_temp > limit_egt_red)
+const char *EICAS::getErrorMessage(ErrorType error)
+{
+    switch (error)
     {
-        current_raw_errors.push_back((state == EngineState::STARTING) ? ErrorType::OVERHEAT_EGT_2
-                                                                      : ErrorType::OVERHEAT_EGT_4);
+    case ErrorType::SENSOR_N_ONE:
+        return "ADVISORY: N1 SENSOR FAULT";
+    case ErrorType::SENSOR_N_TWO:
+        return "CAUTION: ENG N1 SENSOR FAIL";
+    case ErrorType::SENSOR_EGT_ONE:
+        return "ADVISORY: EGT SENSOR FAULT";
+    case ErrorType::SENSOR_EGT_TWO:
+        return "CAUTION: ENG EGT SENSOR FAIL";
+    case ErrorType::SENSOR_FUEL:
+        return "WARNING: FUEL SENSOR FAIL";
+    case ErrorType::SENSOR_ALL:
+        return "WARNING: DUAL ENG FAIL";
+
+    case ErrorType::LOW_FUEL:
+        return "CAUTION: LOW FUEL QTY";
+    case ErrorType::OVERSPEED_FUEL:
+        return "CAUTION: HIGH FUEL FLOW";
+
+    case ErrorType::OVERSPEED_N1_1:
+        return "CAUTION: N1 OVERSPEED";
+    case ErrorType::OVERSPEED_N1_2:
+        return "WARNING: ENG OVERSPEED";
+
+    case ErrorType::OVERHEAT_EGT_1:
+        return "CAUTION: EGT OVERHEAT";
+    case ErrorType::OVERHEAT_EGT_2:
+        return "WARNING: EGT CRITICAL";
+    case ErrorType::OVERHEAT_EGT_3:
+        return "CAUTION: EGT OVERHEAT";
+    case ErrorType::OVERHEAT_EGT_4:
+        return "WARNING: EGT CRITICAL";
+
+    default:
+        return "";
     }
+}
 
-    // жɫ
-    if (fail_n1 == 2 || fail_n2 == 2)
-        current_raw_errors.push_back(ErrorType::SENSOR_N_TWO);
-    if (fail_egt1 == 2 || fail_egt2 == 2)
-        current_raw_errors.push_back(ErrorType::SENSOR_EGT_TWO);
-
-    if (data.fuel_c < 1000.0)
-        current_raw_errors.push_back(ErrorType::LOW_FUEL);
-    if (data.fuel_v > 50.0)
-        current_raw_errors.push_back(ErrorType::OVERSPEED_FUEL);
+static const char *const error_names[ERROR_TYPE_COUNT] = {
+    "NONE",           "SENSOR_N_ONE",   "SENSOR_N_TWO",   "SENSOR_EGT_ONE", "SENSOR_EGT_TWO",
+    "SENSOR_ALL",     "SENSOR_FUEL",    "OVERSPEED_N1_1", "OVERSPEED_N1_2", "OVERHEAT_EGT_1",
+    "OVERHEAT_EGT_2", "OVERHEAT_EGT_3", "OVERHEAT_EGT_4", "LOW_FUEL",       "OVERSPEED_FUEL",
+};
 
-    const double limit_n_amber = 42000.0;
-    bool has_red_overspeed = (data.rpm_1 > limit_n_red || data.rpm_2 > limit_n_red);
-    if (!has_red_overspeed)
-    {
-        if (data.rpm_1 > limit_n_amber || data.rpm_2 > limit_n_amber)
-            current_raw_errors.push_back(ErrorType::OVERSPEED_N1_1);
-    }
+const char *EICAS::getErrorName(ErrorType error)
+{
+    int index = (int)error;
+    return (index >= 0 && index < ERROR_TYPE_COUNT) ? error_names[index] : "";
+}
 
-    double limit_egt_amber = (state == EngineState::STARTING) ? 850.0 : 950.0;
-    bool has_red_egt = (data.egt1_temp > limit_egt_red || data.egt2_temp > limit_egt_red);
-    if (!has_red_egt)
+bool EICAS::parseErrorName(const char *name, ErrorType &error)
+{
+    for (int i = 0; i < ERROR_TYPE_COUNT; i++)
     {
-        if (data.egt1_temp > limit_egt_amber || data.egt2_temp > limit_egt_amber)
+        if (std::strcmp(error_names[i], name) == 0)
         {
-            current_raw_errors.push_back((state == EngineState::STARTING) ? ErrorType::OVERHEAT_EGT_1
-                                                                          : ErrorType::OVERHEAT_EGT_3);
+            error = (ErrorType)i;
+            return true;
         }
     }
+    return false;
+}
 
-    // жϰɫѯϢ
-    if ((fail_n1 + fail_n2) > 0 && fail_n1 != 2 && fail_n2 != 2)
-        current_raw_errors.push_back(ErrorType::SENSOR_N_ONE);
-    if ((fail_egt1 + fail_egt2) > 0 && fail_egt1 != 2 && fail_egt2 != 2)
-        current_raw_errors.push_back(ErrorType::SENSOR_EGT_ONE);
+uint32_t EICAS::applyRawMask(uint32_t raw_mask, double current_time)
+{
+    // 只有新出现的故障才刷新或追加显示, 追加顺序与原始故障的判断顺序一致
+    uint32_t newly_raised = (raw_mask & ~last_raw_mask) | pending_raised;
+    last_raw_mask = raw_mask;
+    pending_raised = 0;
 
-    // άʾ
-    for (const auto &err : current_raw_errors)
+    if (newly_raised)
     {
-        bool is_new = true;
-        for (const auto &last : last_raw_errors)
-        {
-            if (last == err)
-            {
-                is_new = false;
-                break;
-            }
-        }
-
-        if (is_new)
+        ErrorType raised[ERROR_TYPE_COUNT];
+        int raised_count = expandAlertMask(newly_raised, raised);
+        for (int i = 0; i < raised_count; i++)
         {
-            bool already_showing = false;
-            for (auto &msg : active_msgs)
-            {
-                if (msg.type == err)
-                {
-                    msg.expire_time = current_time + 5.0; // ˢ¹ʱ
-                    already_showing = true;
-                    break;
-                }
-            }
-            if (!already_showing)
+            ErrorType err = raised[i];
+            expire_time[(int)err] = current_time + 5.0;
+            if (!(active_mask & errorBit(err)))
             {
-                active_msgs.push_back({err, current_time + 5.0});
+                active_mask |= errorBit(err);
+                active_order[active_count++] = err;
             }
         }
     }
 
-    // ѹڵϢ
-    auto it = active_msgs.begin();
-    while (it != active_msgs.end())
+    // 清除已过期的消息, 保持剩余消息的先后顺序
+    int kept = 0;
+    for (int i = 0; i < active_count; i++)
     {
-        if (current_time > it->expire_time)
-        {
-            it = active_msgs.erase(it);
-        }
-        else
-        {
-            ++it;
-        }
+        ErrorType err = active_order[i];
+        bool expired = current_time > expire_time[(int)err];
+        active_order[kept] = err;
+        kept += !expired;
+        if (expired)
+            active_mask &= ~errorBit(err);
     }
+    active_count = kept;
 
-    last_raw_errors = current_raw_errors;
+    return active_mask;
+}
 
-    std::vector<ErrorType> output;
-    for (const auto &msg : active_msgs)
-    {
-        output.push_back(msg.type);
-    }
+uint32_t EICAS::judgeMask(const EngineSnapshot &data, EngineState state, double current_time)
+{
+    return applyRawMask(rules->evaluate(data, state), current_time);
+}
+
+void EICAS::sample(const EngineSnapshot &data, EngineState state)
+{
+    uint32_t raw_mask = rules->evaluate(data, state);
+    pending_raised |= raw_mask & ~last_raw_mask;
+    last_raw_mask = raw_mask;
+}
+
+void EICAS::setRules(const EICASRuleProgram *value)
+{
+    rules = value ? value : &EICASRuleProgram::builtin();
+}
+
+const EICASRuleProgram &EICAS::getRules() const
+{
+    return *rules;
+}
+
+int EICAS::judge(const EngineSnapshot &data, EngineState state, double current_time, ErrorType *out, int capacity)
+{
+    judgeMask(data, state, current_time);
+    return getActiveAlerts(out, capacity);
+}
 
-    return output;
-}
\ No newline at end of file
+std::vector<ErrorType> EICAS::judge(const EngineSnapshot &data, EngineState state, double current_time)
+{
+    ErrorType buffer[ERROR_TYPE_COUNT];
+    int count = judge(data, state, current_time, buffer, ERROR_TYPE_COUNT);
+    return std::vector<ErrorType>(buffer, buffer + count);
+}
+
+int EICAS::getActiveAlerts(ErrorType *out, int capacity) const
+{
+    int count = (active_count < capacity) ? active_count : capacity;
+    for (int i = 0; i < count; i++)
+        out[i] = active_order[i];
+    return count;
+}
+
+uint32_t EICAS::getActiveMask() const
+{
+    return active_mask;
+}
@@ -1,22 +1,61 @@
 #pragma once
 #include "DataStructrue.h"
+#include "EICASRules.h"
+#include <cstdint>
 #include <vector>
 
-struct AlertMsg
-{
-    ErrorType type;
-    double expire_time; // Ϣʧʱ
-};
-
 class EICAS
 {
 private:
-    std::vector<ErrorType> last_raw_errors;
-    std::vector<AlertMsg> active_msgs;
+    // 上一次判断或采样的原始故障 (errorBit 位掩码)
+    uint32_t last_raw_mask;
+    // 上一次判断之后各仿真步采样中新出现的故障, 下一次判断时一并显示
+    uint32_t pending_raised;
+
+    // 正在显示的消息: 位掩码 + 按类型索引的消失时间 + 按出现先后排列的显示顺序
+    uint32_t active_mask;
+    double expire_time[ERROR_TYPE_COUNT];
+    ErrorType active_order[ERROR_TYPE_COUNT];
+    int active_count;
+
+    // 告警门限, 不归本对象所有
+    const EICASRuleProgram *rules;
 
 public:
     EICAS();
     ~EICAS();
 
-    std::vector<ErrorType> judge(const EngineData &data, EngineState state, double current_time);
+    // 兼容接口, 每次调用分配返回的 vector
+    std::vector<ErrorType> judge(const EngineSnapshot &data, EngineState state, double current_time);
+
+    // 无堆分配接口: 将显示中的消息按显示顺序写入 out (最多 capacity 个), 返回写入个数
+    int judge(const EngineSnapshot &data, EngineState state, double current_time, ErrorType *out, int capacity);
+
+    // 无堆分配接口: 返回显示中的消息位掩码
+    uint32_t judgeMask(const EngineSnapshot &data, EngineState state, double current_time);
+
+    // 由已算好的原始故障位掩码 (judgeRawMask / judgeBatch 的结果) 更新显示消息, 返回显示中的位掩码
+    uint32_t applyRawMask(uint32_t raw_mask, double current_time);
+
+    // 两次判断之间的仿真步调用: 只求原始故障并记下新出现的故障, 不更新显示;
+    // 一步内出现又消失的越限在下一次判断时仍会显示
+    void sample(const EngineSnapshot &data, EngineState state);
+
+    // 替换告警门限 (为空时恢复内置门限); rules 须在本对象使用期间有效
+    void setRules(const EICASRuleProgram *rules);
+    const EICASRuleProgram &getRules() const;
+
+    int getActiveAlerts(ErrorType *out, int capacity) const;
+    uint32_t getActiveMask() const;
+
+    // 红色警告中需要触发自动停车的故障
+    static bool isCritical(ErrorType error);
+    static bool hasCritical(uint32_t mask);
+
+    // 告警文本 (与显示、日志共用)
+    static const char *getErrorMessage(ErrorType error);
+
+    // ErrorType 枚举名 (如 "OVERHEAT_EGT_4"), 用于命令行和时间线输出
+    static const char *getErrorName(ErrorType error);
+    static bool parseErrorName(const char *name, ErrorType &error);
 };
\ No newline at end of file
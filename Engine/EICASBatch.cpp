@@ -0,0 +1,212 @@
+#include "EICASBatch.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define EICAS_BATCH_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define EICAS_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define EICAS_TARGET_AVX2
+#endif
+
+static const uint8_t STATE_STARTING = (uint8_t)EngineState::STARTING;
+
+// 由各门限比较结果 (0/1) 组装告警位, 不含分支
+static inline uint32_t assembleMask(const SensorVoteTable &t, uint16_t validity, bool starting, uint32_t n_red,
+                                    uint32_t n_amber, uint32_t egt_red_start, uint32_t egt_amber_start,
+                                    uint32_t egt_red_run, uint32_t egt_amber_run, uint32_t low_fuel,
+                                    uint32_t high_flow)
+{
+    uint32_t mask = sensorVoteMask(t, validity);
+
+    uint32_t egt_red = starting ? egt_red_start : egt_red_run;
+    uint32_t egt_amber = (starting ? egt_amber_start : egt_amber_run) & ~egt_red & 1u;
+    int egt_red_bit = starting ? (int)ErrorType::OVERHEAT_EGT_2 : (int)ErrorType::OVERHEAT_EGT_4;
+    int egt_amber_bit = starting ? (int)ErrorType::OVERHEAT_EGT_1 : (int)ErrorType::OVERHEAT_EGT_3;
+
+    mask |= n_red << (int)ErrorType::OVERSPEED_N1_2;
+    mask |= (n_amber & ~n_red & 1u) << (int)ErrorType::OVERSPEED_N1_1;
+    mask |= egt_red << egt_red_bit;
+    mask |= egt_amber << egt_amber_bit;
+    mask |= low_fuel << (int)ErrorType::LOW_FUEL;
+    mask |= high_flow << (int)ErrorType::OVERSPEED_FUEL;
+    return mask;
+}
+
+static inline uint32_t judgeOne(const SensorVoteTable &t, const EngineLimits &l, double rpm_1, double rpm_2,
+                                double egt1_temp, double egt2_temp, double fuel_c, double fuel_v, uint16_t validity,
+                                uint8_t state)
+{
+    uint32_t n_red = (rpm_1 > l.n1_red) | (rpm_2 > l.n1_red);
+    uint32_t n_amber = (rpm_1 > l.n1_amber) | (rpm_2 > l.n1_amber);
+    uint32_t egt_red_start = (egt1_temp > l.egt_red_start) | (egt2_temp > l.egt_red_start);
+    uint32_t egt_amber_start = (egt1_temp > l.egt_amber_start) | (egt2_temp > l.egt_amber_start);
+    uint32_t egt_red_run = (egt1_temp > l.egt_red_run) | (egt2_temp > l.egt_red_run);
+    uint32_t egt_amber_run = (egt1_temp > l.egt_amber_run) | (egt2_temp > l.egt_amber_run);
+    uint32_t low_fuel = fuel_c < l.fuel_low;
+    uint32_t high_flow = fuel_v > l.fuel_flow_high;
+
+    return assembleMask(t, validity, state == STATE_STARTING, n_red, n_amber, egt_red_start, egt_amber_start,
+                        egt_red_run, egt_amber_run, low_fuel, high_flow);
+}
+
+uint32_t judgeRawMask(double rpm_1, double rpm_2, double egt1_temp, double egt2_temp, double fuel_c, double fuel_v,
+                      uint16_t validity, EngineState state)
+{
+    return judgeRawMaskStatic<DefaultEngineLimits>(rpm_1, rpm_2, egt1_temp, egt2_temp, fuel_c, fuel_v, validity,
+                                                   state);
+}
+
+uint32_t judgeRawMask(const EngineSnapshot &data, EngineState state)
+{
+    return judgeRawMaskStatic<DefaultEngineLimits>(data, state);
+}
+
+static void judgeRange(const SensorVoteTable &t, const EngineLimits &l, const EngineColumns &c, size_t begin,
+                       size_t end, uint32_t *out)
+{
+    for (size_t i = begin; i < end; i++)
+    {
+        out[i] = judgeOne(t, l, c.rpm_1[i], c.rpm_2[i], c.egt1_temp[i], c.egt2_temp[i], c.fuel_c[i], c.fuel_v[i],
+                          c.validity[i], c.state[i]);
+    }
+}
+
+void judgeBatchScalar(const EngineColumns &columns, uint32_t *out_masks, const EngineLimits &limits)
+{
+    judgeRange(sensorVoteTable(), limits, columns, 0, columns.count, out_masks);
+}
+
+void judgeBatchScalar(const EngineColumns &columns, uint32_t *out_masks)
+{
+    judgeBatchScalar(columns, out_masks, EICASRuleProgram::builtin().getLimits());
+}
+
+#ifdef EICAS_BATCH_X86
+
+// 两个通道中任一超过门限, 返回 4 个通道的比较结果位
+EICAS_TARGET_AVX2 static inline int anyAbove(__m256d a, __m256d b, __m256d limit)
+{
+    __m256d gt = _mm256_or_pd(_mm256_cmp_pd(a, limit, _CMP_GT_OQ), _mm256_cmp_pd(b, limit, _CMP_GT_OQ));
+    return _mm256_movemask_pd(gt);
+}
+
+EICAS_TARGET_AVX2 static void judgeBatchAvx2(const EngineColumns &c, uint32_t *out, const EngineLimits &l)
+{
+    const SensorVoteTable &t = sensorVoteTable();
+
+    const __m256d n_red = _mm256_set1_pd(l.n1_red);
+    const __m256d n_amber = _mm256_set1_pd(l.n1_amber);
+    const __m256d egt_red_start = _mm256_set1_pd(l.egt_red_start);
+    const __m256d egt_amber_start = _mm256_set1_pd(l.egt_amber_start);
+    const __m256d egt_red_run = _mm256_set1_pd(l.egt_red_run);
+    const __m256d egt_amber_run = _mm256_set1_pd(l.egt_amber_run);
+    const __m256d fuel_low = _mm256_set1_pd(l.fuel_low);
+    const __m256d fuel_flow = _mm256_set1_pd(l.fuel_flow_high);
+
+    size_t i = 0;
+    for (; i + 4 <= c.count; i += 4)
+    {
+        __m256d r1 = _mm256_loadu_pd(c.rpm_1 + i);
+        __m256d r2 = _mm256_loadu_pd(c.rpm_2 + i);
+        __m256d e1 = _mm256_loadu_pd(c.egt1_temp + i);
+        __m256d e2 = _mm256_loadu_pd(c.egt2_temp + i);
+        __m256d fc = _mm256_loadu_pd(c.fuel_c + i);
+        __m256d fv = _mm256_loadu_pd(c.fuel_v + i);
+
+        int m_n_red = anyAbove(r1, r2, n_red);
+        int m_n_amber = anyAbove(r1, r2, n_amber);
+        int m_egt_red_start = anyAbove(e1, e2, egt_red_start);
+        int m_egt_amber_start = anyAbove(e1, e2, egt_amber_start);
+        int m_egt_red_run = anyAbove(e1, e2, egt_red_run);
+        int m_egt_amber_run = anyAbove(e1, e2, egt_amber_run);
+        int m_low_fuel = _mm256_movemask_pd(_mm256_cmp_pd(fc, fuel_low, _CMP_LT_OQ));
+        int m_high_flow = _mm256_movemask_pd(_mm256_cmp_pd(fv, fuel_flow, _CMP_GT_OQ));
+
+        for (int k = 0; k < 4; k++)
+        {
+            out[i + k] = assembleMask(t, c.validity[i + k], c.state[i + k] == STATE_STARTING, (m_n_red >> k) & 1,
+                                      (m_n_amber >> k) & 1, (m_egt_red_start >> k) & 1,
+                                      (m_egt_amber_start >> k) & 1, (m_egt_red_run >> k) & 1,
+                                      (m_egt_amber_run >> k) & 1, (m_low_fuel >> k) & 1, (m_high_flow >> k) & 1);
+        }
+    }
+
+    judgeRange(t, l, c, i, c.count, out);
+}
+
+static bool detectAvx2()
+{
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#elif defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    bool os_xsave = (info[2] & (1 << 27)) != 0;
+    bool has_avx = (info[2] & (1 << 28)) != 0;
+    if (!os_xsave || !has_avx || (_xgetbv(0) & 0x6) != 0x6)
+        return false;
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    return false;
+#endif
+}
+
+bool judgeBatchUsesAvx2()
+{
+    static const bool has_avx2 = detectAvx2();
+    return has_avx2;
+}
+
+void judgeBatch(const EngineColumns &columns, uint32_t *out_masks, const EngineLimits &limits)
+{
+    if (judgeBatchUsesAvx2())
+        judgeBatchAvx2(columns, out_masks, limits);
+    else
+        judgeBatchScalar(columns, out_masks, limits);
+}
+
+#else
+
+bool judgeBatchUsesAvx2()
+{
+    return false;
+}
+
+void judgeBatch(const EngineColumns &columns, uint32_t *out_masks, const EngineLimits &limits)
+{
+    judgeBatchScalar(columns, out_masks, limits);
+}
+
+#endif
+
+void judgeBatch(const EngineColumns &columns, uint32_t *out_masks)
+{
+    judgeBatch(columns, out_masks, EICASRuleProgram::builtin().getLimits());
+}
+
+int expandAlertMask(uint32_t mask, ErrorType *out)
+{
+    // 与 EICAS::judge 的判断顺序一致
+    static const ErrorType order[] = {
+        ErrorType::SENSOR_ALL,     ErrorType::SENSOR_FUEL,    ErrorType::OVERSPEED_N1_2, ErrorType::OVERHEAT_EGT_2,
+        ErrorType::OVERHEAT_EGT_4, ErrorType::SENSOR_N_TWO,   ErrorType::SENSOR_EGT_TWO, ErrorType::LOW_FUEL,
+        ErrorType::OVERSPEED_FUEL, ErrorType::OVERSPEED_N1_1, ErrorType::OVERHEAT_EGT_1, ErrorType::OVERHEAT_EGT_3,
+        ErrorType::SENSOR_N_ONE,   ErrorType::SENSOR_EGT_ONE,
+    };
+
+    int n = 0;
+    for (ErrorType e : order)
+    {
+        if (mask & errorBit(e))
+            out[n++] = e;
+    }
+    return n;
+}
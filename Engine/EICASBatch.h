@@ -0,0 +1,40 @@
+#pragma once
+#include "DataStructrue.h"
+#include "EICASRules.h"
+#include <cstddef>
+#include <cstdint>
+
+// 按列存放的多组发动机快照 (多台发动机或同一发动机的多个采样)
+struct EngineColumns
+{
+    const double *rpm_1;
+    const double *rpm_2;
+    const double *egt1_temp;
+    const double *egt2_temp;
+    const double *fuel_c;
+    const double *fuel_v;
+    const uint16_t *validity; // packSensorValidity 格式
+    const uint8_t *state;     // EngineState
+    size_t count;
+};
+
+// 单个快照按内置门限 (DefaultEngineLimits) 的原始告警判断, 结果为 errorBit() 组成的位掩码
+uint32_t judgeRawMask(double rpm_1, double rpm_2, double egt1_temp, double egt2_temp, double fuel_c, double fuel_v,
+                      uint16_t validity, EngineState state);
+
+uint32_t judgeRawMask(const EngineSnapshot &data, EngineState state);
+
+// 批量判断, 每个快照输出一个告警位掩码; CPU 支持时使用 AVX2. 不给出门限时使用内置门限
+void judgeBatch(const EngineColumns &columns, uint32_t *out_masks, const EngineLimits &limits);
+void judgeBatch(const EngineColumns &columns, uint32_t *out_masks);
+
+// 标量版本, 用于不支持 AVX2 的平台和结果对照
+void judgeBatchScalar(const EngineColumns &columns, uint32_t *out_masks, const EngineLimits &limits);
+void judgeBatchScalar(const EngineColumns &columns, uint32_t *out_masks);
+
+// 当前进程中 judgeBatch 是否走 AVX2 路径
+bool judgeBatchUsesAvx2();
+
+// 按 EICAS::judge 的输出顺序 (红色警告 -> 琥珀色警戒 -> 白色提示) 展开位掩码
+// out 至少容纳 ERROR_TYPE_COUNT 个元素, 返回写入的个数
+int expandAlertMask(uint32_t mask, ErrorType *out);
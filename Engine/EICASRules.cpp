@@ -0,0 +1,311 @@
+#include "EICASRules.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+static constexpr uint32_t voteBit(ErrorType error)
+{
+    return 1u << (int)error;
+}
+
+static constexpr uint32_t sensorGroupMask(unsigned int nibble, ErrorType two, ErrorType one)
+{
+    int fail_1 = !(nibble & 1) + !(nibble & 2);
+    int fail_2 = !(nibble & 4) + !(nibble & 8);
+
+    uint32_t mask = 0;
+    if (fail_1 == 2 && fail_2 == 2)
+        mask |= voteBit(ErrorType::SENSOR_ALL);
+    if (fail_1 == 2 || fail_2 == 2)
+        mask |= voteBit(two);
+    if ((fail_1 + fail_2) > 0 && fail_1 != 2 && fail_2 != 2)
+        mask |= voteBit(one);
+    return mask;
+}
+
+static constexpr SensorVoteTable makeSensorVoteTable()
+{
+    SensorVoteTable t = {};
+    for (unsigned int v = 0; v < 16; v++)
+    {
+        t.n[v] = sensorGroupMask(v, ErrorType::SENSOR_N_TWO, ErrorType::SENSOR_N_ONE);
+        t.egt[v] = sensorGroupMask(v, ErrorType::SENSOR_EGT_TWO, ErrorType::SENSOR_EGT_ONE);
+    }
+    return t;
+}
+
+constexpr SensorVoteTable sensor_vote_table = makeSensorVoteTable();
+
+struct LimitKey
+{
+    const char *name;
+    double EngineLimits::*field;
+};
+
+static const LimitKey limit_keys[] = {
+    {"rpm_reference", &EngineLimits::rpm_reference},
+    {"n1_red", &EngineLimits::n1_red},
+    {"n1_amber", &EngineLimits::n1_amber},
+    {"egt_red_start", &EngineLimits::egt_red_start},
+    {"egt_amber_start", &EngineLimits::egt_amber_start},
+    {"egt_red_run", &EngineLimits::egt_red_run},
+    {"egt_amber_run", &EngineLimits::egt_amber_run},
+    {"fuel_low", &EngineLimits::fuel_low},
+    {"fuel_flow_high", &EngineLimits::fuel_flow_high},
+};
+
+static char *trim(char *s)
+{
+    while (*s == ' ' || *s == '\t')
+        s++;
+    char *end = s + std::strlen(s);
+    while (end > s && (end[-1] == ' ' || end[-1] == '\t' || end[-1] == '\r' || end[-1] == '\n'))
+        *--end = '\0';
+    return s;
+}
+
+bool loadEngineLimits(const std::string &path, const std::string &engine_type, EngineLimits &limits,
+                      std::string &error)
+{
+    std::FILE *file = std::fopen(path.c_str(), "r");
+    if (!file)
+    {
+        error = "cannot open " + path;
+        return false;
+    }
+
+    EngineLimits loaded = makeEngineLimits<DefaultEngineLimits>();
+    bool in_section = false;
+    bool found = false;
+    char line[256];
+    int line_no = 0;
+    char where[64];
+
+    while (std::fgets(line, sizeof(line), file))
+    {
+        line_no++;
+        std::snprintf(where, sizeof(where), "%s:%d: ", path.c_str(), line_no);
+        char *comment = std::strchr(line, '#');
+        if (comment)
+            *comment = '\0';
+        char *text = trim(line);
+        if (*text == '\0')
+            continue;
+
+        if (*text == '[')
+        {
+            char *close = std::strchr(text, ']');
+            if (!close)
+            {
+                error = std::string(where) + "missing ']'";
+                std::fclose(file);
+                return false;
+            }
+            *close = '\0';
+            in_section = (engine_type == trim(text + 1));
+            found = found || in_section;
+            continue;
+        }
+        if (!in_section)
+            continue;
+
+        char *eq = std::strchr(text, '=');
+        if (!eq)
+        {
+            error = std::string(where) + "expected 'key = value'";
+            std::fclose(file);
+            return false;
+        }
+        *eq = '\0';
+        char *key = trim(text);
+        char *value_text = trim(eq + 1);
+        char *value_end = nullptr;
+        double value = std::strtod(value_text, &value_end);
+        if (value_end == value_text || *trim(value_end) != '\0')
+        {
+            error = std::string(where) + "bad number '" + value_text + "'";
+            std::fclose(file);
+            return false;
+        }
+
+        bool known = false;
+        for (const LimitKey &k : limit_keys)
+        {
+            if (std::strcmp(k.name, key) == 0)
+            {
+                loaded.*(k.field) = value;
+                known = true;
+                break;
+            }
+        }
+        if (!known)
+        {
+            error = std::string(where) + "unknown key '" + key + "'";
+            std::fclose(file);
+            return false;
+        }
+    }
+    std::fclose(file);
+
+    if (!found)
+    {
+        error = "engine type [" + engine_type + "] not found in " + path;
+        return false;
+    }
+    if (loaded.n1_amber > loaded.n1_red || loaded.egt_amber_start > loaded.egt_red_start ||
+        loaded.egt_amber_run > loaded.egt_red_run || loaded.rpm_reference <= 0.0)
+    {
+        error = "engine type [" + engine_type + "]: amber limit above red limit or bad rpm_reference";
+        return false;
+    }
+
+    limits = loaded;
+    return true;
+}
+
+static bool sameLimits(const EngineLimits &a, const EngineLimits &b)
+{
+    for (const LimitKey &k : limit_keys)
+    {
+        if (a.*(k.field) != b.*(k.field))
+            return false;
+    }
+    return true;
+}
+
+static uint32_t stateBit(EngineState state)
+{
+    return 1u << (int)state;
+}
+
+EICASRuleProgram::EICASRuleProgram()
+{
+    compileStatic<DefaultEngineLimits>();
+}
+
+EICASRuleProgram::EICASRuleProgram(const EngineLimits &limits)
+{
+    compile(limits);
+}
+
+void EICASRuleProgram::compile(const EngineLimits &value)
+{
+    if (sameLimits(value, makeEngineLimits<DefaultEngineLimits>()))
+    {
+        compileStatic<DefaultEngineLimits>();
+        return;
+    }
+    build(value);
+    evaluator = &evaluateProgram;
+    specialized = false;
+}
+
+void EICASRuleProgram::addRule(SensorChannel a, SensorChannel b, bool above, double limit, uint32_t state_mask,
+                               ErrorType bit, AlertLevel level, uint32_t suppressed_by)
+{
+    EICASRule &r = rules[rule_count++];
+    r.sign = above ? 1.0 : -1.0;
+    r.limit = limit * r.sign;
+    r.state_mask = state_mask;
+    r.suppressed_by = suppressed_by;
+    r.channel_a = (uint8_t)a;
+    r.channel_b = (uint8_t)b;
+    r.bit = (uint8_t)bit;
+    r.level = (uint8_t)level;
+    r.reserved = 0;
+}
+
+void EICASRuleProgram::build(const EngineLimits &value)
+{
+    limits = value;
+    rule_count = 0;
+
+    const uint32_t all_states = stateBit(EngineState::OFF) | stateBit(EngineState::STARTING) |
+                                stateBit(EngineState::RUNNING) | stateBit(EngineState::STOPPING) |
+                                stateBit(EngineState::SHUTDOWN);
+    const uint32_t starting = stateBit(EngineState::STARTING);
+    const uint32_t not_starting = all_states & ~starting;
+
+    addRule(SensorChannel::RPM_1, SensorChannel::RPM_2, true, limits.n1_red, all_states, ErrorType::OVERSPEED_N1_2,
+            AlertLevel::WARNING, 0);
+    addRule(SensorChannel::RPM_1, SensorChannel::RPM_2, true, limits.n1_amber, all_states, ErrorType::OVERSPEED_N1_1,
+            AlertLevel::CAUTION, errorBit(ErrorType::OVERSPEED_N1_2));
+    addRule(SensorChannel::EGT_1, SensorChannel::EGT_2, true, limits.egt_red_start, starting,
+            ErrorType::OVERHEAT_EGT_2, AlertLevel::WARNING, 0);
+    addRule(SensorChannel::EGT_1, SensorChannel::EGT_2, true, limits.egt_amber_start, starting,
+            ErrorType::OVERHEAT_EGT_1, AlertLevel::CAUTION, errorBit(ErrorType::OVERHEAT_EGT_2));
+    addRule(SensorChannel::EGT_1, SensorChannel::EGT_2, true, limits.egt_red_run, not_starting,
+            ErrorType::OVERHEAT_EGT_4, AlertLevel::WARNING, 0);
+    addRule(SensorChannel::EGT_1, SensorChannel::EGT_2, true, limits.egt_amber_run, not_starting,
+            ErrorType::OVERHEAT_EGT_3, AlertLevel::CAUTION, errorBit(ErrorType::OVERHEAT_EGT_4));
+    addRule(SensorChannel::FUEL_QTY, SensorChannel::FUEL_QTY, false, limits.fuel_low, all_states,
+            ErrorType::LOW_FUEL, AlertLevel::CAUTION, 0);
+    addRule(SensorChannel::FUEL_FLOW, SensorChannel::FUEL_FLOW, true, limits.fuel_flow_high, all_states,
+            ErrorType::OVERSPEED_FUEL, AlertLevel::CAUTION, 0);
+}
+
+uint32_t EICASRuleProgram::evaluateProgram(const EICASRuleProgram &program, const EngineSnapshot &data,
+                                           EngineState state)
+{
+    return program.evaluateRules(data, state);
+}
+
+uint32_t EICASRuleProgram::evaluateRules(const EngineSnapshot &data, EngineState state) const
+{
+    const double *values = &data.rpm_1;
+    const uint32_t state_bit = stateBit(state);
+
+    // 所有规则按同一形式无分支求值, 再统一去掉被同类警告压下的警戒
+    uint32_t mask = sensorVoteMask(sensorVoteTable(), packSensorValidity(data));
+    for (int i = 0; i < rule_count; i++)
+    {
+        const EICASRule &r = rules[i];
+        uint32_t hit = (values[r.channel_a] * r.sign > r.limit) | (values[r.channel_b] * r.sign > r.limit);
+        hit &= (uint32_t)((r.state_mask & state_bit) != 0);
+        mask |= hit << r.bit;
+    }
+    uint32_t suppressed = 0;
+    for (int i = 0; i < rule_count; i++)
+        suppressed |= (uint32_t)((mask & rules[i].suppressed_by) != 0) << rules[i].bit;
+    return mask & ~suppressed;
+}
+
+int EICASRuleProgram::gaugeLevel(SensorChannel channel, double value, EngineState state) const
+{
+    const uint32_t state_bit = stateBit(state);
+    int level = 0;
+    for (int i = 0; i < rule_count; i++)
+    {
+        const EICASRule &r = rules[i];
+        bool on_channel = (r.channel_a == (uint8_t)channel || r.channel_b == (uint8_t)channel);
+        if (on_channel && (r.state_mask & state_bit) && value * r.sign > r.limit && r.level > level)
+            level = r.level;
+    }
+    return level;
+}
+
+const EngineLimits &EICASRuleProgram::getLimits() const
+{
+    return limits;
+}
+
+const EICASRule *EICASRuleProgram::getRules() const
+{
+    return rules;
+}
+
+int EICASRuleProgram::getRuleCount() const
+{
+    return rule_count;
+}
+
+bool EICASRuleProgram::isSpecialized() const
+{
+    return specialized;
+}
+
+const EICASRuleProgram &EICASRuleProgram::builtin()
+{
+    static const EICASRuleProgram program;
+    return program;
+}
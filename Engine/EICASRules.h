@@ -0,0 +1,204 @@
+#pragma once
+#include "DataStructrue.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// EICAS 告警门限表: EICAS 判断、批量判断和界面仪表着色共用同一份门限
+// 门限可从配置文件按发动机型号加载, 加载时编译为扁平的规则数组 (EICASRuleProgram);
+// 编译期已知的门限 (如 DefaultEngineLimits) 走模板展开的专用判断函数, 门限直接编译为立即数
+
+// 判断用到的数值通道, 顺序与 EngineSnapshot 中的字段顺序一致
+enum class SensorChannel : uint8_t
+{
+    RPM_1,
+    RPM_2,
+    EGT_1,
+    EGT_2,
+    FUEL_QTY,
+    FUEL_FLOW,
+};
+
+static_assert(offsetof(EngineSnapshot, fuel_v) - offsetof(EngineSnapshot, rpm_1) == 5 * sizeof(double),
+              "SensorChannel indexes EngineSnapshot fields as a double array");
+
+// 一种发动机型号的门限
+struct EngineLimits
+{
+    double rpm_reference;   // N1 100% 对应的转速, 界面百分比显示用
+    double n1_red;          // 转速警告 (OVERSPEED_N1_2)
+    double n1_amber;        // 转速警戒 (OVERSPEED_N1_1)
+    double egt_red_start;   // 启动阶段排气温度警告 (OVERHEAT_EGT_2)
+    double egt_amber_start; // 启动阶段排气温度警戒 (OVERHEAT_EGT_1)
+    double egt_red_run;     // 其余状态排气温度警告 (OVERHEAT_EGT_4)
+    double egt_amber_run;   // 其余状态排气温度警戒 (OVERHEAT_EGT_3)
+    double fuel_low;        // 燃油余量低于此值 (LOW_FUEL)
+    double fuel_flow_high;  // 燃油流量高于此值 (OVERSPEED_FUEL)
+};
+
+// 内置门限, 与最初写在 EICAS::judge 中的数值相同
+struct DefaultEngineLimits
+{
+    static constexpr double RPM_REFERENCE = 40000.0;
+    static constexpr double N1_RED = 48000.0;
+    static constexpr double N1_AMBER = 42000.0;
+    static constexpr double EGT_RED_START = 1000.0;
+    static constexpr double EGT_AMBER_START = 850.0;
+    static constexpr double EGT_RED_RUN = 1100.0;
+    static constexpr double EGT_AMBER_RUN = 950.0;
+    static constexpr double FUEL_LOW = 1000.0;
+    static constexpr double FUEL_FLOW_HIGH = 50.0;
+};
+
+template <class L> EngineLimits makeEngineLimits()
+{
+    EngineLimits limits;
+    limits.rpm_reference = L::RPM_REFERENCE;
+    limits.n1_red = L::N1_RED;
+    limits.n1_amber = L::N1_AMBER;
+    limits.egt_red_start = L::EGT_RED_START;
+    limits.egt_amber_start = L::EGT_AMBER_START;
+    limits.egt_red_run = L::EGT_RED_RUN;
+    limits.egt_amber_run = L::EGT_AMBER_RUN;
+    limits.fuel_low = L::FUEL_LOW;
+    limits.fuel_flow_high = L::FUEL_FLOW_HIGH;
+    return limits;
+}
+
+// 从配置文件读取型号 engine_type 的门限; 配置文件为 "[型号]" 分节的 "键 = 值" 文本, # 开头为注释,
+// 节内未给出的键取内置值. 失败时 error 为原因
+bool loadEngineLimits(const std::string &path, const std::string &engine_type, EngineLimits &limits,
+                      std::string &error);
+
+// 传感器有效位 (每台发动机 2 个, 4 位一组) 的表决结果查找表
+struct SensorVoteTable
+{
+    uint32_t n[16];
+    uint32_t egt[16];
+};
+
+// 常量初始化, 不经函数内静态变量的初始化检查, 逐步判断时可内联访问
+extern const SensorVoteTable sensor_vote_table;
+
+inline const SensorVoteTable &sensorVoteTable()
+{
+    return sensor_vote_table;
+}
+
+// 传感器故障告警位 (转速、温度表决和燃油传感器)
+inline uint32_t sensorVoteMask(const SensorVoteTable &t, uint16_t validity)
+{
+    uint32_t mask = t.n[(validity >> SENSOR_VALID_N_SHIFT) & 0xF] | t.egt[(validity >> SENSOR_VALID_EGT_SHIFT) & 0xF];
+    mask |= (uint32_t)((validity & SENSOR_VALID_FUEL) == 0) << (int)ErrorType::SENSOR_FUEL;
+    return mask;
+}
+
+// 编译期门限的专用判断, 结果与 EICASRuleProgram::evaluate 相同
+template <class L>
+inline uint32_t judgeRawMaskStatic(double rpm_1, double rpm_2, double egt1_temp, double egt2_temp, double fuel_c,
+                                   double fuel_v, uint16_t validity, EngineState state)
+{
+    bool starting = (state == EngineState::STARTING);
+    uint32_t n_red = (rpm_1 > L::N1_RED) | (rpm_2 > L::N1_RED);
+    uint32_t n_amber = ((rpm_1 > L::N1_AMBER) | (rpm_2 > L::N1_AMBER)) & ~n_red & 1u;
+    const double red_start = L::EGT_RED_START, red_run = L::EGT_RED_RUN;
+    const double amber_start = L::EGT_AMBER_START, amber_run = L::EGT_AMBER_RUN;
+    double egt_red_limit = starting ? red_start : red_run;
+    double egt_amber_limit = starting ? amber_start : amber_run;
+    uint32_t egt_red = (egt1_temp > egt_red_limit) | (egt2_temp > egt_red_limit);
+    uint32_t egt_amber = ((egt1_temp > egt_amber_limit) | (egt2_temp > egt_amber_limit)) & ~egt_red & 1u;
+    int egt_red_bit = starting ? (int)ErrorType::OVERHEAT_EGT_2 : (int)ErrorType::OVERHEAT_EGT_4;
+    int egt_amber_bit = starting ? (int)ErrorType::OVERHEAT_EGT_1 : (int)ErrorType::OVERHEAT_EGT_3;
+
+    uint32_t mask = sensorVoteMask(sensorVoteTable(), validity);
+    mask |= n_red << (int)ErrorType::OVERSPEED_N1_2;
+    mask |= n_amber << (int)ErrorType::OVERSPEED_N1_1;
+    mask |= egt_red << egt_red_bit;
+    mask |= egt_amber << egt_amber_bit;
+    mask |= (uint32_t)(fuel_c < L::FUEL_LOW) << (int)ErrorType::LOW_FUEL;
+    mask |= (uint32_t)(fuel_v > L::FUEL_FLOW_HIGH) << (int)ErrorType::OVERSPEED_FUEL;
+    return mask;
+}
+
+template <class L> inline uint32_t judgeRawMaskStatic(const EngineSnapshot &data, EngineState state)
+{
+    return judgeRawMaskStatic<L>(data.rpm_1, data.rpm_2, data.egt1_temp, data.egt2_temp, data.fuel_c, data.fuel_v,
+                                 packSensorValidity(data), state);
+}
+
+// 一条门限规则: channel_a 或 channel_b 越限且发动机处于 state_mask 中的状态时置位 bit
+struct EICASRule
+{
+    double sign;            // +1 为高于门限告警, -1 为低于门限告警
+    double limit;           // 已乘以 sign, 判断统一为 value * sign > limit
+    uint32_t state_mask;    // 1 << EngineState 的组合
+    uint32_t suppressed_by; // 其中任一告警位同时成立时不报本条 (警戒让位于同类警告)
+    uint8_t channel_a;      // SensorChannel
+    uint8_t channel_b;      // 单通道规则与 channel_a 相同
+    uint8_t bit;            // ErrorType
+    uint8_t level;          // AlertLevel, 界面仪表着色用
+    uint32_t reserved;
+};
+
+static_assert(sizeof(EICASRule) == 32, "EICASRule must be 32 bytes");
+
+class EICASRuleProgram;
+typedef uint32_t (*EICASEvaluator)(const EICASRuleProgram &program, const EngineSnapshot &data, EngineState state);
+
+// 由门限编译出的规则数组; 编译后只读, 可被多个线程同时使用
+class EICASRuleProgram
+{
+public:
+    static const int MAX_RULES = 16;
+
+    // 内置门限
+    EICASRuleProgram();
+    explicit EICASRuleProgram(const EngineLimits &limits);
+
+    // 门限与某个编译期门限相同时使用其专用判断函数, 否则按规则数组逐条判断
+    void compile(const EngineLimits &limits);
+    // 指定编译期门限, 总是使用专用判断函数
+    template <class L> void compileStatic()
+    {
+        build(makeEngineLimits<L>());
+        evaluator = &evaluateStatic<L>;
+        specialized = true;
+    }
+
+    // 原始告警位掩码 (与 judgeRawMask 的含义相同)
+    uint32_t evaluate(const EngineSnapshot &data, EngineState state) const
+    {
+        return evaluator(*this, data, state);
+    }
+    // 只按规则数组判断, 不走专用函数 (用于对照和基准测试)
+    uint32_t evaluateRules(const EngineSnapshot &data, EngineState state) const;
+
+    // 单个通道的数值在当前状态下的告警等级: 0 正常, 1 警戒, 2 警告
+    int gaugeLevel(SensorChannel channel, double value, EngineState state) const;
+
+    const EngineLimits &getLimits() const;
+    const EICASRule *getRules() const;
+    int getRuleCount() const;
+    bool isSpecialized() const;
+
+    // 内置门限编译出的共享实例
+    static const EICASRuleProgram &builtin();
+
+private:
+    template <class L>
+    static uint32_t evaluateStatic(const EICASRuleProgram &, const EngineSnapshot &data, EngineState state)
+    {
+        return judgeRawMaskStatic<L>(data, state);
+    }
+    static uint32_t evaluateProgram(const EICASRuleProgram &program, const EngineSnapshot &data, EngineState state);
+
+    void build(const EngineLimits &limits);
+    void addRule(SensorChannel a, SensorChannel b, bool above, double limit, uint32_t state_mask, ErrorType bit,
+                 AlertLevel level, uint32_t suppressed_by);
+
+    EngineLimits limits;
+    EICASRule rules[MAX_RULES];
+    int rule_count;
+    EICASEvaluator evaluator;
+    bool specialized;
+};
@@ -0,0 +1,285 @@
+#include "FaultCampaign.h"
+#include "EICAS.h"
+#include "EICASBatch.h"
+#include "Random.h"
+#include "Simulator.h"
+
+// 与 main.cpp 故障按钮一致的 14 种故障
+static const ErrorType campaign_faults[] = {
+    ErrorType::SENSOR_N_ONE,   ErrorType::SENSOR_N_TWO,   ErrorType::SENSOR_EGT_ONE, ErrorType::SENSOR_EGT_TWO,
+    ErrorType::SENSOR_FUEL,    ErrorType::SENSOR_ALL,     ErrorType::LOW_FUEL,       ErrorType::OVERSPEED_N1_1,
+    ErrorType::OVERSPEED_N1_2, ErrorType::OVERHEAT_EGT_1, ErrorType::OVERHEAT_EGT_2, ErrorType::OVERHEAT_EGT_3,
+    ErrorType::OVERHEAT_EGT_4, ErrorType::OVERSPEED_FUEL};
+
+static const EngineState campaign_phases[] = {EngineState::STARTING, EngineState::RUNNING, EngineState::STOPPING};
+
+// 推力序列的操作次数和间隔
+static const int THRUST_COMMANDS = 6;
+static const double THRUST_INTERVAL = 1.0;
+
+// 长时间到达不了目标阶段时放弃本次试验
+static const double PHASE_TIMEOUT = 120.0;
+
+const char *getThrustScheduleName(ThrustSchedule schedule)
+{
+    switch (schedule)
+    {
+    case ThrustSchedule::HOLD:
+        return "HOLD";
+    case ThrustSchedule::RAMP_UP:
+        return "RAMP_UP";
+    case ThrustSchedule::RAMP_DOWN:
+        return "RAMP_DOWN";
+    case ThrustSchedule::OSCILLATE:
+        return "OSCILLATE";
+    }
+    return "?";
+}
+
+std::vector<Scenario> buildCampaign(const CampaignOptions &options)
+{
+    std::vector<Scenario> scenarios;
+    for (ErrorType fault : campaign_faults)
+    {
+        for (EngineState phase : campaign_phases)
+        {
+            for (int s = 0; s < THRUST_SCHEDULE_COUNT; s++)
+            {
+                for (int k = 0; k < options.seeds_per_case; k++)
+                {
+                    Scenario sc;
+                    sc.fault = fault;
+                    sc.phase = phase;
+                    sc.schedule = (ThrustSchedule)s;
+                    sc.seed = Random::streamSeed(options.base_seed, scenarios.size());
+                    scenarios.push_back(sc);
+                }
+            }
+        }
+    }
+    return scenarios;
+}
+
+ScenarioResult runScenario(const Scenario &scenario, double observe_seconds)
+{
+    ScenarioResult r;
+    r.scenario = scenario;
+    r.injected = false;
+    r.detected = false;
+    r.fault_alerted = false;
+    r.first_alert = ErrorType::NONE;
+    r.detect_latency = 0.0;
+    r.persistence = 0.0;
+    r.auto_shutdown = false;
+    r.shutdown_latency = 0.0;
+    r.steps = 0;
+
+    Simulator sim;
+    EICAS eicas;
+    sim.seed(scenario.seed);
+
+    // 注入时刻在阶段内随机偏移 0 ~ 1 秒
+    Random jitter_rng(Random::streamSeed(scenario.seed, 1));
+    double jitter = jitter_rng.nextBelow(1000) / 1000.0;
+
+    const double dt = 0.005;
+    double running_since = -1.0;
+    double stop_issued_at = -1.0;
+    double inject_at = -1.0;
+    double inject_time = 0.0;
+    double next_thrust = 0.0;
+    int thrust_done = 0;
+    bool persisting = false;
+    uint32_t prev_shown = 0;
+
+    sim.startEngine();
+
+    for (uint64_t step = 1;; step++)
+    {
+        double t = step * dt;
+        EngineState state = sim.getState();
+
+        if (running_since < 0.0 && state == EngineState::RUNNING)
+        {
+            running_since = t;
+            next_thrust = t + 0.5;
+        }
+
+        // 安排注入时刻
+        if (!r.injected && inject_at < 0.0)
+        {
+            if (scenario.phase == EngineState::STARTING)
+                inject_at = 1.0 + jitter;
+            else if (scenario.phase == EngineState::RUNNING && running_since >= 0.0)
+                inject_at = running_since + 2.0 + jitter;
+            else if (scenario.phase == EngineState::STOPPING && running_since >= 0.0 && stop_issued_at < 0.0 &&
+                     t >= running_since + 2.0 + jitter)
+            {
+                sim.stopEngine();
+                stop_issued_at = t;
+                inject_at = t + 1.0;
+            }
+        }
+
+        if (!r.injected && inject_at >= 0.0 && t >= inject_at && sim.getState() == scenario.phase)
+        {
+            sim.setErrorType(scenario.fault);
+            r.injected = true;
+            inject_time = t;
+        }
+
+        // 推力序列
+        if (scenario.schedule != ThrustSchedule::HOLD && running_since >= 0.0 && thrust_done < THRUST_COMMANDS &&
+            sim.getState() == EngineState::RUNNING && t >= next_thrust)
+        {
+            bool up = scenario.schedule == ThrustSchedule::RAMP_UP ||
+                      (scenario.schedule == ThrustSchedule::OSCILLATE && thrust_done % 2 == 0);
+            if (up)
+                sim.addDash();
+            else
+                sim.reduceDash();
+            thrust_done++;
+            next_thrust = t + THRUST_INTERVAL;
+        }
+
+        sim.update();
+        r.steps++;
+
+        EngineState eng_state = sim.getState();
+        uint32_t shown = eicas.judgeMask(sim.getSnapshot(), eng_state, t);
+
+        // 自动停车保护逻辑 (与 main.cpp 相同)
+        if (EICAS::hasCritical(shown) && eng_state != EngineState::OFF && eng_state != EngineState::STOPPING)
+        {
+            sim.stopEngine();
+            if (r.injected && !r.auto_shutdown)
+            {
+                r.auto_shutdown = true;
+                r.shutdown_latency = t - inject_time;
+            }
+        }
+
+        if (r.injected)
+        {
+            uint32_t newly = shown & ~prev_shown;
+            if (!r.detected && newly)
+            {
+                ErrorType order[ERROR_TYPE_COUNT];
+                expandAlertMask(newly, order);
+                r.detected = true;
+                r.first_alert = order[0];
+                r.detect_latency = t - inject_time;
+                persisting = true;
+            }
+            if (newly & errorBit(scenario.fault))
+                r.fault_alerted = true;
+
+            if (persisting)
+            {
+                if (shown & errorBit(r.first_alert))
+                    r.persistence = t - inject_time - r.detect_latency;
+                else
+                    persisting = false;
+            }
+
+            if (t - inject_time >= observe_seconds)
+                break;
+        }
+        else if (t > PHASE_TIMEOUT)
+        {
+            break;
+        }
+
+        prev_shown = shown;
+    }
+
+    return r;
+}
+
+struct CaseSummary
+{
+    int runs;
+    int injected;
+    int detected;
+    int fault_alerted;
+    int shutdowns;
+    double latency_sum;
+    double latency_max;
+    double persistence_sum;
+    double shutdown_latency_sum;
+};
+
+void writeCampaignReport(std::FILE *out, const std::vector<ScenarioResult> &results)
+{
+    CaseSummary cases[ERROR_TYPE_COUNT][3] = {};
+    uint64_t total_steps = 0;
+
+    for (const ScenarioResult &r : results)
+    {
+        int phase_index = (r.scenario.phase == EngineState::STARTING) ? 0
+                          : (r.scenario.phase == EngineState::RUNNING) ? 1
+                                                                        : 2;
+        CaseSummary &c = cases[(int)r.scenario.fault][phase_index];
+        c.runs++;
+        total_steps += r.steps;
+        if (!r.injected)
+            continue;
+        c.injected++;
+        if (r.detected)
+        {
+            c.detected++;
+            c.latency_sum += r.detect_latency;
+            if (r.detect_latency > c.latency_max)
+                c.latency_max = r.detect_latency;
+            c.persistence_sum += r.persistence;
+        }
+        if (r.fault_alerted)
+            c.fault_alerted++;
+        if (r.auto_shutdown)
+        {
+            c.shutdowns++;
+            c.shutdown_latency_sum += r.shutdown_latency;
+        }
+    }
+
+    std::fprintf(out, "%-16s %-9s %5s %5s %7s %7s %9s %9s %8s %7s %9s\n", "fault", "phase", "runs", "inj",
+                 "detect%", "match%", "lat_avg_ms", "lat_max_ms", "persist_s", "shut%", "shut_ms");
+    for (ErrorType fault : campaign_faults)
+    {
+        for (int p = 0; p < 3; p++)
+        {
+            const CaseSummary &c = cases[(int)fault][p];
+            if (c.runs == 0)
+                continue;
+            double inj = (c.injected > 0) ? c.injected : 1;
+            double det = (c.detected > 0) ? c.detected : 1;
+            double shut = (c.shutdowns > 0) ? c.shutdowns : 1;
+            std::fprintf(out, "%-16s %-9s %5d %5d %6.1f%% %6.1f%% %10.1f %10.1f %9.2f %6.1f%% %9.1f\n",
+                         EICAS::getErrorName(fault), getEngineStateName(campaign_phases[p]), c.runs, c.injected,
+                         100.0 * c.detected / inj, 100.0 * c.fault_alerted / inj, 1000.0 * c.latency_sum / det,
+                         1000.0 * c.latency_max, c.persistence_sum / det, 100.0 * c.shutdowns / inj,
+                         1000.0 * c.shutdown_latency_sum / shut);
+        }
+    }
+    std::fprintf(out, "scenarios %zu, simulated steps %llu (%.1f h of sim time)\n", results.size(),
+                 (unsigned long long)total_steps, total_steps * 0.005 / 3600.0);
+}
+
+bool writeCampaignCsv(const std::string &path, const std::vector<ScenarioResult> &results)
+{
+    std::FILE *f = std::fopen(path.c_str(), "w");
+    if (!f)
+        return false;
+    std::fprintf(f, "fault,phase,schedule,seed,injected,detected,fault_alerted,first_alert,detect_latency_s,"
+                    "persistence_s,auto_shutdown,shutdown_latency_s\n");
+    for (const ScenarioResult &r : results)
+    {
+        std::fprintf(f, "%s,%s,%s,%llu,%d,%d,%d,%s,%.3f,%.3f,%d,%.3f\n", EICAS::getErrorName(r.scenario.fault),
+                     getEngineStateName(r.scenario.phase), getThrustScheduleName(r.scenario.schedule),
+                     (unsigned long long)r.scenario.seed, r.injected, r.detected, r.fault_alerted,
+                     EICAS::getErrorName(r.first_alert), r.detect_latency, r.persistence, r.auto_shutdown,
+                     r.shutdown_latency);
+    }
+    std::fclose(f);
+    return true;
+}
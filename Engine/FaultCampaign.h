@@ -0,0 +1,61 @@
+#pragma once
+#include "DataStructrue.h"
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// 推力操作序列 (在 RUNNING 阶段每秒执行一次 addDash / reduceDash)
+enum class ThrustSchedule
+{
+    HOLD,      // 不操作
+    RAMP_UP,   // 连续加推力
+    RAMP_DOWN, // 连续减推力
+    OSCILLATE, // 加减交替
+};
+
+const int THRUST_SCHEDULE_COUNT = 4;
+
+// 一次故障注入试验
+struct Scenario
+{
+    ErrorType fault;
+    EngineState phase; // 注入故障时的发动机阶段: STARTING / RUNNING / STOPPING
+    ThrustSchedule schedule;
+    uint64_t seed;
+};
+
+struct ScenarioResult
+{
+    Scenario scenario;
+    bool injected;           // 是否到达了目标阶段并注入故障
+    bool detected;           // 注入后是否出现新的告警消息
+    bool fault_alerted;      // 是否出现与注入故障同类型的告警
+    ErrorType first_alert;   // 注入后第一个新出现的告警
+    double detect_latency;   // 注入到第一个新告警的时间 (秒)
+    double persistence;      // 第一个新告警持续显示的时间 (秒)
+    bool auto_shutdown;      // 是否触发自动停车
+    double shutdown_latency; // 注入到自动停车的时间 (秒)
+    uint64_t steps;          // 本次试验的仿真步数
+};
+
+struct CampaignOptions
+{
+    int seeds_per_case;     // 每种 故障 x 阶段 x 推力序列 组合的随机种子数
+    uint64_t base_seed;
+    double observe_seconds; // 注入后观察的仿真时长
+};
+
+// 生成全部试验: 14 种故障 x 3 个阶段 x 推力序列 x 种子
+std::vector<Scenario> buildCampaign(const CampaignOptions &options);
+
+// 运行一次试验 (仿真与判断都在调用线程上, 不共享状态, 可多线程并行)
+ScenarioResult runScenario(const Scenario &scenario, double observe_seconds);
+
+// 按 故障 x 阶段 汇总并输出文本报告
+void writeCampaignReport(std::FILE *out, const std::vector<ScenarioResult> &results);
+
+// 逐次试验的明细 CSV
+bool writeCampaignCsv(const std::string &path, const std::vector<ScenarioResult> &results);
+
+const char *getThrustScheduleName(ThrustSchedule schedule);
@@ -0,0 +1,338 @@
+#include "FleetSimulator.h"
+#include <cmath>
+
+static const uint8_t ST_OFF = (uint8_t)EngineState::OFF;
+static const uint8_t ST_STARTING = (uint8_t)EngineState::STARTING;
+static const uint8_t ST_RUNNING = (uint8_t)EngineState::RUNNING;
+static const uint8_t ST_STOPPING = (uint8_t)EngineState::STOPPING;
+
+FleetSimulator::FleetSimulator(size_t engine_count)
+    : count(engine_count), state(engine_count, ST_OFF), error_type(engine_count, (uint8_t)ErrorType::NONE),
+      phase_timer(engine_count, 0.0), record_n(engine_count, 0.0), record_egt(engine_count, 0.0),
+      record_fuel_v(engine_count, 0.0), real_fuel_c(engine_count, 20000.0), real_fuel_v(engine_count, 0.0),
+      real_rpm_1(engine_count, 0.0), real_rpm_2(engine_count, 0.0), real_egt1(engine_count, 20.0),
+      real_egt2(engine_count, 20.0), out_rpm_1(engine_count, 0.0), out_rpm_2(engine_count, 0.0),
+      out_egt1(engine_count, 20.0), out_egt2(engine_count, 20.0), out_fuel_c(engine_count, 20000.0),
+      out_fuel_v(engine_count, 0.0), out_valid(engine_count, SENSOR_VALID_ALL), rng(engine_count),
+      noise(engine_count, 0.0)
+{
+    seed(1);
+}
+
+FleetSimulator::~FleetSimulator() {}
+
+size_t FleetSimulator::size() const
+{
+    return count;
+}
+
+void FleetSimulator::startEngine(size_t i)
+{
+    if (state[i] == ST_OFF || state[i] == ST_STOPPING)
+    {
+        state[i] = ST_STARTING;
+        phase_timer[i] = 0.0;
+    }
+}
+
+void FleetSimulator::stopEngine(size_t i)
+{
+    if (state[i] != ST_OFF)
+    {
+        state[i] = ST_STOPPING;
+        phase_timer[i] = 0.0;
+        // 记录停止前的状态基准
+        record_n[i] = real_rpm_1[i];
+        record_egt[i] = real_egt1[i];
+    }
+}
+
+void FleetSimulator::startAll()
+{
+    for (size_t i = 0; i < count; i++)
+        startEngine(i);
+}
+
+void FleetSimulator::stopAll()
+{
+    for (size_t i = 0; i < count; i++)
+        stopEngine(i);
+}
+
+void FleetSimulator::addDash(size_t i)
+{
+    if (state[i] == ST_RUNNING)
+    {
+        record_fuel_v[i] += 1.0;
+        double jump = rng[i].nextDashJump();
+        record_n[i] = record_n[i] * (1.0 + jump);
+        record_egt[i] = record_egt[i] * (1.0 + jump);
+        if (record_n[i] > 50000)
+            record_n[i] = 50000;
+    }
+}
+
+void FleetSimulator::reduceDash(size_t i)
+{
+    if (state[i] == ST_RUNNING)
+    {
+        record_fuel_v[i] -= 1.0;
+        if (record_fuel_v[i] < 0)
+            record_fuel_v[i] = 0;
+        double jump = rng[i].nextDashJump();
+        record_n[i] = record_n[i] * (1.0 - jump);
+        record_egt[i] = record_egt[i] * (1.0 - jump);
+        if (record_n[i] < 0)
+            record_n[i] = 0;
+    }
+}
+
+void FleetSimulator::setErrorType(size_t i, ErrorType type)
+{
+    error_type[i] = (uint8_t)type;
+}
+
+void FleetSimulator::seed(uint64_t base_seed)
+{
+    for (size_t i = 0; i < count; i++)
+        rng[i].seed(Random::streamSeed(base_seed, i));
+}
+
+void FleetSimulator::seedEngine(size_t i, uint64_t seed_value)
+{
+    rng[i].seed(seed_value);
+}
+
+void FleetSimulator::update()
+{
+    updateRange(0, count);
+}
+
+void FleetSimulator::updateRange(size_t begin, size_t end)
+{
+    // 先成批生成本步的扰动值, 只为 RUNNING 的发动机取数, 与 Simulator 的取数顺序一致
+    for (size_t i = begin; i < end; i++)
+    {
+        if (state[i] == ST_RUNNING)
+            noise[i] = rng[i].nextNoise();
+    }
+
+    for (size_t i = begin; i < end; i++)
+        updateEngine(i);
+}
+
+void FleetSimulator::updateEngine(size_t i)
+{
+    uint8_t st = state[i];
+    if (st == ST_STARTING || st == ST_STOPPING)
+    {
+        phase_timer[i] += dt;
+    }
+
+    // 消耗燃油
+    if (real_fuel_c[i] > 0)
+    {
+        real_fuel_c[i] -= real_fuel_v[i] * dt;
+    }
+
+    // 燃油耗尽触发停车
+    if (real_fuel_c[i] <= 0.0 && st != ST_STOPPING && st != ST_OFF)
+    {
+        real_fuel_c[i] = 0.0;
+        stopEngine(i);
+        st = state[i];
+    }
+
+    double t = phase_timer[i];
+
+    switch (st)
+    {
+    case ST_STARTING:
+        if (t <= 2.0)
+        {
+            real_rpm_1[i] += 50;
+            real_rpm_2[i] += 50;
+            real_fuel_v[i] += 0.025;
+        }
+        else
+        {
+            double lg = log10(t - 1.0);
+            real_fuel_v[i] = 42.0 * lg + 10.0;
+            real_rpm_1[i] = 23000.0 * lg + 20000.0;
+            real_rpm_2[i] = 23000.0 * lg + 20000.0;
+            real_egt1[i] = 900.0 * lg + 20.0;
+            real_egt2[i] = 900.0 * lg + 20.0;
+
+            if (real_rpm_1[i] >= 40000 * 0.95)
+            {
+                state[i] = ST_RUNNING;
+                record_n[i] = real_rpm_1[i];
+                record_egt[i] = real_egt1[i];
+                record_fuel_v[i] = real_fuel_v[i];
+            }
+        }
+        break;
+
+    case ST_RUNNING:
+    {
+        double n = noise[i];
+
+        real_rpm_1[i] = record_n[i] * (1.0 + n);
+        real_rpm_2[i] = real_rpm_1[i];
+        real_egt1[i] = record_egt[i] * (1.0 + n);
+        real_egt2[i] = record_egt[i] * (1.0 + n);
+        real_fuel_v[i] = record_fuel_v[i] * (1.0 + n);
+        break;
+    }
+    case ST_STOPPING:
+        real_fuel_v[i] = 0;
+        if (t >= 10.0)
+        {
+            real_rpm_1[i] = 0;
+            real_rpm_2[i] = 0;
+            real_egt1[i] = 20.0;
+            real_egt2[i] = 20.0;
+            state[i] = ST_OFF;
+        }
+        else
+        {
+            double decay = std::pow(0.6, t);
+            real_rpm_1[i] = record_n[i] * decay;
+            real_rpm_2[i] = real_rpm_1[i];
+            real_egt1[i] = (record_egt[i] - 20.0) * decay + 20.0;
+            real_egt2[i] = (record_egt[i] - 20.0) * decay + 20.0;
+        }
+        break;
+    default:
+        real_rpm_1[i] = 0.0;
+        real_rpm_2[i] = 0.0;
+        real_egt1[i] = 20.0;
+        real_egt2[i] = 20.0;
+        real_fuel_v[i] = 0.0;
+        break;
+    }
+
+    // 真实值同步到传感器输出
+    out_fuel_c[i] = real_fuel_c[i];
+    out_fuel_v[i] = real_fuel_v[i];
+    out_rpm_1[i] = real_rpm_1[i];
+    out_rpm_2[i] = real_rpm_2[i];
+    out_egt1[i] = real_egt1[i];
+    out_egt2[i] = real_egt2[i];
+    out_valid[i] = SENSOR_VALID_ALL;
+
+    if (error_type[i] != (uint8_t)ErrorType::NONE)
+        applyFault(i);
+}
+
+void FleetSimulator::applyFault(size_t i)
+{
+    // 注入故障 (与 Simulator::update 相同)
+    switch ((ErrorType)error_type[i])
+    {
+    case ErrorType::SENSOR_N_ONE:
+        out_valid[i] &= ~(1 << SENSOR_VALID_N_SHIFT);
+        break;
+    case ErrorType::SENSOR_N_TWO:
+        out_rpm_1[i] = -1.0;
+        out_valid[i] &= ~(3 << SENSOR_VALID_N_SHIFT);
+        break;
+    case ErrorType::SENSOR_EGT_ONE:
+        out_valid[i] &= ~(1 << SENSOR_VALID_EGT_SHIFT);
+        break;
+    case ErrorType::SENSOR_EGT_TWO:
+        out_egt1[i] = -50.0;
+        out_valid[i] &= ~(3 << SENSOR_VALID_EGT_SHIFT);
+        break;
+    case ErrorType::SENSOR_ALL:
+        out_egt1[i] = -500.0;
+        out_egt2[i] = -500.0;
+        out_valid[i] &= ~(0xF << SENSOR_VALID_EGT_SHIFT);
+        break;
+    case ErrorType::SENSOR_FUEL:
+        out_fuel_c[i] = -0.0;
+        out_valid[i] &= ~SENSOR_VALID_FUEL;
+        break;
+    case ErrorType::OVERSPEED_N1_1:
+        out_rpm_1[i] = 42400.0;
+        break;
+    case ErrorType::OVERSPEED_N1_2:
+        out_rpm_1[i] = 50000.0;
+        break;
+    case ErrorType::OVERHEAT_EGT_1:
+        out_egt1[i] = 900.0;
+        break;
+    case ErrorType::OVERHEAT_EGT_2:
+        out_egt2[i] = 1050.0;
+        break;
+    case ErrorType::OVERHEAT_EGT_3:
+        out_egt1[i] = 1000.0;
+        break;
+    case ErrorType::OVERHEAT_EGT_4:
+        out_egt2[i] = 1250.0;
+        break;
+    case ErrorType::LOW_FUEL:
+        out_fuel_c[i] = 500.0;
+        break;
+    case ErrorType::OVERSPEED_FUEL:
+        out_fuel_v[i] = 55.0;
+        break;
+    default:
+        break;
+    }
+}
+
+bool FleetSimulator::isStabilized(size_t i) const
+{
+    return (state[i] == ST_RUNNING && out_rpm_1[i] >= max_rpm * 0.95 && out_rpm_2[i] >= max_rpm * 0.95);
+}
+
+double FleetSimulator::getN1(size_t i) const
+{
+    if ((ErrorType)error_type[i] == ErrorType::SENSOR_N_TWO)
+        return -0.0;
+    return (out_rpm_1[i] / max_rpm) * 100.0;
+}
+
+double FleetSimulator::getN2(size_t i) const
+{
+    return (out_rpm_2[i] / max_rpm) * 100.0;
+}
+
+EngineState FleetSimulator::getState(size_t i) const
+{
+    return (EngineState)state[i];
+}
+
+EngineSnapshot FleetSimulator::getSnapshot(size_t i) const
+{
+    EngineSnapshot data = {};
+    data.rpm_1 = out_rpm_1[i];
+    data.rpm_2 = out_rpm_2[i];
+    data.egt1_temp = out_egt1[i];
+    data.egt2_temp = out_egt2[i];
+    data.fuel_c = out_fuel_c[i];
+    data.fuel_v = out_fuel_v[i];
+    unpackSensorValidity(out_valid[i], data);
+    return data;
+}
+
+EngineColumns FleetSimulator::columns() const
+{
+    return columns(0, count);
+}
+
+EngineColumns FleetSimulator::columns(size_t begin, size_t end) const
+{
+    EngineColumns c;
+    c.rpm_1 = out_rpm_1.data() + begin;
+    c.rpm_2 = out_rpm_2.data() + begin;
+    c.egt1_temp = out_egt1.data() + begin;
+    c.egt2_temp = out_egt2.data() + begin;
+    c.fuel_c = out_fuel_c.data() + begin;
+    c.fuel_v = out_fuel_v.data() + begin;
+    c.validity = out_valid.data() + begin;
+    c.state = state.data() + begin;
+    c.count = end - begin;
+    return c;
+}
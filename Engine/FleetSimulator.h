@@ -0,0 +1,96 @@
+#pragma once
+#include "DataStructrue.h"
+#include "EICASBatch.h"
+#include "Random.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// 多台发动机仿真器: 按通道连续存放 (结构体数组 -> 数组结构体), 一次 update() 推进全部发动机
+// 每台发动机的行为与 Simulator 完全一致
+class FleetSimulator
+{
+private:
+    size_t count;
+
+    // 状态通道
+    std::vector<uint8_t> state;
+    std::vector<uint8_t> error_type;
+    std::vector<double> phase_timer;
+
+    std::vector<double> record_n;
+    std::vector<double> record_egt;
+    std::vector<double> record_fuel_v;
+
+    // 真实值通道
+    std::vector<double> real_fuel_c;
+    std::vector<double> real_fuel_v;
+    std::vector<double> real_rpm_1;
+    std::vector<double> real_rpm_2;
+    std::vector<double> real_egt1;
+    std::vector<double> real_egt2;
+
+    // 传感器输出通道 (已注入故障)
+    std::vector<double> out_rpm_1;
+    std::vector<double> out_rpm_2;
+    std::vector<double> out_egt1;
+    std::vector<double> out_egt2;
+    std::vector<double> out_fuel_c;
+    std::vector<double> out_fuel_v;
+    std::vector<uint16_t> out_valid;
+
+    // 每台发动机独立的随机数发生器和本步的扰动值
+    std::vector<Random> rng;
+    std::vector<double> noise;
+
+    static constexpr double max_rpm = 40000.0;
+    static constexpr double dt = 0.005;
+
+    void updateEngine(size_t i);
+    void applyFault(size_t i);
+
+public:
+    explicit FleetSimulator(size_t engine_count);
+    ~FleetSimulator();
+
+    size_t size() const;
+
+    void startEngine(size_t i);
+    void stopEngine(size_t i);
+    void addDash(size_t i);
+    void reduceDash(size_t i);
+    void setErrorType(size_t i, ErrorType type);
+
+    // 第 i 台发动机使用 Random::streamSeed(base_seed, i), 与同种子的 Simulator 逐步一致
+    void seed(uint64_t base_seed);
+    void seedEngine(size_t i, uint64_t seed_value);
+
+    void startAll();
+    void stopAll();
+
+    // 推进全部发动机一个仿真步
+    void update();
+
+    // 只推进 [begin, end) 范围内的发动机; 各台发动机互不依赖, 不同线程可并行处理不相交的范围
+    void updateRange(size_t begin, size_t end);
+
+    bool isStabilized(size_t i) const;
+    double getN1(size_t i) const;
+    double getN2(size_t i) const;
+    EngineState getState(size_t i) const;
+    EngineSnapshot getSnapshot(size_t i) const;
+
+    // 按通道直接访问传感器输出, 供批量判断和统计使用
+    const double *rpm1() const { return out_rpm_1.data(); }
+    const double *rpm2() const { return out_rpm_2.data(); }
+    const double *egt1() const { return out_egt1.data(); }
+    const double *egt2() const { return out_egt2.data(); }
+    const double *fuelQuantity() const { return out_fuel_c.data(); }
+    const double *fuelFlow() const { return out_fuel_v.data(); }
+    const uint16_t *validity() const { return out_valid.data(); }
+    const uint8_t *states() const { return state.data(); }
+
+    // 全部发动机的列视图, 可直接交给 judgeBatch
+    EngineColumns columns() const;
+    EngineColumns columns(size_t begin, size_t end) const;
+};
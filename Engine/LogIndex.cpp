@@ -0,0 +1,522 @@
+#include "LogIndex.h"
+#include "LogReplay.h"
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+
+std::string logIndexPath(const std::string &log_path)
+{
+    return log_path + ".idx";
+}
+
+// ALERT,<时间>,MESSAGE:,<文本>
+static bool parseAlertLine(const char *begin, const char *end, double &time, const char *&text)
+{
+    const char *p = (const char *)std::memchr(begin, ',', end - begin);
+    if (!p)
+        return false;
+    std::from_chars_result res = std::from_chars(p + 1, end, time);
+    if (res.ec != std::errc() || res.ptr == end)
+        return false;
+    p = (const char *)std::memchr(res.ptr + 1, ',', end - res.ptr - 1);
+    if (!p)
+        return false;
+    text = p + 1;
+    return true;
+}
+
+// 去掉行尾的换行
+static const char *trimLineEnd(const char *begin, const char *end)
+{
+    while (end > begin && (end[-1] == '\n' || end[-1] == '\r'))
+        end--;
+    return end;
+}
+
+// ---- LogIndexWriter ----
+
+LogIndexWriter::LogIndexWriter() : opened(false)
+{
+    std::memset(&header, 0, sizeof(header));
+}
+
+void LogIndexWriter::open(const std::string &index_path, LogIndexFormat format, uint32_t chunk_rows)
+{
+    path = index_path;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, LOG_INDEX_MAGIC, sizeof(header.magic));
+    header.version = LOG_INDEX_VERSION;
+    header.log_format = (uint32_t)format;
+    header.chunk_rows = chunk_rows;
+    chunks.clear();
+    alerts.clear();
+    texts.clear();
+    text_ids.clear();
+    opened = true;
+}
+
+bool LogIndexWriter::isOpen() const
+{
+    return opened;
+}
+
+void LogIndexWriter::addChunk(uint64_t offset, uint64_t size, double first_time, double last_time, uint32_t rows)
+{
+    if (!opened)
+        return;
+    LogIndexChunk c;
+    c.offset = offset;
+    c.size = size;
+    c.first_time = first_time;
+    c.last_time = last_time;
+    c.rows = rows;
+    c.first_alert = chunks.empty() ? 0 : chunks.back().first_alert;
+    // 上一块之后记录的报警都属于本块
+    while (c.first_alert < alerts.size() && alerts[c.first_alert].chunk < chunks.size())
+        c.first_alert++;
+
+    if (chunks.empty())
+        header.first_time = first_time;
+    header.last_time = last_time;
+    chunks.push_back(c);
+}
+
+void LogIndexWriter::addAlert(uint64_t offset, uint32_t length, double time, uint32_t row, const char *text,
+                              size_t len)
+{
+    if (!opened)
+        return;
+    std::string key(text, len);
+    auto it = text_ids.find(key);
+    if (it == text_ids.end())
+    {
+        it = text_ids.emplace(key, (uint32_t)texts.size()).first;
+        texts.push_back(key);
+    }
+
+    LogIndexAlert a;
+    a.offset = offset;
+    a.time = time;
+    a.chunk = (uint32_t)chunks.size();
+    a.text = it->second;
+    a.row = row;
+    a.length = length;
+    alerts.push_back(a);
+}
+
+bool LogIndexWriter::close(uint64_t log_size)
+{
+    if (!opened)
+        return false;
+    opened = false;
+
+    header.chunk_count = (uint32_t)chunks.size();
+    header.alert_count = (uint32_t)alerts.size();
+    header.text_count = (uint32_t)texts.size();
+    header.log_size = log_size;
+
+    std::FILE *f = std::fopen(path.c_str(), "wb");
+    if (!f)
+        return false;
+    std::fwrite(&header, sizeof(header), 1, f);
+    if (!chunks.empty())
+        std::fwrite(chunks.data(), sizeof(LogIndexChunk), chunks.size(), f);
+    if (!alerts.empty())
+        std::fwrite(alerts.data(), sizeof(LogIndexAlert), alerts.size(), f);
+    for (const std::string &t : texts)
+    {
+        uint32_t len = (uint32_t)t.size();
+        std::fwrite(&len, sizeof(len), 1, f);
+        std::fwrite(t.data(), 1, t.size(), f);
+    }
+    bool ok = std::ferror(f) == 0;
+    return std::fclose(f) == 0 && ok;
+}
+
+// ---- LogIndex ----
+
+LogIndex::LogIndex() : chunk_table(nullptr), alert_table(nullptr)
+{
+    std::memset(&header, 0, sizeof(header));
+}
+
+bool LogIndex::open(const std::string &log_path, std::string &error)
+{
+    close();
+    std::string index_path = logIndexPath(log_path);
+    if (!log_file.open(log_path))
+    {
+        error = "cannot open " + log_path;
+        return false;
+    }
+    if (!index_file.open(index_path))
+    {
+        error = "cannot open " + index_path + " (use --build)";
+        return false;
+    }
+
+    const uint8_t *p = index_file.data();
+    size_t size = index_file.size();
+    if (size < sizeof(header))
+    {
+        error = index_path + ": truncated";
+        return false;
+    }
+    std::memcpy(&header, p, sizeof(header));
+    if (std::memcmp(header.magic, LOG_INDEX_MAGIC, sizeof(header.magic)) != 0 || header.version != LOG_INDEX_VERSION)
+    {
+        error = index_path + ": not a log index";
+        return false;
+    }
+    if (header.log_size != log_file.size())
+    {
+        error = index_path + ": log size changed, index is stale (use --build)";
+        return false;
+    }
+
+    uint64_t tables = sizeof(header) + (uint64_t)header.chunk_count * sizeof(LogIndexChunk) +
+                      (uint64_t)header.alert_count * sizeof(LogIndexAlert);
+    if (tables > size)
+    {
+        error = index_path + ": truncated";
+        return false;
+    }
+    chunk_table = (const LogIndexChunk *)(p + sizeof(header));
+    alert_table = (const LogIndexAlert *)(chunk_table + header.chunk_count);
+
+    const uint8_t *t = p + tables;
+    const uint8_t *end = p + size;
+    for (uint32_t i = 0; i < header.text_count; i++)
+    {
+        uint32_t len;
+        if (end - t < (ptrdiff_t)sizeof(len))
+            break;
+        std::memcpy(&len, t, sizeof(len));
+        t += sizeof(len);
+        if ((uint64_t)(end - t) < len)
+            break;
+        texts.emplace_back((const char *)t, len);
+        t += len;
+    }
+    if (texts.size() != header.text_count)
+    {
+        error = index_path + ": truncated";
+        return false;
+    }
+
+    for (uint32_t i = 0; i < header.chunk_count; i++)
+    {
+        const LogIndexChunk &c = chunk_table[i];
+        if (c.offset > log_file.size() || c.size > log_file.size() - c.offset || c.first_alert > header.alert_count)
+        {
+            error = index_path + ": chunk out of range";
+            return false;
+        }
+    }
+    for (uint32_t i = 0; i < header.alert_count; i++)
+    {
+        if (alert_table[i].text >= header.text_count || alert_table[i].chunk >= header.chunk_count)
+        {
+            error = index_path + ": bad alert entry";
+            return false;
+        }
+    }
+    return true;
+}
+
+void LogIndex::close()
+{
+    log_file.close();
+    index_file.close();
+    std::memset(&header, 0, sizeof(header));
+    chunk_table = nullptr;
+    alert_table = nullptr;
+    texts.clear();
+}
+
+const LogIndexHeader &LogIndex::getHeader() const
+{
+    return header;
+}
+
+const LogIndexChunk *LogIndex::chunks() const
+{
+    return chunk_table;
+}
+
+const LogIndexAlert *LogIndex::alerts() const
+{
+    return alert_table;
+}
+
+const std::string &LogIndex::getText(uint32_t text) const
+{
+    return texts[text];
+}
+
+void LogIndex::findChunks(double t0, double t1, size_t &first, size_t &last) const
+{
+    const LogIndexChunk *begin = chunk_table;
+    const LogIndexChunk *end = chunk_table + header.chunk_count;
+    // 块按时间顺序排列: 跳过结束早于 t0 的块, 停在开始晚于 t1 的块
+    const LogIndexChunk *lo =
+        std::partition_point(begin, end, [t0](const LogIndexChunk &c) { return c.last_time < t0; });
+    const LogIndexChunk *hi =
+        std::partition_point(lo, end, [t1](const LogIndexChunk &c) { return c.first_time <= t1; });
+    first = lo - begin;
+    last = hi - begin;
+}
+
+void LogIndex::findAlerts(const std::string &text, std::vector<LogIndexAlert> &out) const
+{
+    out.clear();
+    auto it = std::find(texts.begin(), texts.end(), text);
+    if (it == texts.end())
+        return;
+    uint32_t id = (uint32_t)(it - texts.begin());
+    for (uint32_t i = 0; i < header.alert_count; i++)
+    {
+        if (alert_table[i].text == id)
+            out.push_back(alert_table[i]);
+    }
+}
+
+bool LogIndex::readWindow(double t0, double t1, ColumnChunk &out) const
+{
+    size_t first, last;
+    findChunks(t0, t1, first, last);
+    for (size_t i = first; i < last; i++)
+    {
+        bool ok = header.log_format == (uint32_t)LogIndexFormat::COLUMNAR ? readColumnChunk(chunk_table[i], t0, t1, out)
+                                                                          : readCsvChunk(chunk_table[i], t0, t1, out);
+        if (!ok)
+            return false;
+    }
+    return true;
+}
+
+static void appendSample(ColumnChunk &out, double time, const double *values, uint16_t validity, uint8_t state)
+{
+    out.time.push_back(time);
+    for (int c = 0; c < COLUMN_LOG_CHANNELS; c++)
+        out.values[c].push_back(values[c]);
+    out.validity.push_back(validity);
+    out.state.push_back(state);
+    out.rows++;
+}
+
+bool LogIndex::readCsvChunk(const LogIndexChunk &c, double t0, double t1, ColumnChunk &out) const
+{
+    const char *p = (const char *)log_file.data() + c.offset;
+    const char *end = p + c.size;
+    while (p < end)
+    {
+        const char *nl = (const char *)std::memchr(p, '\n', end - p);
+        const char *line_end = nl ? nl + 1 : end;
+        const char *text_end = trimLineEnd(p, line_end);
+        if (text_end == p || *p == 'T')
+        {
+            p = line_end;
+            continue;
+        }
+
+        if (*p == 'A')
+        {
+            double time;
+            const char *text;
+            if (parseAlertLine(p, text_end, time, text) && time >= t0 && time <= t1)
+            {
+                ColumnAlert a;
+                a.row = out.rows;
+                a.time = time;
+                a.text.assign(text, text_end - text);
+                out.alerts.push_back(a);
+            }
+            p = line_end;
+            continue;
+        }
+
+        double values[7];
+        if (!LogReplayReader::parseCsvValues(p, text_end, values))
+            return false;
+        if (values[0] >= t0 && values[0] <= t1)
+        {
+            EngineSnapshot data = {};
+            data.rpm_1 = values[1];
+            data.rpm_2 = values[2];
+            data.egt1_temp = values[3];
+            data.egt2_temp = values[4];
+            data.fuel_v = values[5];
+            data.fuel_c = values[6];
+            appendSample(out, values[0], values + 1, LogReplayReader::inferValidity(data), RECORD_STATE_UNKNOWN);
+        }
+        p = line_end;
+    }
+    return true;
+}
+
+bool LogIndex::readColumnChunk(const LogIndexChunk &c, double t0, double t1, ColumnChunk &out) const
+{
+    if (log_file.size() < sizeof(ColumnLogHeader) || c.size < sizeof(ColumnChunkHeader))
+        return false;
+    ColumnLogHeader file_header;
+    ColumnChunkHeader chunk_header;
+    std::memcpy(&file_header, log_file.data(), sizeof(file_header));
+    std::memcpy(&chunk_header, log_file.data() + c.offset, sizeof(chunk_header));
+    if (chunk_header.payload_size != c.size - sizeof(chunk_header))
+        return false;
+
+    ColumnChunk chunk;
+    if (!ColumnLogReader::decodeChunk(file_header, chunk_header, log_file.data() + c.offset + sizeof(chunk_header),
+                                      chunk))
+        return false;
+
+    size_t next_alert = 0;
+    for (uint32_t i = 0; i <= chunk.rows; i++)
+    {
+        while (next_alert < chunk.alerts.size() && chunk.alerts[next_alert].row <= i)
+        {
+            ColumnAlert a = chunk.alerts[next_alert++];
+            if (a.time >= t0 && a.time <= t1)
+            {
+                a.row = out.rows;
+                out.alerts.push_back(a);
+            }
+        }
+        if (i == chunk.rows)
+            break;
+        if (chunk.time[i] < t0 || chunk.time[i] > t1)
+            continue;
+        double values[COLUMN_LOG_CHANNELS];
+        for (int k = 0; k < COLUMN_LOG_CHANNELS; k++)
+            values[k] = chunk.values[k][i];
+        appendSample(out, chunk.time[i], values, chunk.validity[i], chunk.state[i]);
+    }
+    return true;
+}
+
+// ---- 事后生成索引 ----
+
+static bool buildCsvIndex(const MappedFile &log, LogIndexWriter &index, uint32_t chunk_rows)
+{
+    const char *base = (const char *)log.data();
+    const char *p = base;
+    const char *end = base + log.size();
+    uint64_t chunk_offset = 0;
+    uint32_t rows = 0;
+    double first_time = 0.0, last_time = 0.0;
+    while (p < end)
+    {
+        const char *nl = (const char *)std::memchr(p, '\n', end - p);
+        const char *line_end = nl ? nl + 1 : end;
+        const char *text_end = trimLineEnd(p, line_end);
+        if (text_end == p || *p == 'T')
+        {
+            p = line_end;
+            continue;
+        }
+
+        if (*p == 'A')
+        {
+            double time;
+            const char *text;
+            if (parseAlertLine(p, text_end, time, text))
+                index.addAlert(p - base, (uint32_t)(line_end - p), time, rows, text, text_end - text);
+            p = line_end;
+            continue;
+        }
+
+        // 只需要时间列
+        double time;
+        std::from_chars_result res = std::from_chars(p, text_end, time);
+        if (res.ec == std::errc())
+        {
+            if (rows == chunk_rows)
+            {
+                index.addChunk(chunk_offset, (p - base) - chunk_offset, first_time, last_time, rows);
+                chunk_offset = p - base;
+                rows = 0;
+            }
+            if (rows == 0)
+                first_time = time;
+            last_time = time;
+            rows++;
+        }
+        p = line_end;
+    }
+    if (rows > 0 || chunk_offset < log.size())
+        index.addChunk(chunk_offset, log.size() - chunk_offset, first_time, last_time, rows);
+    return true;
+}
+
+static bool buildColumnIndex(const MappedFile &log, LogIndexWriter &index, std::string &error)
+{
+    ColumnLogHeader file_header;
+    std::memcpy(&file_header, log.data(), sizeof(file_header));
+    uint64_t offset = sizeof(file_header);
+    ColumnChunk chunk;
+    while (offset + sizeof(ColumnChunkHeader) <= log.size())
+    {
+        ColumnChunkHeader h;
+        std::memcpy(&h, log.data() + offset, sizeof(h));
+        uint64_t size = sizeof(h) + (uint64_t)h.payload_size;
+        if (std::memcmp(h.magic, COLUMN_CHUNK_MAGIC, sizeof(h.magic)) != 0 || size > log.size() - offset ||
+            !ColumnLogReader::decodeChunk(file_header, h, log.data() + offset + sizeof(h), chunk,
+                                          1u << (int)ColumnStream::ALERTS))
+        {
+            error = "bad chunk at offset " + std::to_string(offset);
+            return false;
+        }
+        for (const ColumnAlert &a : chunk.alerts)
+            index.addAlert(offset, 0, a.time, a.row, a.text.data(), a.text.size());
+        index.addChunk(offset, size, h.first_time, h.last_time, h.row_count);
+        offset += size;
+    }
+    return true;
+}
+
+bool LogIndex::build(const std::string &log_path, std::string &error, uint32_t chunk_rows)
+{
+    MappedFile log;
+    if (!log.open(log_path))
+    {
+        error = "cannot open " + log_path;
+        return false;
+    }
+    if (chunk_rows == 0)
+        chunk_rows = 4096;
+
+    bool columnar = log.size() >= sizeof(ColumnLogHeader) &&
+                    std::memcmp(log.data(), COLUMN_LOG_MAGIC, sizeof(COLUMN_LOG_MAGIC)) == 0;
+    bool binary = log.size() >= sizeof(BINARY_LOG_MAGIC) &&
+                  std::memcmp(log.data(), BINARY_LOG_MAGIC, sizeof(BINARY_LOG_MAGIC)) == 0;
+    if (binary)
+    {
+        error = log_path + ": binary logs are not indexed (convert with engine_bin2csv)";
+        return false;
+    }
+
+    LogIndexWriter index;
+    bool ok;
+    if (columnar)
+    {
+        ColumnLogHeader file_header;
+        std::memcpy(&file_header, log.data(), sizeof(file_header));
+        index.open(logIndexPath(log_path), LogIndexFormat::COLUMNAR, file_header.chunk_rows);
+        ok = buildColumnIndex(log, index, error);
+    }
+    else
+    {
+        index.open(logIndexPath(log_path), LogIndexFormat::CSV, chunk_rows);
+        ok = buildCsvIndex(log, index, chunk_rows);
+    }
+    if (!ok)
+        return false;
+    if (!index.close(log.size()))
+    {
+        error = "cannot write " + logIndexPath(log_path);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,128 @@
+#pragma once
+#include "ColumnLogger.h"
+#include "MappedFile.h"
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+// 日志旁路索引 (日志路径 + ".idx"): 把日志按固定行数分块, 记录每块的字节范围和时间范围, 以及每条报警的位置
+// 布局: 64 字节文件头 + 块表 + 报警表 + 报警文本表 (每条为 4 字节长度 + 文本), 小端存储
+// 支持 Logger 的 CSV 格式 (每 chunk_rows 个数值行一块) 和 ColumnLogger 的列式格式 (与压缩块一一对应)
+// 索引在日志关闭时写出; 已有的日志可用 LogIndex::build 事后生成
+
+const char LOG_INDEX_MAGIC[8] = {'E', 'N', 'G', 'L', 'O', 'G', 'X', '1'};
+const uint32_t LOG_INDEX_VERSION = 1;
+
+enum class LogIndexFormat : uint32_t
+{
+    CSV = 0,
+    COLUMNAR = 1,
+};
+
+struct LogIndexHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t log_format; // LogIndexFormat
+    uint32_t chunk_rows;
+    uint32_t chunk_count;
+    uint32_t alert_count;
+    uint32_t text_count;
+    uint64_t log_size; // 建立索引时的日志字节数, 与实际大小不符说明索引已过期
+    double first_time;
+    double last_time;
+    uint8_t reserved[8];
+};
+
+struct LogIndexChunk
+{
+    uint64_t offset; // 块在日志中的起始字节
+    uint64_t size;
+    double first_time; // 块内数值行的时间范围 (没有数值行时为报警时间)
+    double last_time;
+    uint32_t rows;
+    uint32_t first_alert; // 块内第一条报警在报警表中的下标
+};
+
+struct LogIndexAlert
+{
+    uint64_t offset; // CSV: 报警行的起始字节; 列式: 所在块的起始字节
+    double time;
+    uint32_t chunk;
+    uint32_t text;   // 报警文本表中的下标
+    uint32_t row;    // 位于块内第 row 个数值行之前
+    uint32_t length; // CSV: 报警行字节数 (含换行); 列式: 0
+};
+
+static_assert(sizeof(LogIndexHeader) == 64, "LogIndexHeader must be 64 bytes");
+static_assert(sizeof(LogIndexChunk) == 40, "LogIndexChunk must be 40 bytes");
+static_assert(sizeof(LogIndexAlert) == 32, "LogIndexAlert must be 32 bytes");
+
+std::string logIndexPath(const std::string &log_path);
+
+// 写日志的同时记录块与报警, close 时写出索引文件
+// 报警归入下一次 addChunk 的块, 因此应先记录块内的报警再记录块
+class LogIndexWriter
+{
+public:
+    LogIndexWriter();
+
+    void open(const std::string &index_path, LogIndexFormat format, uint32_t chunk_rows);
+    bool isOpen() const;
+
+    void addChunk(uint64_t offset, uint64_t size, double first_time, double last_time, uint32_t rows);
+    void addAlert(uint64_t offset, uint32_t length, double time, uint32_t row, const char *text, size_t len);
+
+    // log_size 为日志最终的字节数
+    bool close(uint64_t log_size);
+
+private:
+    std::string path;
+    LogIndexHeader header;
+    std::vector<LogIndexChunk> chunks;
+    std::vector<LogIndexAlert> alerts;
+    std::vector<std::string> texts;
+    std::map<std::string, uint32_t> text_ids;
+    bool opened;
+};
+
+// 通过内存映射查询索引过的日志
+class LogIndex
+{
+public:
+    LogIndex();
+
+    // 映射日志及其索引; 索引不存在、损坏或与日志大小不符时返回 false 并给出原因
+    bool open(const std::string &log_path, std::string &error);
+    void close();
+
+    const LogIndexHeader &getHeader() const;
+    const LogIndexChunk *chunks() const;
+    const LogIndexAlert *alerts() const;
+    const std::string &getText(uint32_t text) const;
+
+    // 与时间窗 [t0, t1] 相交的块 [first, last)
+    void findChunks(double t0, double t1, size_t &first, size_t &last) const;
+
+    // 文本为 text 的全部报警 (按时间顺序)
+    void findAlerts(const std::string &text, std::vector<LogIndexAlert> &out) const;
+
+    // 解码时间窗 [t0, t1] 内的数值行和报警, 追加到 out (报警的 row 相对 out 的行号);
+    // CSV 的有效位按标志值推断, 状态记为未知
+    bool readWindow(double t0, double t1, ColumnChunk &out) const;
+
+    // 为已有的日志生成索引, CSV 每 chunk_rows 个数值行一块
+    static bool build(const std::string &log_path, std::string &error, uint32_t chunk_rows = 4096);
+
+private:
+    bool readCsvChunk(const LogIndexChunk &c, double t0, double t1, ColumnChunk &out) const;
+    bool readColumnChunk(const LogIndexChunk &c, double t0, double t1, ColumnChunk &out) const;
+
+    MappedFile log_file;
+    MappedFile index_file;
+    LogIndexHeader header;
+    const LogIndexChunk *chunk_table;
+    const LogIndexAlert *alert_table;
+    std::vector<std::string> texts;
+};
@@ -0,0 +1,389 @@
+#include "LogReplay.h"
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <thread>
+
+LogReplayReader::LogReplayReader(size_t buffer_size)
+    : file(nullptr), binary(false), columnar(false), chunk_pos(0), data_begin(0), data_end(0), eof(false), bytes_read(0), bad_lines(0),
+      record_pos(0), record_count(0), inferred_state(EngineState::OFF), last_rpm(0.0)
+{
+    buffer.resize(buffer_size);
+    chunk.rows = 0;
+}
+
+LogReplayReader::~LogReplayReader()
+{
+    close();
+}
+
+bool LogReplayReader::open(const std::string &path)
+{
+    close();
+
+    std::FILE *probe = std::fopen(path.c_str(), "rb");
+    if (!probe)
+        return false;
+    char magic[sizeof(BINARY_LOG_MAGIC)] = {};
+    size_t n = std::fread(magic, 1, sizeof(magic), probe);
+    binary = (n == sizeof(magic) && std::memcmp(magic, BINARY_LOG_MAGIC, sizeof(magic)) == 0);
+    columnar = (n == sizeof(magic) && std::memcmp(magic, COLUMN_LOG_MAGIC, sizeof(magic)) == 0);
+
+    if (binary)
+    {
+        std::fclose(probe);
+        records.resize(1024);
+        return binary_reader.open(path);
+    }
+    if (columnar)
+    {
+        std::fclose(probe);
+        return column_reader.open(path);
+    }
+
+    std::rewind(probe);
+    file = probe;
+    return true;
+}
+
+void LogReplayReader::close()
+{
+    if (file)
+    {
+        std::fclose(file);
+        file = nullptr;
+    }
+    binary_reader.close();
+    column_reader.close();
+    chunk.rows = 0;
+    chunk_pos = 0;
+    data_begin = data_end = 0;
+    eof = false;
+    bytes_read = 0;
+    bad_lines = 0;
+    record_pos = record_count = 0;
+    inferred_state = EngineState::OFF;
+    last_rpm = 0.0;
+}
+
+bool LogReplayReader::isBinary() const
+{
+    return binary;
+}
+
+bool LogReplayReader::isColumnar() const
+{
+    return columnar;
+}
+
+uint64_t LogReplayReader::getBytesRead() const
+{
+    return bytes_read;
+}
+
+uint64_t LogReplayReader::getBadLines() const
+{
+    return bad_lines;
+}
+
+bool LogReplayReader::next(ReplayFrame &frame)
+{
+    if (columnar)
+        return nextColumnar(frame);
+    return binary ? nextBinary(frame) : nextCsv(frame);
+}
+
+bool LogReplayReader::nextColumnar(ReplayFrame &frame)
+{
+    // 回放不需要报警列
+    const uint32_t select = COLUMN_SELECT_ALL & ~(1u << (int)ColumnStream::ALERTS);
+    while (chunk_pos == chunk.rows)
+    {
+        if (!column_reader.readChunk(chunk, select))
+            return false;
+        chunk_pos = 0;
+    }
+
+    uint32_t i = chunk_pos++;
+    frame.time = chunk.time[i];
+    EngineSnapshot &d = frame.data;
+    d.rpm_1 = chunk.values[0][i];
+    d.rpm_2 = chunk.values[1][i];
+    d.egt1_temp = chunk.values[2][i];
+    d.egt2_temp = chunk.values[3][i];
+    d.fuel_v = chunk.values[4][i];
+    d.fuel_c = chunk.values[5][i];
+    unpackSensorValidity(chunk.validity[i], d);
+    if (chunk.state[i] == RECORD_STATE_UNKNOWN)
+        inferState(frame);
+    else
+        frame.state = (EngineState)chunk.state[i];
+    return true;
+}
+
+bool LogReplayReader::nextBinary(ReplayFrame &frame)
+{
+    while (true)
+    {
+        if (record_pos == record_count)
+        {
+            record_count = binary_reader.read(records.data(), records.size());
+            record_pos = 0;
+            bytes_read += record_count * sizeof(TelemetryRecord);
+            if (record_count == 0)
+                return false;
+        }
+
+        const TelemetryRecord &rec = records[record_pos++];
+        if (rec.kind != (uint8_t)RecordKind::SAMPLE)
+            continue;
+
+        frame.time = rec.time;
+        recordToSnapshot(rec, frame.data);
+        if (rec.state == RECORD_STATE_UNKNOWN)
+            inferState(frame);
+        else
+            frame.state = (EngineState)rec.state;
+        return true;
+    }
+}
+
+bool LogReplayReader::fillBuffer()
+{
+    if (eof)
+        return false;
+
+    // 将未处理完的半行移到缓冲区开头
+    size_t remaining = data_end - data_begin;
+    if (remaining > 0 && data_begin > 0)
+        std::memmove(buffer.data(), buffer.data() + data_begin, remaining);
+    data_begin = 0;
+    data_end = remaining;
+
+    if (data_end == buffer.size())
+    {
+        // 单行超过缓冲区大小, 丢弃该行
+        data_end = 0;
+        bad_lines++;
+    }
+
+    size_t n = std::fread(buffer.data() + data_end, 1, buffer.size() - data_end, file);
+    bytes_read += n;
+    data_end += n;
+    if (n == 0)
+        eof = true;
+    return n > 0;
+}
+
+bool LogReplayReader::nextCsv(ReplayFrame &frame)
+{
+    if (!file)
+        return false;
+
+    while (true)
+    {
+        const char *base = buffer.data();
+        const char *begin = base + data_begin;
+        const char *end = base + data_end;
+        const char *nl = (const char *)std::memchr(begin, '\n', end - begin);
+
+        if (!nl)
+        {
+            if (fillBuffer())
+                continue;
+            // 文件末尾没有换行的最后一行
+            if (data_begin == data_end)
+                return false;
+            nl = base + data_end;
+        }
+
+        const char *line_end = nl;
+        if (line_end > begin && line_end[-1] == '\r')
+            line_end--;
+        data_begin = (nl - base) + ((nl < base + data_end) ? 1 : 0);
+
+        if (line_end == begin || *begin == 'T' || *begin == 'A')
+            continue; // 空行, 表头和 ALERT 行
+
+        if (parseCsvLine(begin, line_end, frame))
+            return true;
+        bad_lines++;
+    }
+}
+
+bool LogReplayReader::parseCsvValues(const char *begin, const char *end, double *values)
+{
+    const char *p = begin;
+    for (int i = 0; i < 7; i++)
+    {
+        std::from_chars_result res = std::from_chars(p, end, values[i]);
+        if (res.ec != std::errc())
+            return false;
+        p = res.ptr;
+        if (i < 6)
+        {
+            if (p == end || *p != ',')
+                return false;
+            p++;
+        }
+    }
+    return true;
+}
+
+bool LogReplayReader::parseCsvLine(const char *begin, const char *end, ReplayFrame &frame)
+{
+    double values[7];
+    if (!parseCsvValues(begin, end, values))
+        return false;
+
+    frame.time = values[0];
+    EngineSnapshot &d = frame.data;
+    d.rpm_1 = values[1];
+    d.rpm_2 = values[2];
+    d.egt1_temp = values[3];
+    d.egt2_temp = values[4];
+    d.fuel_v = values[5];
+    d.fuel_c = values[6];
+
+    unpackSensorValidity(inferValidity(d), d);
+
+    inferState(frame);
+    return true;
+}
+
+uint16_t LogReplayReader::inferValidity(const EngineSnapshot &d)
+{
+    unsigned short valid = SENSOR_VALID_ALL;
+    if (d.rpm_1 == -1.0)
+        valid &= ~(3 << SENSOR_VALID_N_SHIFT);
+    if (d.egt1_temp == -500.0 && d.egt2_temp == -500.0)
+        valid &= ~(0xF << SENSOR_VALID_EGT_SHIFT);
+    else if (d.egt1_temp == -50.0)
+        valid &= ~(3 << SENSOR_VALID_EGT_SHIFT);
+    if (d.fuel_c == 0.0 && std::signbit(d.fuel_c))
+        valid &= ~SENSOR_VALID_FUEL;
+    return valid;
+}
+
+void LogReplayReader::inferState(ReplayFrame &frame)
+{
+    // 转速传感器失效时用另一路转速
+    double rpm = (frame.data.rpm_1 >= 0.0) ? frame.data.rpm_1 : frame.data.rpm_2;
+
+    switch (inferred_state)
+    {
+    case EngineState::OFF:
+        if (rpm > 0.0)
+            inferred_state = EngineState::STARTING;
+        break;
+    case EngineState::STARTING:
+        if (rpm >= 40000 * 0.95)
+            inferred_state = EngineState::RUNNING;
+        else if (rpm < last_rpm && frame.data.fuel_v == 0.0)
+            inferred_state = EngineState::STOPPING;
+        break;
+    case EngineState::RUNNING:
+        // 停车阶段燃油流量被置零
+        if (frame.data.fuel_v == 0.0)
+            inferred_state = EngineState::STOPPING;
+        break;
+    case EngineState::STOPPING:
+        if (rpm == 0.0)
+            inferred_state = EngineState::OFF;
+        else if (rpm > last_rpm)
+            inferred_state = EngineState::STARTING;
+        break;
+    default:
+        break;
+    }
+
+    last_rpm = rpm;
+    frame.state = inferred_state;
+}
+
+LogReplay::LogReplay() : rules(nullptr) {}
+
+void LogReplay::setRules(const EICASRuleProgram *value)
+{
+    rules = value;
+}
+
+void LogReplay::emitChanges(uint32_t before, uint32_t after, double time, std::FILE *timeline,
+                            ReplayResult &result)
+{
+    uint32_t raised = after & ~before;
+    uint32_t cleared = before & ~after;
+    result.alerts_raised += countErrorBits(raised);
+    result.alerts_cleared += countErrorBits(cleared);
+
+    if (!timeline)
+        return;
+
+    for (int i = 1; i < ERROR_TYPE_COUNT; i++)
+    {
+        ErrorType err = (ErrorType)i;
+        if (raised & errorBit(err))
+            std::fprintf(timeline, "%.3f,RAISE,%s,%s\n", time, EICAS::getErrorName(err), EICAS::getErrorMessage(err));
+        if (cleared & errorBit(err))
+            std::fprintf(timeline, "%.3f,CLEAR,%s,%s\n", time, EICAS::getErrorName(err), EICAS::getErrorMessage(err));
+    }
+}
+
+bool LogReplay::run(const std::string &path, const ReplayOptions &options, std::FILE *timeline,
+                    ReplayResult &result)
+{
+    LogReplayReader reader;
+    if (!reader.open(path))
+        return false;
+
+    eicas = EICAS();
+    eicas.setRules(rules);
+    result = ReplayResult();
+
+    int judge_every = (options.judge_every < 1) ? 1 : options.judge_every;
+    bool throttled = options.speed > 0.0;
+
+    if (timeline)
+        std::fprintf(timeline, "Time(s),Event,Alert,Message\n");
+
+    ReplayFrame frame;
+    uint32_t shown = 0;
+    auto wall_start = std::chrono::steady_clock::now();
+
+    while (reader.next(frame))
+    {
+        if (result.frames == 0)
+            result.first_time = frame.time;
+        result.last_time = frame.time;
+        result.frames++;
+
+        if (throttled)
+        {
+            // 按日志时间换算墙钟时间, 超前 1ms 以上才休眠
+            double wall_target = (frame.time - result.first_time) / options.speed;
+            auto target = wall_start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                           std::chrono::duration<double>(wall_target));
+            if (target - std::chrono::steady_clock::now() > std::chrono::milliseconds(1))
+                std::this_thread::sleep_until(target);
+        }
+
+        // 不判断的帧也采样越限, 两次判断之间的单步尖峰在下一次判断时告警
+        if (result.frames % judge_every != 0)
+        {
+            eicas.sample(frame.data, frame.state);
+            continue;
+        }
+
+        uint32_t now_shown = eicas.judgeMask(frame.data, frame.state, frame.time);
+        result.judge_calls++;
+        if (now_shown != shown)
+        {
+            emitChanges(shown, now_shown, frame.time, timeline, result);
+            shown = now_shown;
+        }
+    }
+
+    result.wall_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall_start).count();
+    return true;
+}
@@ -0,0 +1,112 @@
+#pragma once
+#include "BinaryLogger.h"
+#include "ColumnLogger.h"
+#include "DataStructrue.h"
+#include "EICAS.h"
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// 从日志中恢复出的一帧
+struct ReplayFrame
+{
+    double time;
+    EngineSnapshot data;
+    EngineState state;
+};
+
+// 流式日志读取: 支持 Logger 的 CSV 格式、BinaryLogger 的二进制格式和 ColumnLogger 的列式格式 (按文件头自动识别)
+// CSV 在固定大小的缓冲区内就地解析, 内存占用与文件大小无关
+// CSV 不含发动机状态和传感器有效位, 由数值推断: 状态按转速/燃油流量的变化推断,
+// 有效位按故障注入写入的标志值 (转速 -1, 温度 -50/-500, 燃油余量 -0.0) 推断
+class LogReplayReader
+{
+public:
+    explicit LogReplayReader(size_t buffer_size = 1 << 20);
+    ~LogReplayReader();
+
+    bool open(const std::string &path);
+    void close();
+
+    // 读取下一帧数值数据 (跳过表头和 ALERT 行), 文件结束返回 false
+    bool next(ReplayFrame &frame);
+
+    bool isBinary() const;
+    bool isColumnar() const;
+    uint64_t getBytesRead() const;
+    uint64_t getBadLines() const;
+
+    // 由故障注入写入的标志值推断传感器有效位 (CSV 中没有有效位)
+    static uint16_t inferValidity(const EngineSnapshot &data);
+
+    // 解析 CSV 数值行的 7 列 (时间与 6 个通道), 格式不符返回 false
+    static bool parseCsvValues(const char *begin, const char *end, double *values);
+
+private:
+    bool nextCsv(ReplayFrame &frame);
+    bool nextBinary(ReplayFrame &frame);
+    bool nextColumnar(ReplayFrame &frame);
+    bool fillBuffer();
+    bool parseCsvLine(const char *begin, const char *end, ReplayFrame &frame);
+    void inferState(ReplayFrame &frame);
+
+    std::FILE *file;
+    bool binary;
+    BinaryLogReader binary_reader;
+    bool columnar;
+    ColumnLogReader column_reader;
+    ColumnChunk chunk;
+    uint32_t chunk_pos;
+
+    std::vector<char> buffer;
+    size_t data_begin;
+    size_t data_end;
+    bool eof;
+    uint64_t bytes_read;
+    uint64_t bad_lines;
+
+    std::vector<TelemetryRecord> records;
+    size_t record_pos;
+    size_t record_count;
+
+    EngineState inferred_state;
+    double last_rpm;
+};
+
+struct ReplayOptions
+{
+    double speed;    // 回放倍速, <= 0 表示不限速
+    int judge_every; // 每隔多少帧调用一次 EICAS::judge
+};
+
+struct ReplayResult
+{
+    uint64_t frames;
+    uint64_t judge_calls;
+    uint64_t alerts_raised;
+    uint64_t alerts_cleared;
+    double first_time;
+    double last_time;
+    double wall_seconds;
+};
+
+// 回放引擎: 将日志逐帧送入 EICAS, 输出告警时间线
+// 告警结果只取决于日志内容, 与回放速度无关
+class LogReplay
+{
+public:
+    LogReplay();
+
+    // 替换告警门限 (为空时使用内置门限), 每次 run 都沿用; rules 须在本对象使用期间有效
+    void setRules(const EICASRuleProgram *rules);
+
+    // timeline 为空时不输出时间线; 每行格式: Time(s),Event,Alert,Message
+    bool run(const std::string &path, const ReplayOptions &options, std::FILE *timeline, ReplayResult &result);
+
+private:
+    void emitChanges(uint32_t before, uint32_t after, double time, std::FILE *timeline, ReplayResult &result);
+
+    EICAS eicas;
+    const EICASRuleProgram *rules;
+};
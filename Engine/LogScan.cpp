@@ -0,0 +1,706 @@
+#include "LogScan.h"
+#include "BinaryLog.h"
+#include "ColumnLogger.h"
+#include "EICASBatch.h"
+#include "MappedFile.h"
+#include "TaskScheduler.h"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <memory>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define LOG_SCAN_X86 1
+#include <immintrin.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define LOG_SCAN_TARGET_AVX2 __attribute__((target("avx2,popcnt")))
+#else
+#define LOG_SCAN_TARGET_AVX2
+#endif
+
+static const char *const CHANNEL_NAMES[COLUMN_LOG_CHANNELS] = {"N1", "N2", "EGT1", "EGT2", "FUEL_FLOW", "FUEL_QTY"};
+
+const char *logChannelName(int channel)
+{
+    return (channel >= 0 && channel < COLUMN_LOG_CHANNELS) ? CHANNEL_NAMES[channel] : "?";
+}
+
+bool parseLogChannel(const char *name, int &channel)
+{
+    for (int c = 0; c < COLUMN_LOG_CHANNELS; c++)
+    {
+        if (std::strcmp(name, CHANNEL_NAMES[c]) == 0)
+        {
+            channel = c;
+            return true;
+        }
+    }
+    return false;
+}
+
+// ---- 数值解析 ----
+
+static const double POW10[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15};
+
+// 解析 [-]整数[.小数]; 总位数不超过 15 时 "整数 / 10^小数位" 是两个精确值相除, 与 from_chars 的正确舍入结果相同,
+// 其他形式 (指数、inf、过长) 交给 from_chars. 失败返回空指针
+static inline const char *parseNumber(const char *p, const char *end, double &value)
+{
+    const char *start = p;
+    bool negative = p < end && *p == '-';
+    p += negative;
+    uint64_t mantissa = 0;
+    const char *digits = p;
+    while (p < end && (unsigned)(*p - '0') < 10)
+        mantissa = mantissa * 10 + (uint64_t)(*p++ - '0');
+    ptrdiff_t int_digits = p - digits;
+    ptrdiff_t decimals = 0;
+    if (p < end && *p == '.')
+    {
+        const char *frac = ++p;
+        while (p < end && (unsigned)(*p - '0') < 10)
+            mantissa = mantissa * 10 + (uint64_t)(*p++ - '0');
+        decimals = p - frac;
+    }
+    if (int_digits + decimals == 0 || int_digits + decimals > 15 || (p < end && (*p == 'e' || *p == 'E')))
+    {
+        std::from_chars_result res = std::from_chars(start, end, value);
+        return res.ec == std::errc() ? res.ptr : nullptr;
+    }
+    value = (double)mantissa / POW10[decimals];
+    if (negative)
+        value = -value;
+    return p;
+}
+
+// 数值行的快速路径: 只接受位数不超过 15 的定点数, 字段以 ',' 分隔、以换行结束.
+// 调用方保证该行以换行结束, 数字循环遇到非数字字符即停, 因此不逐字符检查边界
+static inline const char *parseFixedFast(const char *p, double &value)
+{
+    bool negative = *p == '-';
+    p += negative;
+    const char *digits = p;
+    uint64_t mantissa = 0;
+    while ((unsigned)(*p - '0') < 10)
+        mantissa = mantissa * 10 + (uint64_t)(*p++ - '0');
+    ptrdiff_t int_digits = p - digits;
+    ptrdiff_t decimals = 0;
+    if (*p == '.')
+    {
+        const char *frac = ++p;
+        while ((unsigned)(*p - '0') < 10)
+            mantissa = mantissa * 10 + (uint64_t)(*p++ - '0');
+        decimals = p - frac;
+    }
+    if (int_digits + decimals == 0 || int_digits + decimals > 15)
+        return nullptr;
+    value = (double)mantissa / POW10[decimals];
+    if (negative)
+        value = -value;
+    return p;
+}
+
+// 成功返回下一行开头, 格式不符返回空指针 (由检查边界的慢速路径重新解析)
+static inline const char *parseRowFast(const char *p, double *values)
+{
+    for (int i = 0; i < 7; i++)
+    {
+        p = parseFixedFast(p, values[i]);
+        if (!p)
+            return nullptr;
+        if (i < 6)
+        {
+            if (*p != ',')
+                return nullptr;
+        }
+        else
+        {
+            p += *p == '\r';
+            if (*p != '\n')
+                return nullptr;
+        }
+        p++;
+    }
+    return p;
+}
+
+// ---- 按块归约 ----
+
+static const uint32_t BLOCK_ROWS = 1024;
+
+// CSV 解析出的一块数据, 按列存放以便向量化归约
+struct ScanBlock
+{
+    uint32_t count;
+    double time[BLOCK_ROWS];
+    double values[COLUMN_LOG_CHANNELS][BLOCK_ROWS];
+};
+
+// 有效值: 符号位为 0 且不是 NaN (燃油余量失效标志为 -0.0)
+static inline bool validValue(double v)
+{
+    return !std::signbit(v) && v == v;
+}
+
+static void reduceChannelScalar(const double *v, uint32_t n, ChannelSummary &s)
+{
+    for (uint32_t i = 0; i < n; i++)
+    {
+        if (!validValue(v[i]))
+            continue;
+        s.min = std::min(s.min, v[i]);
+        s.max = std::max(s.max, v[i]);
+        s.sum += v[i];
+        s.count++;
+    }
+}
+
+// 行 1..n-1 中高于门限的行数和时间间隔之和 (第 0 行的间隔依赖上一块, 由调用方处理)
+static void exceedScalar(const double *time, const double *v, uint32_t n, double threshold, ExceedSummary &e)
+{
+    for (uint32_t i = 1; i < n; i++)
+    {
+        if (v[i] > threshold)
+        {
+            e.seconds += time[i] - time[i - 1];
+            e.rows++;
+        }
+    }
+}
+
+#ifdef LOG_SCAN_X86
+
+LOG_SCAN_TARGET_AVX2 static double horizontalSum(__m256d v)
+{
+    __m128d s = _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+    return _mm_cvtsd_f64(_mm_add_sd(s, _mm_unpackhi_pd(s, s)));
+}
+
+LOG_SCAN_TARGET_AVX2 static void reduceChannelAvx2(const double *v, uint32_t n, ChannelSummary &s)
+{
+    const __m256d inf = _mm256_set1_pd(std::numeric_limits<double>::infinity());
+    const __m256d neg_inf = _mm256_set1_pd(-std::numeric_limits<double>::infinity());
+    const __m256i zero = _mm256_setzero_si256();
+    __m256d vmin = inf, vmax = neg_inf, vsum = _mm256_setzero_pd();
+    uint64_t count = 0;
+    uint32_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        __m256d x = _mm256_loadu_pd(v + i);
+        // 符号位为 1 (负数和 -0.0) 或 NaN 的通道无效
+        __m256d negative = _mm256_castsi256_pd(_mm256_cmpgt_epi64(zero, _mm256_castpd_si256(x)));
+        __m256d valid = _mm256_andnot_pd(negative, _mm256_cmp_pd(x, x, _CMP_ORD_Q));
+        vmin = _mm256_min_pd(vmin, _mm256_blendv_pd(inf, x, valid));
+        vmax = _mm256_max_pd(vmax, _mm256_blendv_pd(neg_inf, x, valid));
+        vsum = _mm256_add_pd(vsum, _mm256_and_pd(x, valid));
+        count += (uint64_t)_mm_popcnt_u32((unsigned)_mm256_movemask_pd(valid));
+    }
+    double lanes[4];
+    _mm256_storeu_pd(lanes, vmin);
+    for (double x : lanes)
+        s.min = std::min(s.min, x);
+    _mm256_storeu_pd(lanes, vmax);
+    for (double x : lanes)
+        s.max = std::max(s.max, x);
+    s.sum += horizontalSum(vsum);
+    s.count += count;
+    reduceChannelScalar(v + i, n - i, s);
+}
+
+LOG_SCAN_TARGET_AVX2 static void exceedAvx2(const double *time, const double *v, uint32_t n, double threshold,
+                                            ExceedSummary &e)
+{
+    const __m256d limit = _mm256_set1_pd(threshold);
+    __m256d seconds = _mm256_setzero_pd();
+    uint64_t rows = 0;
+    uint32_t i = 1;
+    for (; i + 4 <= n; i += 4)
+    {
+        __m256d above = _mm256_cmp_pd(_mm256_loadu_pd(v + i), limit, _CMP_GT_OQ);
+        __m256d dt = _mm256_sub_pd(_mm256_loadu_pd(time + i), _mm256_loadu_pd(time + i - 1));
+        seconds = _mm256_add_pd(seconds, _mm256_and_pd(dt, above));
+        rows += (uint64_t)_mm_popcnt_u32((unsigned)_mm256_movemask_pd(above));
+    }
+    e.seconds += horizontalSum(seconds);
+    e.rows += rows;
+    // 剩余的行, 从 i - 1 开始使 exceedScalar 的第 0 行对齐到已处理的最后一行
+    exceedScalar(time + i - 1, v + i - 1, n - i + 1, threshold, e);
+}
+
+static void reduceChannel(const double *v, uint32_t n, ChannelSummary &s)
+{
+    if (judgeBatchUsesAvx2())
+        reduceChannelAvx2(v, n, s);
+    else
+        reduceChannelScalar(v, n, s);
+}
+
+static void exceed(const double *time, const double *v, uint32_t n, double threshold, ExceedSummary &e)
+{
+    if (n < 2)
+        return;
+    if (judgeBatchUsesAvx2())
+        exceedAvx2(time, v, n, threshold, e);
+    else
+        exceedScalar(time, v, n, threshold, e);
+}
+
+#else
+
+static void reduceChannel(const double *v, uint32_t n, ChannelSummary &s)
+{
+    reduceChannelScalar(v, n, s);
+}
+
+static void exceed(const double *time, const double *v, uint32_t n, double threshold, ExceedSummary &e)
+{
+    exceedScalar(time, v, n, threshold, e);
+}
+
+#endif
+
+// 转速传感器失效 (-1) 时用另一路, 两路都失效时为 NaN, 不参与启动判断
+static inline double effectiveRpm(double rpm_1, double rpm_2)
+{
+    if (rpm_1 >= 0.0)
+        return rpm_1;
+    return rpm_2 >= 0.0 ? rpm_2 : std::numeric_limits<double>::quiet_NaN();
+}
+
+// 把连续的 n 行归约到分段结果 r
+static void reduceRows(const double *time, const double *const *values, uint32_t n, const LogScanOptions &options,
+                       LogScanResult &r)
+{
+    if (n == 0)
+        return;
+    bool first_rows = r.rows == 0;
+    for (int c = 0; c < COLUMN_LOG_CHANNELS; c++)
+        reduceChannel(values[c], n, r.channels[c]);
+
+    for (size_t k = 0; k < options.exceed.size(); k++)
+    {
+        const ExceedQuery &q = options.exceed[k];
+        const double *v = values[q.channel];
+        ExceedSummary &e = r.exceed[k];
+        if (v[0] > q.threshold)
+        {
+            e.rows++;
+            if (first_rows)
+                r.first_above[k] = 1;
+            else
+                e.seconds += time[0] - r.last_time;
+        }
+        exceed(time, v, n, q.threshold, e);
+    }
+
+    // 启动循环: 转速由 0 变为正数; 段首行的上一行在其他分段, 合并时再判断
+    double prev_rpm = first_rows ? std::numeric_limits<double>::quiet_NaN() : r.last_rpm;
+    double *max_egt = r.cycles.empty() ? &r.lead_max_egt : &r.cycles.back().max_egt;
+    for (uint32_t i = 0; i < n; i++)
+    {
+        double rpm = effectiveRpm(values[0][i], values[1][i]);
+        if (prev_rpm == 0.0 && rpm > 0.0)
+        {
+            StartCycle cycle;
+            cycle.start_time = time[i];
+            cycle.max_egt = -std::numeric_limits<double>::infinity();
+            r.cycles.push_back(cycle);
+            max_egt = &r.cycles.back().max_egt;
+        }
+        *max_egt = std::max(*max_egt, std::max(values[2][i], values[3][i]));
+        prev_rpm = rpm;
+    }
+
+    if (first_rows)
+    {
+        r.first_time = time[0];
+        r.first_rpm = effectiveRpm(values[0][0], values[1][0]);
+    }
+    r.last_time = time[n - 1];
+    r.last_rpm = prev_rpm;
+    r.rows += n;
+}
+
+static void flushBlock(ScanBlock &block, const LogScanOptions &options, LogScanResult &r)
+{
+    const double *values[COLUMN_LOG_CHANNELS];
+    for (int c = 0; c < COLUMN_LOG_CHANNELS; c++)
+        values[c] = block.values[c];
+    reduceRows(block.time, values, block.count, options, r);
+    block.count = 0;
+}
+
+// ---- 分段扫描 ----
+
+// CSV 的 [begin, end) 段, 起止都在行首
+static void scanCsvSegment(const char *begin, const char *end, const LogScanOptions &options, LogScanResult &r)
+{
+    std::unique_ptr<ScanBlock> block(new ScanBlock);
+    block->count = 0;
+
+    // 快速路径只用于以换行结束的行; 文件末尾没有换行的最后一行走慢速路径
+    const char *safe_end = end;
+    while (safe_end > begin && safe_end[-1] != '\n')
+        safe_end--;
+
+    const char *p = begin;
+    while (p < end)
+    {
+        if (p < safe_end && (*p == '-' || (unsigned)(*p - '0') < 10))
+        {
+            double values[7];
+            const char *next = parseRowFast(p, values);
+            if (next)
+            {
+                uint32_t row = block->count;
+                block->time[row] = values[0];
+                for (int c = 0; c < COLUMN_LOG_CHANNELS; c++)
+                    block->values[c][row] = values[1 + c];
+                if (++block->count == BLOCK_ROWS)
+                    flushBlock(*block, options, r);
+                p = next;
+                continue;
+            }
+        }
+
+        const char *nl = (const char *)std::memchr(p, '\n', end - p);
+        const char *line_end = nl ? nl : end;
+        const char *text_end = (line_end > p && line_end[-1] == '\r') ? line_end - 1 : line_end;
+        const char *next = nl ? nl + 1 : end;
+
+        if (text_end == p || *p == 'T')
+        {
+            p = next;
+            continue;
+        }
+        if (*p == 'A')
+        {
+            // ALERT,<时间>,MESSAGE:,<文本>
+            const char *text = p;
+            for (int field = 0; field < 3 && text; field++)
+            {
+                text = (const char *)std::memchr(text, ',', text_end - text);
+                if (text)
+                    text++;
+            }
+            if (text)
+                r.alerts[std::string(text, text_end)]++;
+            else
+                r.bad_lines++;
+            p = next;
+            continue;
+        }
+
+        uint32_t row = block->count;
+        const char *q = parseNumber(p, text_end, block->time[row]);
+        for (int c = 0; c < COLUMN_LOG_CHANNELS && q; c++)
+            q = (q < text_end && *q == ',') ? parseNumber(q + 1, text_end, block->values[c][row]) : nullptr;
+        if (!q || q != text_end)
+        {
+            r.bad_lines++;
+            p = next;
+            continue;
+        }
+        if (++block->count == BLOCK_ROWS)
+            flushBlock(*block, options, r);
+        p = next;
+    }
+    flushBlock(*block, options, r);
+}
+
+// 列式日志的连续若干块
+static bool scanColumnSegment(const MappedFile &file, const std::vector<uint64_t> &offsets, size_t first,
+                              size_t last, const LogScanOptions &options, LogScanResult &r)
+{
+    ColumnLogHeader file_header;
+    std::memcpy(&file_header, file.data(), sizeof(file_header));
+    ColumnChunk chunk;
+    const uint32_t select = COLUMN_SELECT_ALL & ~(1u << (int)ColumnStream::FLAGS);
+    for (size_t k = first; k < last; k++)
+    {
+        ColumnChunkHeader h;
+        std::memcpy(&h, file.data() + offsets[k], sizeof(h));
+        if (!ColumnLogReader::decodeChunk(file_header, h, file.data() + offsets[k] + sizeof(h), chunk, select))
+            return false;
+        const double *values[COLUMN_LOG_CHANNELS];
+        for (int c = 0; c < COLUMN_LOG_CHANNELS; c++)
+            values[c] = chunk.values[c].data();
+        reduceRows(chunk.time.data(), values, chunk.rows, options, r);
+        for (const ColumnAlert &a : chunk.alerts)
+            r.alerts[a.text]++;
+        r.bytes += sizeof(h) + h.payload_size;
+    }
+    return true;
+}
+
+// 列式日志各块的起始偏移, 结构损坏返回 false
+static bool listColumnChunks(const MappedFile &file, std::vector<uint64_t> &offsets)
+{
+    uint64_t offset = sizeof(ColumnLogHeader);
+    while (offset + sizeof(ColumnChunkHeader) <= file.size())
+    {
+        ColumnChunkHeader h;
+        std::memcpy(&h, file.data() + offset, sizeof(h));
+        if (std::memcmp(h.magic, COLUMN_CHUNK_MAGIC, sizeof(h.magic)) != 0 ||
+            h.payload_size > file.size() - offset - sizeof(h))
+            return false;
+        offsets.push_back(offset);
+        offset += sizeof(h) + h.payload_size;
+    }
+    return offset == file.size();
+}
+
+// ---- LogScanner ----
+
+LogScanner::LogScanner(const LogScanOptions &scan_options) : options(scan_options)
+{
+    if (options.threads < 1)
+        options.threads = 1;
+    if (options.split_bytes < 64 * 1024)
+        options.split_bytes = 64 * 1024;
+}
+
+void LogScanner::reset(LogScanResult &r, size_t exceed_count)
+{
+    const double inf = std::numeric_limits<double>::infinity();
+    r.bytes = 0;
+    r.rows = 0;
+    r.bad_lines = 0;
+    r.first_time = 0.0;
+    r.last_time = 0.0;
+    for (ChannelSummary &c : r.channels)
+    {
+        c.min = inf;
+        c.max = -inf;
+        c.sum = 0.0;
+        c.count = 0;
+    }
+    r.exceed.assign(exceed_count, ExceedSummary{0.0, 0});
+    r.cycles.clear();
+    r.alerts.clear();
+    r.first_rpm = std::numeric_limits<double>::quiet_NaN();
+    r.last_rpm = std::numeric_limits<double>::quiet_NaN();
+    r.lead_max_egt = -inf;
+    r.first_above.assign(exceed_count, 0);
+}
+
+static void mergeChannels(LogScanResult &acc, const LogScanResult &next)
+{
+    for (int c = 0; c < COLUMN_LOG_CHANNELS; c++)
+    {
+        ChannelSummary &a = acc.channels[c];
+        const ChannelSummary &b = next.channels[c];
+        a.min = std::min(a.min, b.min);
+        a.max = std::max(a.max, b.max);
+        a.sum += b.sum;
+        a.count += b.count;
+    }
+    for (const auto &alert : next.alerts)
+        acc.alerts[alert.first] += alert.second;
+    acc.bytes += next.bytes;
+    acc.bad_lines += next.bad_lines;
+}
+
+void LogScanner::mergeAdjacent(LogScanResult &acc, const LogScanResult &next)
+{
+    if (acc.rows == 0)
+    {
+        // 前面没有数值行: 直接接管 next 的按行状态
+        std::string path = acc.path;
+        uint64_t bytes = acc.bytes, bad_lines = acc.bad_lines;
+        std::map<std::string, uint64_t> alerts;
+        alerts.swap(acc.alerts);
+        acc = next;
+        acc.path = path;
+        acc.bytes += bytes;
+        acc.bad_lines += bad_lines;
+        for (const auto &alert : alerts)
+            acc.alerts[alert.first] += alert.second;
+        return;
+    }
+
+    mergeChannels(acc, next);
+    if (next.rows == 0)
+        return;
+
+    double dt = next.first_time - acc.last_time;
+    for (size_t k = 0; k < acc.exceed.size(); k++)
+    {
+        acc.exceed[k].seconds += next.exceed[k].seconds + (next.first_above[k] ? dt : 0.0);
+        acc.exceed[k].rows += next.exceed[k].rows;
+    }
+
+    // next 的第一行若是一次启动, 段首那部分自成一个循环; 否则并入 acc 的最后一个循环
+    if (acc.last_rpm == 0.0 && next.first_rpm > 0.0)
+    {
+        StartCycle cycle;
+        cycle.start_time = next.first_time;
+        cycle.max_egt = next.lead_max_egt;
+        acc.cycles.push_back(cycle);
+    }
+    else if (!acc.cycles.empty())
+        acc.cycles.back().max_egt = std::max(acc.cycles.back().max_egt, next.lead_max_egt);
+    else
+        acc.lead_max_egt = std::max(acc.lead_max_egt, next.lead_max_egt);
+    acc.cycles.insert(acc.cycles.end(), next.cycles.begin(), next.cycles.end());
+
+    acc.last_time = next.last_time;
+    acc.last_rpm = next.last_rpm;
+    acc.rows += next.rows;
+}
+
+void LogScanner::addFile(LogScanResult &total, const LogScanResult &file)
+{
+    if (file.rows > 0)
+    {
+        total.first_time = total.rows == 0 ? file.first_time : std::min(total.first_time, file.first_time);
+        total.last_time = total.rows == 0 ? file.last_time : std::max(total.last_time, file.last_time);
+    }
+    mergeChannels(total, file);
+    for (size_t k = 0; k < total.exceed.size() && k < file.exceed.size(); k++)
+    {
+        total.exceed[k].seconds += file.exceed[k].seconds;
+        total.exceed[k].rows += file.exceed[k].rows;
+    }
+    total.cycles.insert(total.cycles.end(), file.cycles.begin(), file.cycles.end());
+    total.rows += file.rows;
+}
+
+// 文件第一行转速低于该值时视为一次启动的开始
+static const double FILE_START_RPM = 1000.0;
+
+// 一个并行任务处理的分段: CSV 为字节范围, 列式为块序号范围
+struct ScanSegment
+{
+    size_t file;
+    uint64_t begin;
+    uint64_t end;
+};
+
+bool LogScanner::scan(const std::vector<std::string> &paths, std::vector<LogScanResult> &results, std::string &error)
+{
+    std::vector<std::unique_ptr<MappedFile>> files;
+    std::vector<bool> columnar(paths.size(), false);
+    std::vector<std::vector<uint64_t>> chunk_offsets(paths.size());
+    std::vector<ScanSegment> segments;
+
+    for (size_t i = 0; i < paths.size(); i++)
+    {
+        files.emplace_back(new MappedFile);
+        MappedFile &file = *files.back();
+        if (!file.open(paths[i]))
+        {
+            error = "cannot open " + paths[i];
+            return false;
+        }
+        const uint8_t *data = file.data();
+        if (file.size() >= sizeof(BINARY_LOG_MAGIC) &&
+            std::memcmp(data, BINARY_LOG_MAGIC, sizeof(BINARY_LOG_MAGIC)) == 0)
+        {
+            error = paths[i] + ": binary logs are not supported (convert with engine_bin2csv)";
+            return false;
+        }
+
+        if (file.size() >= sizeof(ColumnLogHeader) &&
+            std::memcmp(data, COLUMN_LOG_MAGIC, sizeof(COLUMN_LOG_MAGIC)) == 0)
+        {
+            columnar[i] = true;
+            std::vector<uint64_t> &offsets = chunk_offsets[i];
+            if (!listColumnChunks(file, offsets))
+            {
+                error = paths[i] + ": corrupt columnar log";
+                return false;
+            }
+            // 压缩后的块比 CSV 小一个数量级以上, 按 split_bytes / 16 分段使每段行数相近
+            uint64_t segment_bytes = options.split_bytes / 16;
+            size_t first = 0;
+            for (size_t k = 0; k < offsets.size(); k++)
+            {
+                uint64_t end = (k + 1 < offsets.size()) ? offsets[k + 1] : file.size();
+                if (end - offsets[first] >= segment_bytes || k + 1 == offsets.size())
+                {
+                    segments.push_back(ScanSegment{i, first, k + 1});
+                    first = k + 1;
+                }
+            }
+            continue;
+        }
+
+        // CSV: 每段约 split_bytes 字节, 终点后移到下一行开头
+        const char *text = (const char *)data;
+        uint64_t size = file.size();
+        uint64_t begin = 0;
+        while (begin < size)
+        {
+            uint64_t end = std::min<uint64_t>(begin + options.split_bytes, size);
+            if (end < size)
+            {
+                const char *nl = (const char *)std::memchr(text + end, '\n', size - end);
+                end = nl ? (uint64_t)(nl - text) + 1 : size;
+            }
+            segments.push_back(ScanSegment{i, begin, end});
+            begin = end;
+        }
+    }
+
+    std::vector<LogScanResult> partials(segments.size());
+    std::vector<uint8_t> ok(segments.size(), 1);
+    {
+        TaskScheduler scheduler(options.threads);
+        // 各段结果按序号存放, 合并顺序与线程数和执行顺序无关
+        for (size_t k = 0; k < segments.size(); k++)
+        {
+            scheduler.submit([this, &files, &columnar, &chunk_offsets, &segments, &partials, &ok, k](int) {
+                const ScanSegment &seg = segments[k];
+                const MappedFile &file = *files[seg.file];
+                LogScanResult &r = partials[k];
+                reset(r, options.exceed.size());
+                if (columnar[seg.file])
+                {
+                    ok[k] = scanColumnSegment(file, chunk_offsets[seg.file], (size_t)seg.begin, (size_t)seg.end,
+                                              options, r);
+                    return;
+                }
+                const char *text = (const char *)file.data();
+                scanCsvSegment(text + seg.begin, text + seg.end, options, r);
+                r.bytes = seg.end - seg.begin;
+            });
+        }
+        scheduler.wait();
+    }
+
+    results.resize(paths.size());
+    for (size_t i = 0; i < paths.size(); i++)
+    {
+        reset(results[i], options.exceed.size());
+        results[i].path = paths[i];
+    }
+    for (size_t k = 0; k < segments.size(); k++)
+    {
+        if (!ok[k])
+        {
+            error = paths[segments[k].file] + ": corrupt chunk";
+            return false;
+        }
+        mergeAdjacent(results[segments[k].file], partials[k]);
+    }
+
+    // Logger 从发动机静止时开始记录, 第一行往往已是启动的第一步 (前面没有转速为 0 的行), 也算一次启动;
+    // 分卷后续文件的第一行转速较高, 不算
+    for (LogScanResult &r : results)
+    {
+        if (r.rows > 0 && r.first_rpm > 0.0 && r.first_rpm < FILE_START_RPM)
+        {
+            StartCycle cycle;
+            cycle.start_time = r.first_time;
+            cycle.max_egt = r.lead_max_egt;
+            r.cycles.insert(r.cycles.begin(), cycle);
+            r.lead_max_egt = -std::numeric_limits<double>::infinity();
+        }
+    }
+    return true;
+}
@@ -0,0 +1,91 @@
+#pragma once
+#include "ColumnLog.h"
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+// 多个日志文件的并行统计: 内存映射后按行边界切成分段, 由 TaskScheduler 并行扫描, 每段的结果再按文件顺序合并
+// 支持 Logger 的 CSV 格式和 ColumnLogger 的列式格式 (列式按压缩块分段)
+// 各通道按 CSV 列顺序编号: N1, N2, EGT1, EGT2, 燃油流量, 燃油余量; 负值是传感器失效的标志值, 不计入统计
+
+// 通道名称 (N1 / N2 / EGT1 / EGT2 / FUEL_FLOW / FUEL_QTY), 用于命令行和报告
+const char *logChannelName(int channel);
+bool parseLogChannel(const char *name, int &channel);
+
+// 统计某通道高于门限的时长
+struct ExceedQuery
+{
+    int channel;
+    double threshold;
+};
+
+struct LogScanOptions
+{
+    std::vector<ExceedQuery> exceed;
+    int threads;
+    size_t split_bytes; // CSV 每段的字节数, 列式每段为相同数量级的压缩块
+};
+
+struct ChannelSummary
+{
+    double min;
+    double max;
+    double sum;
+    uint64_t count; // 有效 (非负) 值的个数
+};
+
+struct ExceedSummary
+{
+    double seconds; // 高于门限的行与上一行的时间间隔之和
+    uint64_t rows;
+};
+
+// 一次启动循环: 转速由 0 升起 (或文件以低转速开始) 到下一次由 0 升起之前
+struct StartCycle
+{
+    double start_time;
+    double max_egt; // 两路排气温度的最大值
+};
+
+// 一个文件 (或文件中一段) 的统计结果
+struct LogScanResult
+{
+    std::string path;
+    uint64_t bytes;
+    uint64_t rows;
+    uint64_t bad_lines;
+    double first_time;
+    double last_time;
+    ChannelSummary channels[COLUMN_LOG_CHANNELS];
+    std::vector<ExceedSummary> exceed; // 与 LogScanOptions::exceed 一一对应
+    std::vector<StartCycle> cycles;
+    std::map<std::string, uint64_t> alerts; // 报警文本 -> 次数
+
+    // 合并相邻分段用: 段首 / 段尾的转速, 段内第一次启动之前的最高排气温度, 段首行是否高于各门限
+    double first_rpm;
+    double last_rpm;
+    double lead_max_egt;
+    std::vector<uint8_t> first_above;
+};
+
+class LogScanner
+{
+public:
+    explicit LogScanner(const LogScanOptions &options);
+
+    // 每个文件一个结果, 与 paths 顺序一致; 文件无法打开或格式损坏时返回 false
+    bool scan(const std::vector<std::string> &paths, std::vector<LogScanResult> &results, std::string &error);
+
+    // 把 next (紧接在 acc 之后的分段) 合并到 acc, 处理跨段的启动循环和门限时长
+    static void mergeAdjacent(LogScanResult &acc, const LogScanResult &next);
+
+    // 把一个文件的结果累加到多文件合计 (文件之间互不相连)
+    static void addFile(LogScanResult &total, const LogScanResult &file);
+
+    static void reset(LogScanResult &result, size_t exceed_count);
+
+private:
+    LogScanOptions options;
+};
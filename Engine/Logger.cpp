@@ -1,61 +1,278 @@
 #include "Logger.h"
+#include <charconv>
+#include <cstring>
 #include <ctime>
-#include <iomanip>
-#include <iostream> 
+#include <string_view>
 
-Logger::Logger()
+static std::string makeLogFileName()
 {
-    // ɴʱļ
+    // 生成带时间戳的文件名
     time_t now = time(0);
     struct tm tstruct;
+#ifdef _WIN32
     localtime_s(&tstruct, &now);
+#else
+    localtime_r(&now, &tstruct);
+#endif
     char buf[80];
     strftime(buf, sizeof(buf), "log_%Y%m%d_%H%M%S.csv", &tstruct);
-    filename = buf;
+    return buf;
+}
+
+// 分卷文件名: 第 part 个文件在扩展名前加 ".序号" (如 run.csv 的第 1 个分卷为 run.1.csv)
+static std::string partFileName(const std::string &name, int part)
+{
+    if (part == 0)
+        return name;
+    size_t slash = name.find_last_of("/\\");
+    size_t dot = name.rfind('.');
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash))
+        return name + "." + std::to_string(part);
+    return name.substr(0, dot) + "." + std::to_string(part) + name.substr(dot);
+}
+
+// CSV 中实际写出的时间 (按 precision 位小数格式化后再读回); 实时索引记录这个值,
+// 与 engine_logquery --build 由 CSV 文本生成的索引逐字节一致
+static double csvTime(double time, int precision)
+{
+    char buf[64];
+    std::to_chars_result res = std::to_chars(buf, buf + sizeof(buf), time, std::chars_format::fixed, precision);
+    if (res.ec != std::errc())
+        return time;
+    double value = time;
+    std::from_chars(buf, res.ptr, value);
+    return value;
+}
+
+Logger::Logger() : Logger(makeLogFileName()) {}
 
-    out_file.open(filename);
-    if (out_file.is_open())
+Logger::Logger(const std::string &file_name, LogFormat log_format, const LogOptions &log_options)
+{
+    filename = file_name;
+    base_filename = file_name;
+    format = log_format;
+    options = log_options;
+    if (format == LogFormat::BINARY)
     {
-        // дCSVͷ
-        out_file << "Time(s),N1(RPM),N2(RPM),EGT1(C),EGT2(C),Fuel_Flow,Fuel_Quantity\n";
+        options = LogOptions();
+        options.write_trend = log_options.write_trend;
     }
+    openFile();
 }
 
 Logger::~Logger()
 {
-    if (out_file.is_open())
+    closeFile();
+}
+
+void Logger::openFile()
+{
+    file_rows = 0;
+    file_first_time = 0.0;
+    chunk_offset = 0;
+    chunk_rows = 0;
+    chunk_first_time = 0.0;
+    chunk_last_time = 0.0;
+
+    if (format == LogFormat::BINARY)
+    {
+        binary_log.open(filename);
+        if (binary_log.isOpen())
+            file_names.push_back(filename);
+        return;
+    }
+    if (format == LogFormat::COLUMNAR)
+    {
+        column_log.open(filename, 3, INDEX_CHUNK_ROWS);
+        if (!column_log.isOpen())
+            return;
+        if (options.write_index)
+        {
+            index.open(logIndexPath(filename), LogIndexFormat::COLUMNAR, INDEX_CHUNK_ROWS);
+            column_log.setIndex(&index);
+        }
+        file_names.push_back(filename);
+        return;
+    }
+
+    csv_file.open(filename);
+    if (csv_file.isOpen())
     {
-        out_file.close();
+        // 写入CSV表头
+        csv_file.writeHeader();
+        if (options.write_index)
+            index.open(logIndexPath(filename), LogIndexFormat::CSV, INDEX_CHUNK_ROWS);
+        file_names.push_back(filename);
     }
 }
 
-void Logger::log(double time, const EngineData &data)
+void Logger::closeFile()
 {
-    if (out_file.is_open())
+    if (options.write_trend && trend.getSampleCount() > 0)
     {
-        // ʽݣλС
-        out_file << std::fixed << std::setprecision(3) << time << "," << data.rpm_1 << "," << data.rpm_2 << ","
-                 << data.egt1_temp << "," << data.egt2_temp << "," << data.fuel_v << "," << data.fuel_c << "\n";
+        trend.save(trendPyramidPath(filename));
+        trend.clear();
+    }
+
+    if (format == LogFormat::COLUMNAR)
+    {
+        // 关闭时写出最后一块, 块信息经 setIndex 记入索引
+        column_log.close();
+        column_log.setIndex(nullptr);
+        if (index.isOpen())
+            index.close(column_log.getStats().bytes_written);
+        return;
+    }
+
+    if (csv_file.isOpen())
+    {
+        if (index.isOpen())
+        {
+            index.addChunk(chunk_offset, csv_file.tell() - chunk_offset, chunk_first_time, chunk_last_time,
+                           chunk_rows);
+            index.close(csv_file.tell());
+        }
+        csv_file.close();
     }
 }
 
-void Logger::logAlert(double time, const std::string &alert_msg)
+void Logger::rotateIfNeeded(double time)
 {
-    if (!out_file.is_open() || alert_msg.empty())
+    if (file_rows == 0)
+    {
+        file_first_time = time;
         return;
+    }
+    if (options.rotate_bytes == 0 && options.rotate_seconds <= 0.0)
+        return;
+
+    uint64_t size = (format == LogFormat::COLUMNAR) ? column_log.getStats().bytes_written : csv_file.tell();
+    bool full = options.rotate_bytes > 0 && size >= options.rotate_bytes;
+    bool expired = options.rotate_seconds > 0.0 && time - file_first_time >= options.rotate_seconds;
+    if (!full && !expired)
+        return;
+
+    closeFile();
+    filename = partFileName(base_filename, (int)file_names.size());
+    openFile();
+    file_first_time = time;
+}
 
-    // 5ڵظ¼
-    if (last_alert_times.find(alert_msg) != last_alert_times.end())
+void Logger::log(double time, const EngineSnapshot &data)
+{
+    writeSample(time, data, RECORD_STATE_UNKNOWN);
+}
+
+void Logger::log(double time, const EngineSnapshot &data, EngineState state)
+{
+    writeSample(time, data, (uint8_t)state);
+}
+
+void Logger::writeSample(double time, const EngineSnapshot &data, uint8_t state)
+{
+    if (format == LogFormat::BINARY)
+    {
+        if (options.write_trend && binary_log.isOpen())
+            trend.append(time, data);
+        binary_log.push(makeSampleRecord(time, data, state));
+        return;
+    }
+    if (!isOpen())
+        return;
+    rotateIfNeeded(time);
+    file_rows++;
+    if (options.write_trend)
+        trend.append(time, data);
+
+    if (format == LogFormat::COLUMNAR)
+    {
+        column_log.append(time, data, state);
+        return;
+    }
+
+    if (index.isOpen())
     {
-        double last_time = last_alert_times[alert_msg];
-        if (time - last_time < 5.0)
+        // 攒满一块后, 下一个数值行开始新块; 其间的报警行仍属于上一块
+        if (chunk_rows == INDEX_CHUNK_ROWS)
         {
-            return;
+            index.addChunk(chunk_offset, csv_file.tell() - chunk_offset, chunk_first_time, chunk_last_time,
+                           chunk_rows);
+            chunk_offset = csv_file.tell();
+            chunk_rows = 0;
         }
+        double row_time = csvTime(time, 3);
+        if (chunk_rows == 0)
+            chunk_first_time = row_time;
+        chunk_last_time = row_time;
+        chunk_rows++;
+    }
+
+    // 格式化输出数据，保留三位小数
+    csv_file.writeSample(time, data);
+}
+
+void Logger::logAlert(double time, const std::string &alert_msg)
+{
+    logAlert(time, alert_msg.data(), alert_msg.size());
+}
+
+void Logger::logAlert(double time, const char *alert_msg)
+{
+    logAlert(time, alert_msg, std::strlen(alert_msg));
+}
+
+void Logger::logAlert(double time, const char *alert_msg, size_t len)
+{
+    if (!isOpen() || len == 0)
+        return;
+
+    // 5秒内的重复报警不记录; 按 string_view 查找, 只有第一次出现的文本才分配
+    std::string_view text(alert_msg, len);
+    auto it = last_alert_times.find(text);
+    if (it == last_alert_times.end())
+        last_alert_times.emplace(std::string(text), time);
+    else if (time - it->second < 5.0)
+        return;
+    else
+        it->second = time;
+
+    if (format == LogFormat::BINARY)
+    {
+        binary_log.push(makeAlertRecord(time, alert_msg, len));
+        return;
+    }
+    if (format == LogFormat::COLUMNAR)
+    {
+        column_log.appendAlert(time, alert_msg, len);
+        return;
     }
 
-    last_alert_times[alert_msg] = time;
+    // 写入报警日志
+    uint64_t offset = csv_file.tell();
+    csv_file.writeAlert(time, alert_msg, len);
+    if (index.isOpen())
+        index.addAlert(offset, (uint32_t)(csv_file.tell() - offset), csvTime(time, 1), chunk_rows, alert_msg,
+                       len);
+}
+
+bool Logger::isOpen() const
+{
+    if (format == LogFormat::COLUMNAR)
+        return column_log.isOpen();
+    return (format == LogFormat::BINARY) ? binary_log.isOpen() : csv_file.isOpen();
+}
 
-    // д뱨־
-    out_file << "ALERT," << std::fixed << std::setprecision(1) << time << ",MESSAGE:," << alert_msg << "\n";
+BinaryLoggerStats Logger::getBinaryStats() const
+{
+    return binary_log.getStats();
+}
+
+ColumnLoggerStats Logger::getColumnStats() const
+{
+    return column_log.getStats();
+}
+
+const std::vector<std::string> &Logger::getFileNames() const
+{
+    return file_names;
 }
\ No newline at end of file
@@ -1,25 +1,90 @@
 #pragma once
+#include "BinaryLogger.h"
+#include "ColumnLogger.h"
+#include "CsvWriter.h"
 #include "DataStructrue.h"
-#include <fstream>
+#include "LogIndex.h"
+#include "TrendPyramid.h"
+#include <functional>
 #include <map>
 #include <string>
+#include <vector>
+
+enum class LogFormat
+{
+    CSV,      // 文本格式, 在调用线程上格式化写入
+    BINARY,   // 定长二进制记录, 经无锁缓冲区由后台线程写盘, 可用 BinaryLogger::convertToCsv 转换
+    COLUMNAR, // 列式压缩块 (精度与 CSV 相同), 可用 ColumnLogReader::convertToCsv 转换
+};
+
+// 旁路索引、趋势金字塔与分卷; 二进制格式由后台线程写盘, 只支持趋势金字塔
+struct LogOptions
+{
+    bool write_index = false;    // 每个日志文件关闭时写出 LogIndex 索引 (路径 + ".idx")
+    bool write_trend = false;    // 记录时增量更新 TrendPyramid, 每个日志文件关闭时写出 (路径 + ".trend")
+    uint64_t rotate_bytes = 0;   // 文件达到该字节数后换下一个文件, 0 表示不限
+    double rotate_seconds = 0.0; // 文件覆盖的仿真时间达到该秒数后换下一个文件, 0 表示不限
+};
 
 class Logger
 {
 public:
     Logger();
+    // 指定日志文件路径 (无界面批量运行时使用)
+    // 分卷时后续文件名在扩展名前加序号: run.csv, run.1.csv, run.2.csv ...
+    explicit Logger(const std::string &file_name, LogFormat log_format = LogFormat::CSV,
+                    const LogOptions &log_options = LogOptions());
     ~Logger();
 
-    // ¼ÿֵ֡
-    void log(double time, const EngineData &data);
+    // 记录每帧的数值数据
+    void log(double time, const EngineSnapshot &data);
+    // 同上, 二进制格式会一并记录发动机状态
+    void log(double time, const EngineSnapshot &data, EngineState state);
 
-    // ¼¼
+    // 记录报警事件; 5 秒内重复的报警不记录, 已记录过的报警文本再次出现时不分配内存
+    void logAlert(double time, const char *alert_msg, size_t len);
+    void logAlert(double time, const char *alert_msg);
     void logAlert(double time, const std::string &alert_msg);
 
+    bool isOpen() const;
+
+    // 二进制格式下的缓冲区与写盘统计
+    BinaryLoggerStats getBinaryStats() const;
+    // 列式格式下的压缩与写盘统计
+    ColumnLoggerStats getColumnStats() const;
+
+    // 已写过的全部日志文件 (分卷时不止一个)
+    const std::vector<std::string> &getFileNames() const;
+
 private:
-    std::ofstream out_file;
+    // CSV 索引每块的数值行数, 列式格式的压缩块也取这个行数
+    static const uint32_t INDEX_CHUNK_ROWS = 4096;
+
+    void openFile();
+    void closeFile();
+    void rotateIfNeeded(double time);
+    void writeSample(double time, const EngineSnapshot &data, uint8_t state);
+
+    LogFormat format;
+    CsvWriter csv_file;
+    BinaryLogger binary_log;
+    ColumnLogger column_log;
     std::string filename;
+    std::string base_filename;
+    std::vector<std::string> file_names;
+
+    LogOptions options;
+    LogIndexWriter index;
+    TrendPyramid trend;
+    uint64_t file_rows;
+    double file_first_time;
+
+    // CSV 索引当前块
+    uint64_t chunk_offset;
+    uint32_t chunk_rows;
+    double chunk_first_time;
+    double chunk_last_time;
 
-    // ڼ¼Ϣȥʱ
-    std::map<std::string, double> last_alert_times;
+    // 用于记录报警信息的去重时间戳
+    std::map<std::string, double, std::less<>> last_alert_times;
 };
\ No newline at end of file
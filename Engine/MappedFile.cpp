@@ -0,0 +1,132 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile() : base(nullptr), length(0), opened(false)
+{
+#ifdef _WIN32
+    file_handle = nullptr;
+    mapping = nullptr;
+#endif
+}
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+#ifdef _WIN32
+
+bool MappedFile::open(const std::string &path)
+{
+    close();
+    HANDLE f = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING,
+                           FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (f == INVALID_HANDLE_VALUE)
+        return false;
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(f, &size))
+    {
+        CloseHandle(f);
+        return false;
+    }
+    file_handle = f;
+    opened = true;
+    if (size.QuadPart == 0)
+        return true;
+
+    HANDLE h = CreateFileMappingA(f, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    void *p = h ? MapViewOfFile(h, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!p)
+    {
+        if (h)
+            CloseHandle(h);
+        close();
+        return false;
+    }
+    mapping = h;
+    base = (const uint8_t *)p;
+    length = (size_t)size.QuadPart;
+    return true;
+}
+
+void MappedFile::close()
+{
+    if (base)
+        UnmapViewOfFile(base);
+    if (mapping)
+        CloseHandle((HANDLE)mapping);
+    if (file_handle)
+        CloseHandle((HANDLE)file_handle);
+    base = nullptr;
+    mapping = nullptr;
+    file_handle = nullptr;
+    length = 0;
+    opened = false;
+}
+
+#else
+
+bool MappedFile::open(const std::string &path)
+{
+    close();
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0)
+    {
+        ::close(fd);
+        return false;
+    }
+    opened = true;
+    if (st.st_size == 0)
+    {
+        ::close(fd);
+        return true;
+    }
+
+    void *p = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (p == MAP_FAILED)
+    {
+        opened = false;
+        return false;
+    }
+    base = (const uint8_t *)p;
+    length = (size_t)st.st_size;
+    return true;
+}
+
+void MappedFile::close()
+{
+    if (base)
+        munmap((void *)base, length);
+    base = nullptr;
+    length = 0;
+    opened = false;
+}
+
+#endif
+
+bool MappedFile::isOpen() const
+{
+    return opened;
+}
+
+const uint8_t *MappedFile::data() const
+{
+    return base;
+}
+
+size_t MappedFile::size() const
+{
+    return length;
+}
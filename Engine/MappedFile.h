@@ -0,0 +1,31 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// 只读映射整个文件的平台封装; 空文件可以打开, data() 为空指针
+class MappedFile
+{
+public:
+    MappedFile();
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    bool open(const std::string &path);
+    void close();
+    bool isOpen() const;
+
+    const uint8_t *data() const;
+    size_t size() const;
+
+private:
+    const uint8_t *base;
+    size_t length;
+    bool opened;
+#ifdef _WIN32
+    void *file_handle;
+    void *mapping;
+#endif
+};
@@ -0,0 +1,239 @@
+#include "Profiler.h"
+
+// 单写者计数: 用 load + store 代替原子加法, 避免加锁前缀指令
+static inline void bump(std::atomic<uint64_t> &a, uint64_t n)
+{
+    a.store(a.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+static inline int highestBit(uint64_t v)
+{
+    int bit = 0;
+    while (v >>= 1)
+        bit++;
+    return bit;
+}
+
+LatencyHistogram::LatencyHistogram()
+{
+    reset();
+}
+
+int LatencyHistogram::bucketIndex(uint64_t value)
+{
+    if (value < (uint64_t)SUB_BUCKETS)
+        return (int)value;
+#if defined(__GNUC__)
+    int e = 63 - __builtin_clzll(value);
+#else
+    int e = highestBit(value);
+#endif
+    int sub = (int)((value >> (e - 4)) & (SUB_BUCKETS - 1));
+    int index = (e - 3) * SUB_BUCKETS + sub;
+    return (index < BUCKET_COUNT) ? index : BUCKET_COUNT - 1;
+}
+
+uint64_t LatencyHistogram::bucketUpper(int index)
+{
+    if (index < SUB_BUCKETS)
+        return (uint64_t)index;
+    int e = index / SUB_BUCKETS + 3;
+    uint64_t sub = (uint64_t)(index % SUB_BUCKETS);
+    uint64_t lower = (SUB_BUCKETS + sub) << (e - 4);
+    return lower + ((uint64_t)1 << (e - 4)) - 1;
+}
+
+void LatencyHistogram::record(uint64_t value)
+{
+    bump(buckets[bucketIndex(value)], 1);
+    bump(count, 1);
+    bump(sum, value);
+    if (value < min_value.load(std::memory_order_relaxed))
+        min_value.store(value, std::memory_order_relaxed);
+    if (value > max_value.load(std::memory_order_relaxed))
+        max_value.store(value, std::memory_order_relaxed);
+}
+
+void LatencyHistogram::reset()
+{
+    for (int i = 0; i < BUCKET_COUNT; i++)
+        buckets[i].store(0, std::memory_order_relaxed);
+    count.store(0, std::memory_order_relaxed);
+    sum.store(0, std::memory_order_relaxed);
+    min_value.store(~(uint64_t)0, std::memory_order_relaxed);
+    max_value.store(0, std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::getCount() const
+{
+    return count.load(std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::getMin() const
+{
+    return getCount() ? min_value.load(std::memory_order_relaxed) : 0;
+}
+
+uint64_t LatencyHistogram::getMax() const
+{
+    return max_value.load(std::memory_order_relaxed);
+}
+
+double LatencyHistogram::getMean() const
+{
+    uint64_t n = getCount();
+    return n ? (double)sum.load(std::memory_order_relaxed) / n : 0.0;
+}
+
+uint64_t LatencyHistogram::getPercentile(double p) const
+{
+    // 以各格计数之和为准, 与 count 可能因并发读取略有出入
+    uint64_t total = 0;
+    for (int i = 0; i < BUCKET_COUNT; i++)
+        total += buckets[i].load(std::memory_order_relaxed);
+    if (total == 0)
+        return 0;
+
+    uint64_t target = (uint64_t)(total * p / 100.0 + 0.5);
+    if (target < 1)
+        target = 1;
+    uint64_t seen = 0;
+    for (int i = 0; i < BUCKET_COUNT; i++)
+    {
+        seen += buckets[i].load(std::memory_order_relaxed);
+        if (seen >= target)
+        {
+            uint64_t upper = bucketUpper(i);
+            uint64_t max = getMax();
+            return (upper < max) ? upper : max;
+        }
+    }
+    return getMax();
+}
+
+Profiler::Profiler() : enabled(true)
+{
+    for (int i = 0; i < PROFILE_COUNTER_COUNT; i++)
+        counters[i].store(0, std::memory_order_relaxed);
+}
+
+void Profiler::setEnabled(bool value)
+{
+    enabled = value;
+}
+
+bool Profiler::isEnabled() const
+{
+    return enabled;
+}
+
+void Profiler::record(ProfilePhase phase, uint64_t ns)
+{
+    phases[(int)phase].record(ns);
+}
+
+void Profiler::add(ProfileCounter counter, uint64_t n)
+{
+    bump(counters[(int)counter], n);
+}
+
+void Profiler::recordStepsPerCycle(uint64_t steps)
+{
+    steps_per_cycle.record(steps);
+}
+
+const LatencyHistogram &Profiler::getHistogram(ProfilePhase phase) const
+{
+    return phases[(int)phase];
+}
+
+uint64_t Profiler::getCounter(ProfileCounter counter) const
+{
+    return counters[(int)counter].load(std::memory_order_relaxed);
+}
+
+const char *Profiler::getPhaseName(ProfilePhase phase)
+{
+    switch (phase)
+    {
+    case ProfilePhase::SIM_COMMANDS:
+        return "sim.commands";
+    case ProfilePhase::SIM_STEPS:
+        return "sim.steps";
+    case ProfilePhase::SIM_JUDGE:
+        return "sim.judge";
+    case ProfilePhase::SIM_ALERT_LOG:
+        return "sim.alert_log";
+    case ProfilePhase::SIM_PUBLISH:
+        return "sim.publish";
+    case ProfilePhase::SIM_CYCLE:
+        return "sim.cycle";
+    case ProfilePhase::SIM_LATE:
+        return "sim.wake_late";
+    case ProfilePhase::UI_INPUT:
+        return "ui.input";
+    case ProfilePhase::UI_DRAW:
+        return "ui.draw";
+    case ProfilePhase::UI_FRAME:
+        return "ui.frame";
+    }
+    return "?";
+}
+
+const char *Profiler::getCounterName(ProfileCounter counter)
+{
+    switch (counter)
+    {
+    case ProfileCounter::SIM_CYCLES:
+        return "sim_cycles";
+    case ProfileCounter::SIM_STEPS:
+        return "sim_steps";
+    case ProfileCounter::STEPS_DROPPED:
+        return "steps_dropped_by_clamp";
+    case ProfileCounter::ALERTS_LOGGED:
+        return "alerts_logged";
+    case ProfileCounter::COMMANDS:
+        return "commands";
+    case ProfileCounter::UI_FRAMES:
+        return "ui_frames";
+    }
+    return "?";
+}
+
+void Profiler::dump(std::FILE *out) const
+{
+    std::fprintf(out, "%-16s %10s %10s %10s %10s %10s %10s %10s\n", "phase(us)", "count", "min", "mean", "p50",
+                 "p99", "p99.9", "max");
+    for (int i = 0; i < PROFILE_PHASE_COUNT; i++)
+    {
+        const LatencyHistogram &h = phases[i];
+        if (h.getCount() == 0)
+            continue;
+        std::fprintf(out, "%-16s %10llu %10.1f %10.1f %10.1f %10.1f %10.1f %10.1f\n", getPhaseName((ProfilePhase)i),
+                     (unsigned long long)h.getCount(), h.getMin() / 1e3, h.getMean() / 1e3,
+                     h.getPercentile(50) / 1e3, h.getPercentile(99) / 1e3, h.getPercentile(99.9) / 1e3,
+                     h.getMax() / 1e3);
+    }
+
+    if (steps_per_cycle.getCount() > 0)
+    {
+        std::fprintf(out, "steps per cycle: mean %.3f, p99 %llu, max %llu\n", steps_per_cycle.getMean(),
+                     (unsigned long long)steps_per_cycle.getPercentile(99),
+                     (unsigned long long)steps_per_cycle.getMax());
+    }
+
+    for (int i = 0; i < PROFILE_COUNTER_COUNT; i++)
+    {
+        std::fprintf(out, "%-24s %llu\n", getCounterName((ProfileCounter)i),
+                     (unsigned long long)counters[i].load(std::memory_order_relaxed));
+    }
+}
+
+void Profiler::reset()
+{
+    for (int i = 0; i < PROFILE_PHASE_COUNT; i++)
+        phases[i].reset();
+    steps_per_cycle.reset();
+    for (int i = 0; i < PROFILE_COUNTER_COUNT; i++)
+        counters[i].store(0, std::memory_order_relaxed);
+}
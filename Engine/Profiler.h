@@ -0,0 +1,165 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+// 对数-线性分桶的延迟直方图 (HDR 风格): 每个 2 的幂区间再等分 16 格, 相对误差不超过 6.25%
+// 单写者: 只由一个线程调用 record, 其他线程可随时读取 (读到的是近似一致的快照)
+class LatencyHistogram
+{
+public:
+    static const int SUB_BUCKETS = 16;
+    static const int BUCKET_COUNT = 45 * SUB_BUCKETS; // 覆盖到 2^48 纳秒
+
+    LatencyHistogram();
+
+    void record(uint64_t value);
+    void reset();
+
+    uint64_t getCount() const;
+    uint64_t getMin() const;
+    uint64_t getMax() const;
+    double getMean() const;
+    // p 取 0 ~ 100, 返回所在格的上沿
+    uint64_t getPercentile(double p) const;
+
+private:
+    static int bucketIndex(uint64_t value);
+    static uint64_t bucketUpper(int index);
+
+    std::atomic<uint64_t> buckets[BUCKET_COUNT];
+    std::atomic<uint64_t> count;
+    std::atomic<uint64_t> sum;
+    std::atomic<uint64_t> min_value;
+    std::atomic<uint64_t> max_value;
+};
+
+// 帧内各阶段; SIM_* 由仿真线程记录, UI_* 由界面线程记录
+enum class ProfilePhase
+{
+    SIM_COMMANDS,  // 处理界面发来的操作
+    SIM_STEPS,     // consumeStep 循环: 仿真推进和数值日志
+    SIM_JUDGE,     // EICAS 判断和自动停车保护
+    SIM_ALERT_LOG, // 告警文本写日志
+    SIM_PUBLISH,   // 发布快照和遥测 (共享内存、数据报)
+    SIM_CYCLE,     // 仿真线程一个周期的总耗时 (不含等待)
+    SIM_LATE,      // 节拍等待醒来时相对截止时刻的迟到量
+    UI_INPUT,      // UI::handleInput
+    UI_DRAW,       // UI::draw
+    UI_FRAME,      // 界面一帧的总耗时 (不含等待)
+};
+
+const int PROFILE_PHASE_COUNT = (int)ProfilePhase::UI_FRAME + 1;
+
+enum class ProfileCounter
+{
+    SIM_CYCLES,
+    SIM_STEPS,
+    STEPS_DROPPED, // 单帧超过 0.25 秒被截断而丢弃的仿真步
+    ALERTS_LOGGED, // 调用 logAlert 的次数 (含被去重的)
+    COMMANDS,
+    UI_FRAMES,
+};
+
+const int PROFILE_COUNTER_COUNT = (int)ProfileCounter::UI_FRAMES + 1;
+
+// 常开的轻量级性能统计: 每个阶段一个延迟直方图, 外加若干计数器和每周期步数的分布
+// 每个阶段/计数器只由一个线程写入, 不加锁; dump 可在任意线程随时调用
+class Profiler
+{
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    Profiler();
+
+    void setEnabled(bool enabled);
+    bool isEnabled() const;
+
+    void record(ProfilePhase phase, uint64_t ns);
+    void add(ProfileCounter counter, uint64_t n = 1);
+    // 每个仿真周期推进的步数
+    void recordStepsPerCycle(uint64_t steps);
+
+    const LatencyHistogram &getHistogram(ProfilePhase phase) const;
+    uint64_t getCounter(ProfileCounter counter) const;
+
+    void dump(std::FILE *out) const;
+    void reset();
+
+    static const char *getPhaseName(ProfilePhase phase);
+    static const char *getCounterName(ProfileCounter counter);
+
+private:
+    bool enabled;
+    LatencyHistogram phases[PROFILE_PHASE_COUNT];
+    LatencyHistogram steps_per_cycle;
+    std::atomic<uint64_t> counters[PROFILE_COUNTER_COUNT];
+};
+
+// 作用域计时: 构造时记下起点, 析构时把耗时记入对应阶段; profiler 为空或未启用时不读时钟
+class ProfileScope
+{
+public:
+    ProfileScope(Profiler *profiler, ProfilePhase phase)
+        : profiler((profiler && profiler->isEnabled()) ? profiler : nullptr), phase(phase)
+    {
+        if (this->profiler)
+            start = Profiler::Clock::now();
+    }
+
+    ~ProfileScope()
+    {
+        if (profiler)
+            profiler->record(phase, (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                        Profiler::Clock::now() - start)
+                                        .count());
+    }
+
+    ProfileScope(const ProfileScope &) = delete;
+    ProfileScope &operator=(const ProfileScope &) = delete;
+
+private:
+    Profiler *profiler;
+    ProfilePhase phase;
+    Profiler::Clock::time_point start;
+};
+
+// 连续阶段计时: 上一阶段的终点即下一阶段的起点, 每个阶段只读一次时钟
+class PhaseTimer
+{
+public:
+    explicit PhaseTimer(Profiler *profiler)
+        : profiler((profiler && profiler->isEnabled()) ? profiler : nullptr)
+    {
+        if (this->profiler)
+            start = last = Profiler::Clock::now();
+    }
+
+    // 记录自上次 mark (或构造) 以来的耗时
+    void mark(ProfilePhase phase)
+    {
+        if (!profiler)
+            return;
+        Profiler::Clock::time_point now = Profiler::Clock::now();
+        profiler->record(phase, toNs(now - last));
+        last = now;
+    }
+
+    // 记录自构造到最后一次 mark 的总耗时
+    void total(ProfilePhase phase)
+    {
+        if (profiler)
+            profiler->record(phase, toNs(last - start));
+    }
+
+private:
+    static uint64_t toNs(Profiler::Clock::duration d)
+    {
+        return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(d).count();
+    }
+
+    Profiler *profiler;
+    Profiler::Clock::time_point start;
+    Profiler::Clock::time_point last;
+};
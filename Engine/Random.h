@@ -0,0 +1,75 @@
+#pragma once
+#include <cstdint>
+
+// 每个仿真实例独立持有的伪随机数发生器 (xoshiro256**), 替代全局 rand()
+// 相同种子得到相同序列, 不同实例之间没有共享状态
+class Random
+{
+public:
+    explicit Random(uint64_t seed_value = 1)
+    {
+        seed(seed_value);
+    }
+
+    void seed(uint64_t seed_value)
+    {
+        // 用 splitmix64 展开种子, 避免全零状态
+        uint64_t x = seed_value;
+        for (int i = 0; i < 4; i++)
+            s[i] = splitmix64(x);
+    }
+
+    uint64_t next()
+    {
+        uint64_t result = rotl(s[1] * 5, 7) * 9;
+        uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+        return result;
+    }
+
+    // [0, bound) 内的整数 (乘法取高位, 对仿真用的小 bound 偏差可忽略)
+    uint32_t nextBelow(uint32_t bound)
+    {
+        return (uint32_t)(((next() >> 32) * (uint64_t)bound) >> 32);
+    }
+
+    // RUNNING 状态的 ±3% 扰动, 取值与原 (rand() % 600 - 300) / 10000.0 相同
+    double nextNoise()
+    {
+        return ((int)nextBelow(600) - 300) / 10000.0;
+    }
+
+    // 推力调节的跳变幅度 3% ~ 5%
+    double nextDashJump()
+    {
+        return 0.03 + nextBelow(201) / 10000.0;
+    }
+
+    // 由基础种子和实例编号派生互不相关的种子, 用于多实例/多线程仿真
+    static uint64_t streamSeed(uint64_t base_seed, uint64_t index)
+    {
+        uint64_t x = base_seed ^ (index * 0x9E3779B97F4A7C15ull);
+        return splitmix64(x);
+    }
+
+private:
+    static uint64_t rotl(uint64_t x, int k)
+    {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    static uint64_t splitmix64(uint64_t &x)
+    {
+        uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    uint64_t s[4];
+};
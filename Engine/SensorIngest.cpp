@@ -0,0 +1,379 @@
+#include "SensorIngest.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+static const intptr_t INVALID_FD = -1;
+
+int64_t sensorClockNs()
+{
+    return (int64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+#ifdef _WIN32
+
+static intptr_t openFile(const std::string &path, bool for_write)
+{
+    if (path == "-")
+    {
+        int fd = for_write ? 1 : 0;
+        _setmode(fd, _O_BINARY);
+        return fd;
+    }
+    int flags = for_write ? (_O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY) : (_O_RDONLY | _O_BINARY);
+    return _open(path.c_str(), flags, 0644);
+}
+
+static void closeFd(intptr_t fd)
+{
+    _close((int)fd);
+}
+
+// Windows 下没有对管道可用的 poll, 读取直接阻塞
+static int waitReadable(intptr_t, int)
+{
+    return 1;
+}
+
+static long long readFd(intptr_t fd, void *buffer, size_t size)
+{
+    return _read((int)fd, buffer, (unsigned)size);
+}
+
+static long long writeFd(intptr_t fd, const void *data, size_t size)
+{
+    return _write((int)fd, data, (unsigned)size);
+}
+
+static bool isRetryable()
+{
+    return false;
+}
+
+#else
+
+static intptr_t openFile(const std::string &path, bool for_write)
+{
+    if (path == "-")
+        return for_write ? 1 : 0;
+    return for_write ? ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644) : ::open(path.c_str(), O_RDONLY);
+}
+
+static void closeFd(intptr_t fd)
+{
+    ::close((int)fd);
+}
+
+static int waitReadable(intptr_t fd, int timeout_ms)
+{
+    pollfd p;
+    p.fd = (int)fd;
+    p.events = POLLIN;
+    p.revents = 0;
+    int ready = poll(&p, 1, timeout_ms);
+    if (ready < 0)
+        return errno == EINTR ? 0 : -1;
+    return ready;
+}
+
+static long long readFd(intptr_t fd, void *buffer, size_t size)
+{
+    return ::read((int)fd, buffer, size);
+}
+
+static long long writeFd(intptr_t fd, const void *data, size_t size)
+{
+    return ::write((int)fd, data, size);
+}
+
+static bool isRetryable()
+{
+    return errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK;
+}
+
+#endif
+
+SensorFrameSource::SensorFrameSource(size_t buffer_frames)
+    : fd(INVALID_FD), owns_fd(false), eof(false), capacity(buffer_frames * sizeof(SensorFrame)), data_begin(0),
+      data_end(0), has_sequence(false), next_sequence(0)
+{
+    storage.resize((capacity + 7) / 8);
+    std::memset(&stats, 0, sizeof(stats));
+}
+
+SensorFrameSource::~SensorFrameSource()
+{
+    close();
+}
+
+bool SensorFrameSource::openPath(const std::string &path)
+{
+    close();
+    intptr_t f = openFile(path, false);
+    if (f < 0)
+        return false;
+    fd = f;
+    owns_fd = (path != "-");
+    return true;
+}
+
+#ifdef _WIN32
+
+bool SensorFrameSource::listenTcp(uint16_t)
+{
+    return false; // Windows 下只支持文件和管道输入
+}
+
+#else
+
+bool SensorFrameSource::listenTcp(uint16_t port)
+{
+    close();
+    int listener = socket(AF_INET, SOCK_STREAM, 0);
+    if (listener < 0)
+        return false;
+    int on = 1;
+    setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+
+    sockaddr_in local;
+    std::memset(&local, 0, sizeof(local));
+    local.sin_family = AF_INET;
+    local.sin_addr.s_addr = htonl(INADDR_ANY);
+    local.sin_port = htons(port);
+    if (bind(listener, (const sockaddr *)&local, sizeof(local)) != 0 || listen(listener, 1) != 0)
+    {
+        ::close(listener);
+        return false;
+    }
+
+    // 只服务一路输入: 接受第一个连接后关闭监听套接字
+    int conn = accept(listener, nullptr, nullptr);
+    ::close(listener);
+    if (conn < 0)
+        return false;
+    int buffer_size = 4 << 20;
+    setsockopt(conn, SOL_SOCKET, SO_RCVBUF, &buffer_size, sizeof(buffer_size));
+    fd = conn;
+    owns_fd = true;
+    return true;
+}
+
+#endif
+
+void SensorFrameSource::close()
+{
+    if (fd != INVALID_FD && owns_fd)
+        closeFd(fd);
+    fd = INVALID_FD;
+    owns_fd = false;
+    eof = false;
+    data_begin = data_end = 0;
+    has_sequence = false;
+}
+
+bool SensorFrameSource::isOpen() const
+{
+    return fd != INVALID_FD;
+}
+
+int SensorFrameSource::parse(const SensorFrame *&frames)
+{
+    unsigned char *base = (unsigned char *)storage.data();
+
+    // 帧头不合法时逐字节向后找下一个帧头
+    size_t resync_begin = data_begin;
+    while (data_end - data_begin >= sizeof(SENSOR_FRAME_MAGIC) &&
+           std::memcmp(base + data_begin, SENSOR_FRAME_MAGIC, sizeof(SENSOR_FRAME_MAGIC)) != 0)
+        data_begin++;
+    stats.skipped += data_begin - resync_begin;
+
+    // 重新同步后帧可能不再 8 字节对齐, 挪回缓冲区开头
+    if (data_begin % 8 != 0)
+    {
+        std::memmove(base, base + data_begin, data_end - data_begin);
+        data_end -= data_begin;
+        data_begin = 0;
+    }
+
+    const SensorFrame *first = (const SensorFrame *)(base + data_begin);
+    size_t available = (data_end - data_begin) / sizeof(SensorFrame);
+    size_t n = 0;
+    for (; n < available; n++)
+    {
+        const SensorFrame &f = first[n];
+        if (std::memcmp(f.magic, SENSOR_FRAME_MAGIC, sizeof(SENSOR_FRAME_MAGIC)) != 0)
+            break;
+        // 序号回退 (发送端重启) 不算缺帧
+        int32_t gap = (int32_t)(f.sequence - next_sequence);
+        if (has_sequence && gap > 0)
+            stats.missing += (uint64_t)gap;
+        has_sequence = true;
+        next_sequence = f.sequence + 1;
+    }
+
+    data_begin += n * sizeof(SensorFrame);
+    stats.frames += n;
+    frames = first;
+    return (int)n;
+}
+
+int SensorFrameSource::read(const SensorFrame *&frames, int timeout_ms)
+{
+    if (fd == INVALID_FD)
+        return -1;
+
+    // 上一次调用交出的帧已处理完, 把剩下的半帧挪到缓冲区开头
+    unsigned char *base = (unsigned char *)storage.data();
+    if (data_begin > 0)
+    {
+        std::memmove(base, base + data_begin, data_end - data_begin);
+        data_end -= data_begin;
+        data_begin = 0;
+    }
+
+    // 缓冲区里还有重新同步后留下的完整帧时先交出
+    int n = parse(frames);
+    if (n > 0)
+        return n;
+    if (eof)
+        return -1;
+
+    int ready = waitReadable(fd, timeout_ms);
+    if (ready <= 0)
+        return ready;
+
+    long long got = readFd(fd, base + data_end, capacity - data_end);
+    if (got < 0)
+        return isRetryable() ? 0 : -1;
+    stats.reads++;
+    if (got == 0)
+    {
+        eof = true;
+        return -1;
+    }
+    data_end += (size_t)got;
+    stats.bytes += (uint64_t)got;
+    return parse(frames);
+}
+
+SensorIngestStats SensorFrameSource::getStats() const
+{
+    return stats;
+}
+
+SensorFrameSink::SensorFrameSink() : fd(INVALID_FD), owns_fd(false)
+{
+}
+
+SensorFrameSink::~SensorFrameSink()
+{
+    close();
+}
+
+bool SensorFrameSink::openPath(const std::string &path)
+{
+    close();
+    intptr_t f = openFile(path, true);
+    if (f < 0)
+        return false;
+    fd = f;
+    owns_fd = (path != "-");
+    return true;
+}
+
+#ifdef _WIN32
+
+bool SensorFrameSink::connectTcp(const std::string &, uint16_t)
+{
+    return false;
+}
+
+#else
+
+bool SensorFrameSink::connectTcp(const std::string &host, uint16_t port)
+{
+    close();
+    addrinfo hints;
+    std::memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    char port_text[8];
+    std::snprintf(port_text, sizeof(port_text), "%u", (unsigned)port);
+    addrinfo *result = nullptr;
+    if (getaddrinfo(host.c_str(), port_text, &hints, &result) != 0 || !result)
+        return false;
+
+    int s = socket(result->ai_family, SOCK_STREAM, 0);
+    bool ok = s >= 0 && connect(s, result->ai_addr, result->ai_addrlen) == 0;
+    freeaddrinfo(result);
+    if (!ok)
+    {
+        if (s >= 0)
+            ::close(s);
+        return false;
+    }
+
+    // 每批帧立即发出, 不等 Nagle 合包
+    int on = 1;
+    setsockopt(s, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+    fd = s;
+    owns_fd = true;
+    return true;
+}
+
+#endif
+
+void SensorFrameSink::close()
+{
+    if (fd != INVALID_FD && owns_fd)
+        closeFd(fd);
+    fd = INVALID_FD;
+    owns_fd = false;
+}
+
+bool SensorFrameSink::isOpen() const
+{
+    return fd != INVALID_FD;
+}
+
+bool SensorFrameSink::write(SensorFrame *frames, int count)
+{
+    if (fd == INVALID_FD)
+        return false;
+
+    int64_t now = sensorClockNs();
+    for (int i = 0; i < count; i++)
+        frames[i].send_ns = now;
+
+    const unsigned char *p = (const unsigned char *)frames;
+    size_t left = count * sizeof(SensorFrame);
+    while (left > 0)
+    {
+        long long n = writeFd(fd, p, left);
+        if (n < 0)
+        {
+            if (isRetryable())
+                continue;
+            return false;
+        }
+        p += n;
+        left -= (size_t)n;
+    }
+    return true;
+}
@@ -0,0 +1,127 @@
+#pragma once
+#include "DataStructrue.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// 外部传感器帧输入: 用真实或录制的传感器数据代替 Simulator 驱动 EICAS
+// 帧为 80 字节定长二进制格式, 小端存储, 经管道 / 文件 / TCP 字节流连续发送
+// 接收端在读缓冲区内就地解析, 调用方直接拿到指向缓冲区的帧指针, 不做逐帧拷贝
+
+const char SENSOR_FRAME_MAGIC[4] = {'E', 'N', 'G', 'F'};
+
+struct SensorFrame
+{
+    char magic[4];
+    uint16_t validity; // packSensorValidity 格式
+    uint8_t state;     // EngineState
+    uint8_t reserved0;
+    uint32_t sequence; // 帧序号, 连续递增, 接收端据此统计缺帧
+    uint32_t reserved1;
+    double time;     // 采样时刻 (秒), 用于告警显示计时
+    int64_t send_ns; // 发送端写出时的单调时钟 (sensorClockNs), 用于测量输入到告警的延迟
+    // rpm_1, rpm_2, egt1_temp, egt2_temp, fuel_v, fuel_c (与 CSV 列顺序一致)
+    double values[6];
+};
+
+static_assert(sizeof(SensorFrame) == 80, "SensorFrame must be 80 bytes");
+
+// 单调时钟 (纳秒); 同一台机器上的不同进程取值可直接比较
+int64_t sensorClockNs();
+
+inline SensorFrame makeSensorFrame(uint32_t sequence, double time, const EngineSnapshot &data, EngineState state)
+{
+    SensorFrame f;
+    for (int i = 0; i < 4; i++)
+        f.magic[i] = SENSOR_FRAME_MAGIC[i];
+    f.validity = packSensorValidity(data);
+    f.state = (uint8_t)state;
+    f.reserved0 = 0;
+    f.sequence = sequence;
+    f.reserved1 = 0;
+    f.time = time;
+    f.send_ns = 0;
+    f.values[0] = data.rpm_1;
+    f.values[1] = data.rpm_2;
+    f.values[2] = data.egt1_temp;
+    f.values[3] = data.egt2_temp;
+    f.values[4] = data.fuel_v;
+    f.values[5] = data.fuel_c;
+    return f;
+}
+
+inline void sensorFrameToSnapshot(const SensorFrame &f, EngineSnapshot &data)
+{
+    data.rpm_1 = f.values[0];
+    data.rpm_2 = f.values[1];
+    data.egt1_temp = f.values[2];
+    data.egt2_temp = f.values[3];
+    data.fuel_v = f.values[4];
+    data.fuel_c = f.values[5];
+    unpackSensorValidity(f.validity, data);
+}
+
+struct SensorIngestStats
+{
+    uint64_t frames;  // 解析出的有效帧
+    uint64_t bytes;   // 读入的字节数
+    uint64_t skipped; // 帧头不合法时为重新同步而跳过的字节数
+    uint64_t missing; // 帧序号缺口
+    uint64_t reads;   // read 系统调用次数
+};
+
+// 传感器帧输入源: 文件、命名管道、标准输入或一条 TCP 连接 (本端监听, 接受第一个连接)
+class SensorFrameSource
+{
+public:
+    explicit SensorFrameSource(size_t buffer_frames = 4096);
+    ~SensorFrameSource();
+
+    // path 为 "-" 时读标准输入
+    bool openPath(const std::string &path);
+    bool listenTcp(uint16_t port);
+    void close();
+    bool isOpen() const;
+
+    // 最多等待 timeout_ms 毫秒, 返回本次读到的完整帧数; frames 指向内部缓冲区, 到下一次调用前有效
+    // 超时返回 0, 输入结束或出错返回 -1
+    int read(const SensorFrame *&frames, int timeout_ms);
+
+    SensorIngestStats getStats() const;
+
+private:
+    int parse(const SensorFrame *&frames);
+
+    intptr_t fd;
+    bool owns_fd;
+    bool eof;
+    std::vector<uint64_t> storage; // 8 字节对齐, 帧内的 double 可直接访问
+    size_t capacity;
+    size_t data_begin;
+    size_t data_end;
+    bool has_sequence;
+    uint32_t next_sequence;
+    SensorIngestStats stats;
+};
+
+// 传感器帧输出端, 供帧发生器和测试使用
+class SensorFrameSink
+{
+public:
+    SensorFrameSink();
+    ~SensorFrameSink();
+
+    // path 为 "-" 时写标准输出
+    bool openPath(const std::string &path);
+    bool connectTcp(const std::string &host, uint16_t port);
+    void close();
+    bool isOpen() const;
+
+    // 阻塞写出 count 帧, 写出前把每帧的 send_ns 填为当前时刻; 对端关闭时返回 false
+    bool write(SensorFrame *frames, int count);
+
+private:
+    intptr_t fd;
+    bool owns_fd;
+};
@@ -0,0 +1,127 @@
+#include "SimJob.h"
+#include "TaskScheduler.h"
+
+static const double SIM_DT = 0.005;
+
+SimJob::SimJob(const SimJobSpec &spec) : spec(spec)
+{
+    result.steps = 0;
+    result.end_time = 0.0;
+    result.end_state = EngineState::OFF;
+    result.alerts_raised = 0;
+    result.auto_shutdowns = 0;
+    result.slices = 0;
+    result.migrations = 0;
+
+    step = 0;
+    total_steps = (uint64_t)(spec.duration / SIM_DT + 0.5);
+    last_worker = -1;
+    finished = false;
+
+    if (!spec.log_path.empty())
+        logger.reset(new Logger(spec.log_path, spec.log_format));
+
+    sim.seed(spec.seed);
+    sim.startEngine();
+}
+
+bool SimJob::runSlice(uint64_t max_steps, int worker)
+{
+    if (finished)
+        return true;
+
+    result.slices++;
+    if (last_worker >= 0 && worker >= 0 && worker != last_worker)
+        result.migrations++;
+    last_worker = worker;
+
+    const uint64_t fault_step = (uint64_t)(spec.fault_at / SIM_DT + 0.5);
+    uint64_t slice_end = step + max_steps;
+    if (slice_end > total_steps)
+        slice_end = total_steps;
+
+    while (step < slice_end)
+    {
+        if (spec.fault != ErrorType::NONE && step == fault_step)
+            sim.setErrorType(spec.fault);
+
+        step++;
+        double t = step * SIM_DT;
+
+        sim.update();
+        EngineState state = sim.getState();
+        const EngineSnapshot &data = sim.getSnapshot();
+        if (logger)
+            logger->log(t, data, state);
+
+        // 告警与自动停车的日志与 Headless / SimThread 相同: 每次判断记录检出的全部告警, 由 Logger 做 5 秒去重
+        uint32_t shown_before = eicas.getActiveMask();
+        ErrorType detected_errors[ERROR_TYPE_COUNT];
+        int detected_count = eicas.judge(data, state, t, detected_errors, ERROR_TYPE_COUNT);
+        result.alerts_raised += countErrorBits(eicas.getActiveMask() & ~shown_before);
+
+        // 自动停车保护逻辑 (与 main.cpp 相同)
+        if (EICAS::hasCritical(eicas.getActiveMask()) && state != EngineState::OFF && state != EngineState::STOPPING)
+        {
+            sim.stopEngine();
+            if (logger)
+                logger->logAlert(t, "SYSTEM: AUTO SHUTDOWN TRIGGERED");
+            result.auto_shutdowns++;
+        }
+
+        for (int i = 0; logger && i < detected_count; i++)
+            logger->logAlert(t, EICAS::getErrorMessage(detected_errors[i]));
+
+        // 燃油耗尽且已完全停车, 后续只是静止状态, 提前结束
+        if (state == EngineState::OFF && data.fuel_c <= 0.0)
+        {
+            finished = true;
+            break;
+        }
+    }
+
+    result.steps = step;
+    result.end_time = step * SIM_DT;
+    result.end_state = sim.getState();
+
+    if (step >= total_steps)
+        finished = true;
+    if (finished)
+        logger.reset(); // 关闭日志文件
+    return finished;
+}
+
+bool SimJob::isFinished() const
+{
+    return finished;
+}
+
+const SimJobSpec &SimJob::getSpec() const
+{
+    return spec;
+}
+
+const SimJobResult &SimJob::getResult() const
+{
+    return result;
+}
+
+static void runSimJobSlice(TaskScheduler &scheduler, std::shared_ptr<SimJob> job, uint64_t checkpoint_steps,
+                           int worker)
+{
+    if (job->runSlice(checkpoint_steps, worker))
+        return;
+    // 到达检查点: 把剩余部分放到本线程队列的窃取端, 本线程先处理其他任务, 空闲线程可接手
+    scheduler.yield(worker, [&scheduler, job, checkpoint_steps](int w) {
+        runSimJobSlice(scheduler, job, checkpoint_steps, w);
+    });
+}
+
+void scheduleSimJob(TaskScheduler &scheduler, std::shared_ptr<SimJob> job, uint64_t checkpoint_steps)
+{
+    if (checkpoint_steps == 0)
+        checkpoint_steps = ~(uint64_t)0;
+    scheduler.submit([&scheduler, job, checkpoint_steps](int w) {
+        runSimJobSlice(scheduler, job, checkpoint_steps, w);
+    });
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include "DataStructrue.h"
+#include "EICAS.h"
+#include "Logger.h"
+#include "Simulator.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+
+class TaskScheduler;
+
+// 一次长时间仿真任务的设置
+struct SimJobSpec
+{
+    uint64_t seed;
+    double duration;      // 最长仿真时长 (秒); 燃油耗尽停车后提前结束
+    ErrorType fault;      // 注入的故障, NONE 表示不注入
+    double fault_at;      // 故障注入时刻 (秒)
+    std::string log_path; // 日志文件, 为空时不写日志
+    LogFormat log_format;
+};
+
+struct SimJobResult
+{
+    uint64_t steps;
+    double end_time;
+    EngineState end_state;
+    int alerts_raised;   // 新出现的告警消息次数
+    int auto_shutdowns;  // 自动停车保护触发次数
+    int slices;          // 在检查点分段执行的次数
+    int migrations;      // 相邻两段在不同工作线程上执行的次数
+};
+
+// Simulator -> EICAS -> Logger 的完整仿真任务, 可分段推进;
+// 两段之间的全部状态都保存在对象内, 下一段可以在任意线程上继续
+class SimJob
+{
+public:
+    explicit SimJob(const SimJobSpec &spec);
+
+    // 最多推进 max_steps 步, 到达检查点或任务结束时返回; 返回 true 表示任务已结束
+    bool runSlice(uint64_t max_steps, int worker = -1);
+
+    bool isFinished() const;
+    const SimJobSpec &getSpec() const;
+    const SimJobResult &getResult() const;
+
+private:
+    SimJobSpec spec;
+    SimJobResult result;
+
+    Simulator sim;
+    EICAS eicas;
+    std::unique_ptr<Logger> logger;
+
+    uint64_t step;
+    uint64_t total_steps;
+    int last_worker;
+    bool finished;
+};
+
+// 提交到调度器: 每 checkpoint_steps 步在检查点让出, 剩余部分重新入队, 可被空闲线程窃取继续执行
+void scheduleSimJob(TaskScheduler &scheduler, std::shared_ptr<SimJob> job, uint64_t checkpoint_steps);
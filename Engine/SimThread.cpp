@@ -0,0 +1,255 @@
+#include "SimThread.h"
+#include "EICASBatch.h"
+#include "Trace.h"
+
+static void clearSnapshot(SimSnapshot &snap)
+{
+    snap.time = 0.0;
+    snap.data = EngineSnapshot();
+    snap.state = EngineState::OFF;
+    snap.stabilized = false;
+    snap.n1 = 0.0;
+    snap.n2 = 0.0;
+    snap.alert_count = 0;
+    snap.steps = 0;
+    snap.sequence = 0;
+}
+
+SimThread::SimThread(Simulator &sim, EICAS &eicas, Logger &logger, double step)
+    : sim(sim), eicas(eicas), logger(logger), timer(step), fixed_dt(step), commands(256), running(false),
+      detected_count(0), total_steps(0), sequence(0), profiler(nullptr), telemetry(nullptr), stream(nullptr)
+{
+    // 首帧之前界面也能读到合法数据
+    clearSnapshot(snapshots.writeBuffer());
+    publish();
+    snapshots.update();
+}
+
+SimThread::~SimThread()
+{
+    stop();
+}
+
+void SimThread::start()
+{
+    if (running.load())
+        return;
+    running.store(true);
+    worker = std::thread(&SimThread::run, this);
+}
+
+void SimThread::stop()
+{
+    running.store(false);
+    if (worker.joinable())
+        worker.join();
+}
+
+bool SimThread::sendCommand(SimCommandType type, ErrorType fault)
+{
+    SimCommand cmd;
+    cmd.type = type;
+    cmd.fault = fault;
+    return commands.tryPush(cmd);
+}
+
+bool SimThread::updateSnapshot()
+{
+    return snapshots.update();
+}
+
+const SimSnapshot &SimThread::getSnapshot() const
+{
+    return snapshots.readBuffer();
+}
+
+void SimThread::setProfiler(Profiler *value)
+{
+    profiler = value;
+}
+
+void SimThread::setTelemetry(TelemetryPublisher *publisher)
+{
+    telemetry = publisher;
+}
+
+void SimThread::setStream(TelemetrySender *sender)
+{
+    stream = sender;
+}
+
+PacingStats SimThread::getPacingStats() const
+{
+    return timer.getPacingStats();
+}
+
+void SimThread::applyCommand(const SimCommand &cmd)
+{
+    switch (cmd.type)
+    {
+    case SimCommandType::START:
+        sim.startEngine();
+        break;
+    case SimCommandType::STOP:
+        sim.stopEngine();
+        break;
+    case SimCommandType::ADD_DASH:
+        sim.addDash();
+        break;
+    case SimCommandType::REDUCE_DASH:
+        sim.reduceDash();
+        break;
+    case SimCommandType::SET_FAULT:
+        sim.setErrorType(cmd.fault);
+        break;
+    }
+}
+
+void SimThread::publish()
+{
+    SimSnapshot &snap = snapshots.writeBuffer();
+    snap.time = total_steps * fixed_dt;
+    snap.data = sim.getSnapshot();
+    snap.state = sim.getState();
+    snap.stabilized = sim.isStabilized();
+    snap.n1 = sim.getN1();
+    snap.n2 = sim.getN2();
+    for (int i = 0; i < detected_count; i++)
+        snap.alerts[i] = detected_errors[i];
+    snap.alert_count = detected_count;
+    snap.steps = total_steps;
+    snap.sequence = ++sequence;
+    snapshots.publish();
+}
+
+void SimThread::runCycle(int step_count)
+{
+    TRACE_SCOPE("sim", "cycle");
+    PhaseTimer phases(profiler);
+
+    SimCommand cmd_batch[16];
+    size_t n;
+    uint64_t command_count = 0;
+    while ((n = commands.popBatch(cmd_batch, 16)) > 0)
+    {
+        for (size_t i = 0; i < n; i++)
+            applyCommand(cmd_batch[i]);
+        command_count += n;
+    }
+    phases.mark(ProfilePhase::SIM_COMMANDS);
+
+    {
+        TRACE_SCOPE("sim", "update_batch");
+        for (int k = 0; k < step_count; k++)
+        {
+            sim.update();
+            total_steps++;
+            logger.log(total_steps * fixed_dt, sim.getSnapshot(), sim.getState());
+
+            // 本周期的最后一步在判断之后发布, 带上本步的告警; 之前的步带上一次判断的告警,
+            // 并逐步采样原始故障, 使只持续一步的越限也能在本周期的判断中显示
+            if (k + 1 < step_count)
+            {
+                eicas.sample(sim.getSnapshot(), sim.getState());
+                if (telemetry)
+                    telemetry->publish(total_steps * fixed_dt, sim.getSnapshot(), sim.getState(), eicas.getActiveMask());
+                if (stream)
+                    stream->push(total_steps * fixed_dt, sim.getSnapshot(), sim.getState(), eicas.getActiveMask());
+            }
+        }
+    }
+    phases.mark(ProfilePhase::SIM_STEPS);
+
+    const EngineSnapshot &raw_data = sim.getSnapshot();
+    EngineState eng_state = sim.getState();
+    double t = total_steps * fixed_dt;
+    bool auto_shutdown = false;
+
+    {
+        TRACE_SCOPE("eicas", "judge");
+#ifdef ENGINE_ENABLE_TRACING
+        uint32_t shown_before = eicas.getActiveMask();
+#endif
+        detected_count = eicas.judge(raw_data, eng_state, t, detected_errors, ERROR_TYPE_COUNT);
+#ifdef ENGINE_ENABLE_TRACING
+        ErrorType raised[ERROR_TYPE_COUNT];
+        int raised_count = expandAlertMask(eicas.getActiveMask() & ~shown_before, raised);
+        for (int i = 0; i < raised_count; i++)
+            TRACE_INSTANT("eicas", "alert_raised", EICAS::getErrorMessage(raised[i]));
+#endif
+
+        // 自动停车保护逻辑
+        if (EICAS::hasCritical(eicas.getActiveMask()))
+        {
+            if (eng_state != EngineState::OFF && eng_state != EngineState::STOPPING)
+            {
+                sim.stopEngine();
+                auto_shutdown = true;
+                TRACE_INSTANT("sim", "auto_shutdown", nullptr);
+            }
+        }
+    }
+    phases.mark(ProfilePhase::SIM_JUDGE);
+
+    {
+        TRACE_SCOPE("log", "alerts");
+        if (auto_shutdown)
+            logger.logAlert(t, "SYSTEM: AUTO SHUTDOWN TRIGGERED");
+        for (int i = 0; i < detected_count; i++)
+            logger.logAlert(t, EICAS::getErrorMessage(detected_errors[i]));
+    }
+    phases.mark(ProfilePhase::SIM_ALERT_LOG);
+
+    publish();
+    if (telemetry && step_count > 0)
+        telemetry->publish(t, raw_data, eng_state, eicas.getActiveMask());
+    if (stream && step_count > 0)
+        stream->push(t, raw_data, eng_state, eicas.getActiveMask());
+    phases.mark(ProfilePhase::SIM_PUBLISH);
+    phases.total(ProfilePhase::SIM_CYCLE);
+
+    if (profiler)
+    {
+        profiler->add(ProfileCounter::SIM_CYCLES);
+        profiler->add(ProfileCounter::SIM_STEPS, (uint64_t)step_count);
+        profiler->add(ProfileCounter::COMMANDS, command_count);
+        profiler->add(ProfileCounter::ALERTS_LOGGED, (uint64_t)detected_count + (auto_shutdown ? 1 : 0));
+        profiler->recordStepsPerCycle((uint64_t)step_count);
+    }
+}
+
+void SimThread::run()
+{
+    TRACE_THREAD_NAME("sim");
+    timer.reset();
+    // 晚醒的时间由累积池在下一周期补上, 不需要亚毫秒级的唤醒精度; 只留很小的忙等余量, 不在每步空转 2ms
+    timer.setPacing(true, 0.0002);
+    uint64_t dropped = 0;
+
+    while (running.load(std::memory_order_relaxed))
+    {
+        timer.tick();
+
+        int step_count = 0;
+        while (timer.consumeStep())
+            step_count++;
+
+        runCycle(step_count);
+
+        if (profiler)
+        {
+            uint64_t now_dropped = timer.getDroppedSteps();
+            if (now_dropped != dropped)
+                profiler->add(ProfileCounter::STEPS_DROPPED, now_dropped - dropped);
+            dropped = now_dropped;
+        }
+
+        int64_t late;
+        {
+            TRACE_SCOPE("sim", "wait");
+            late = timer.waitNextStep();
+        }
+        if (late >= 0 && profiler && profiler->isEnabled())
+            profiler->record(ProfilePhase::SIM_LATE, (uint64_t)late);
+    }
+}
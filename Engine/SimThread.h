@@ -0,0 +1,106 @@
+#pragma once
+#include "DataStructrue.h"
+#include "EICAS.h"
+#include "Logger.h"
+#include "Profiler.h"
+#include "Simulator.h"
+#include "SpscRing.h"
+#include "TelemetryShm.h"
+#include "TelemetryStream.h"
+#include "Timer.h"
+#include "TripleBuffer.h"
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+// 界面线程发往仿真线程的操作
+enum class SimCommandType
+{
+    START,
+    STOP,
+    ADD_DASH,
+    REDUCE_DASH,
+    SET_FAULT,
+};
+
+struct SimCommand
+{
+    SimCommandType type;
+    ErrorType fault; // SET_FAULT 时有效
+};
+
+// 仿真线程每个周期发布一次的完整状态, 界面只读这份数据绘制
+struct SimSnapshot
+{
+    double time;
+    EngineSnapshot data;
+    EngineState state;
+    bool stabilized;
+    double n1;
+    double n2;
+    ErrorType alerts[ERROR_TYPE_COUNT]; // 当前显示的告警, 按出现顺序
+    int alert_count;
+    uint64_t steps;    // 累计仿真步数
+    uint64_t sequence; // 发布序号
+};
+
+// 独立的定步长仿真线程: Simulator / EICAS / Logger 只在该线程上访问,
+// 状态经三缓冲发布给界面线程, 界面操作经无锁队列送回, 绘制快慢不影响仿真计时
+class SimThread
+{
+public:
+    SimThread(Simulator &sim, EICAS &eicas, Logger &logger, double step = 0.005);
+    ~SimThread();
+
+    void start();
+    void stop();
+
+    // 界面线程调用, 队列满时丢弃并返回 false
+    bool sendCommand(SimCommandType type, ErrorType fault = ErrorType::NONE);
+
+    // 界面线程调用: 取最新的快照, 不阻塞; 返回是否有新快照
+    bool updateSnapshot();
+    const SimSnapshot &getSnapshot() const;
+
+    // 在 start() 之前设置; 为空时不做统计
+    void setProfiler(Profiler *profiler);
+
+    // 在 start() 之前设置; 每个仿真步的数据和告警位掩码发布到共享内存, 为空时不发布
+    void setTelemetry(TelemetryPublisher *publisher);
+
+    // 在 start() 之前设置; 每个仿真步的数据和告警位掩码按数据报批量发往远程显示, 为空时不发送
+    void setStream(TelemetrySender *sender);
+
+    // stop() 之后读取仿真线程的节拍统计
+    PacingStats getPacingStats() const;
+
+    // 仿真线程的一个周期: 处理操作, 推进 step_count 步并写日志 (每步采样越限), 判断告警, 发布快照;
+    // 未调用 start() 时可在调用线程上直接驱动 (无界面运行和基准测试)
+    void runCycle(int step_count);
+
+private:
+    void run();
+    void applyCommand(const SimCommand &cmd);
+    void publish();
+
+    Simulator &sim;
+    EICAS &eicas;
+    Logger &logger;
+    Timer timer;
+    const double fixed_dt;
+
+    SpscRing<SimCommand> commands;
+    TripleBuffer<SimSnapshot> snapshots;
+
+    std::thread worker;
+    std::atomic<bool> running;
+
+    ErrorType detected_errors[ERROR_TYPE_COUNT];
+    int detected_count;
+    uint64_t total_steps;
+    uint64_t sequence;
+
+    Profiler *profiler;
+    TelemetryPublisher *telemetry;
+    TelemetrySender *stream;
+};
@@ -1,6 +1,5 @@
 #include "Simulator.h"
 #include <cmath>
-#include <cstdlib>
 
 Simulator::Simulator()
 {
@@ -10,15 +9,17 @@ Simulator::Simulator()
     n1 = 0;
     n2 = 0;
 
-    // ʼ
+    // 初始化引擎数据
+    eng_data = EngineSnapshot();
     eng_data.rpm_1 = 0;
     eng_data.rpm_2 = 0;
     eng_data.egt1_temp = 20;
     eng_data.egt2_temp = 20;
     eng_data.fuel_v = 0;
     eng_data.fuel_c = 20000;
+    unpackSensorValidity(SENSOR_VALID_ALL, eng_data);
 
-    // ʼֵ
+    // 初始化物理真值
     real_fuel_c = 20000.0;
     real_fuel_v = 0.0;
     real_rpm_1 = 0.0;
@@ -44,7 +45,7 @@ void Simulator::stopEngine()
     {
         current_state = EngineState::STOPPING;
         phase_timer = 0.0;
-        // ¼ֹͣǰ״̬׼
+        // 记录停止前的状态基准
         record_n = real_rpm_1;
         record_egt = real_egt1;
     }
@@ -52,18 +53,21 @@ void Simulator::stopEngine()
 
 void Simulator::update()
 {
+    // 本步的扰动值在步首取出, 与 FleetSimulator 批量取数的顺序一致
+    double noise = (current_state == EngineState::RUNNING) ? rng.nextNoise() : 0.0;
+
     if (current_state == EngineState::STARTING || current_state == EngineState::STOPPING)
     {
         phase_timer += dt;
     }
 
-    // ȼ
+    // 消耗燃油
     if (real_fuel_c > 0)
     {
         real_fuel_c -= real_fuel_v * dt;
     }
 
-    // ȼͺľͣ
+    // 燃油耗尽导致停车
     if (real_fuel_c <= 0.0 && current_state != EngineState::STOPPING && current_state != EngineState::OFF)
     {
         real_fuel_c = 0.0;
@@ -103,8 +107,6 @@ void Simulator::update()
 
     case EngineState::RUNNING:
     {
-        double noise = (rand() % 600 - 300) / 10000.0;
-
         real_rpm_1 = record_n * (1.0 + noise);
         real_rpm_2 = real_rpm_1;
         real_egt1 = record_egt * (1.0 + noise);
@@ -140,7 +142,7 @@ void Simulator::update()
         break;
     }
 
-    // ֵͬ
+    // 将真值同步给传感器数据
     eng_data.fuel_c = real_fuel_c;
     eng_data.fuel_v = real_fuel_v;
     eng_data.rpm_1 = real_rpm_1;
@@ -151,50 +153,42 @@ void Simulator::update()
     n1 = (eng_data.rpm_1 / max_rpm) * 100.0;
     n2 = (eng_data.rpm_2 / max_rpm) * 100.0;
 
-    // ĬϴΪ
-    eng_data.is_n_sensor_valid[0] = true;
-    eng_data.is_n_sensor_valid[1] = true;
-    eng_data.is_n_sensor_valid[2] = true;
-    eng_data.is_n_sensor_valid[3] = true;
-    eng_data.is_egt_sensor_valid[0] = true;
-    eng_data.is_egt_sensor_valid[1] = true;
-    eng_data.is_egt_sensor_valid[2] = true;
-    eng_data.is_egt_sensor_valid[3] = true;
-    eng_data.is_fuel_valid = true;
+    // 默认传感器为正常
+    unpackSensorValidity(SENSOR_VALID_ALL, eng_data);
 
-    // ע
+    // 注入故障
     switch (error_type)
     {
     case ErrorType::NONE:
         break;
     case ErrorType::SENSOR_N_ONE:
-        eng_data.is_n_sensor_valid[0] = false;
+        eng_data.setNSensorValid(0, false);
         break;
     case ErrorType::SENSOR_N_TWO:
         eng_data.rpm_1 = -1.0;
         n1 = -0.0;
-        eng_data.is_n_sensor_valid[0] = false;
-        eng_data.is_n_sensor_valid[1] = false;
+        eng_data.setNSensorValid(0, false);
+        eng_data.setNSensorValid(1, false);
         break;
     case ErrorType::SENSOR_EGT_ONE:
-        eng_data.is_egt_sensor_valid[0] = false;
+        eng_data.setEgtSensorValid(0, false);
         break;
     case ErrorType::SENSOR_EGT_TWO:
         eng_data.egt1_temp = -50.0;
-        eng_data.is_egt_sensor_valid[0] = false;
-        eng_data.is_egt_sensor_valid[1] = false;
+        eng_data.setEgtSensorValid(0, false);
+        eng_data.setEgtSensorValid(1, false);
         break;
     case ErrorType::SENSOR_ALL:
         eng_data.egt1_temp = -500.0;
         eng_data.egt2_temp = -500.0;
-        eng_data.is_egt_sensor_valid[0] = false;
-        eng_data.is_egt_sensor_valid[1] = false;
-        eng_data.is_egt_sensor_valid[2] = false;
-        eng_data.is_egt_sensor_valid[3] = false;
+        eng_data.setEgtSensorValid(0, false);
+        eng_data.setEgtSensorValid(1, false);
+        eng_data.setEgtSensorValid(2, false);
+        eng_data.setEgtSensorValid(3, false);
         break;
     case ErrorType::SENSOR_FUEL:
         eng_data.fuel_c = -0.0;
-        eng_data.is_fuel_valid = false;
+        eng_data.fuel_valid = 0;
         break;
     case ErrorType::OVERSPEED_N1_1:
         eng_data.rpm_1 = 42400.0;
@@ -232,7 +226,7 @@ void Simulator::addDash()
     if (current_state == EngineState::RUNNING)
     {
         record_fuel_v += 1.0;
-        double jump = 0.03 + (rand() % 201) / 10000.0;
+        double jump = rng.nextDashJump();
         record_n = record_n * (1.0 + jump);
         record_egt = record_egt * (1.0 + jump);
         if (record_n > 50000)
@@ -247,7 +241,7 @@ void Simulator::reduceDash()
         record_fuel_v -= 1.0;
         if (record_fuel_v < 0)
             record_fuel_v = 0;
-        double jump = 0.03 + (rand() % 201) / 10000.0;
+        double jump = rng.nextDashJump();
         record_n = record_n * (1.0 - jump);
         record_egt = record_egt * (1.0 - jump);
         if (record_n < 0)
@@ -267,6 +261,11 @@ EngineState Simulator::getState()
 }
 
 EngineData Simulator::getData()
+{
+    return toEngineData(eng_data);
+}
+
+const EngineSnapshot &Simulator::getSnapshot() const
 {
     return eng_data;
 }
@@ -284,4 +283,9 @@ double Simulator::getN2()
 void Simulator::setErrorType(ErrorType type)
 {
     error_type = type;
+}
+
+void Simulator::seed(uint64_t seed_value)
+{
+    rng.seed(seed_value);
 }
\ No newline at end of file
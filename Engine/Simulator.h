@@ -1,12 +1,13 @@
 #pragma once
 #include "DataStructrue.h"
+#include "Random.h"
 #include <cmath>
 #include <ctime>
 
 class Simulator
 {
 private:
-    EngineData eng_data;
+    EngineSnapshot eng_data;
     double phase_timer;
     EngineState current_state;
     ErrorType error_type;
@@ -18,7 +19,7 @@ private:
     double record_egt;
     double record_fuel_v;
 
-    // ֵ
+    // 物理真值变量
     double real_fuel_c;
     double real_fuel_v;
     double real_rpm_1;
@@ -26,8 +27,11 @@ private:
     double real_egt1;
     double real_egt2;
 
-    const double max_rpm = 40000.0;
-    const double dt = 0.005;
+    static constexpr double max_rpm = 40000.0;
+    static constexpr double dt = 0.005;
+
+    // 本实例的随机数发生器
+    Random rng;
 
 public:
     Simulator();
@@ -41,6 +45,11 @@ public:
     double getN1();
     double getN2();
     void setErrorType(ErrorType type);
+    // 设置随机数种子, 相同种子和操作序列得到相同的仿真结果
+    void seed(uint64_t seed_value);
     EngineState getState();
+    // 当前传感器数据, 不复制; 仿真和判断的热路径使用
+    const EngineSnapshot &getSnapshot() const;
+    // 转换为带告警字符串的完整结构
     EngineData getData();
 };
\ No newline at end of file
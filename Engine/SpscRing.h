@@ -0,0 +1,83 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+// 单生产者单消费者无锁环形缓冲区, 容量取 2 的整数次幂
+// 生产者与消费者的下标分别位于独立的缓存行, 避免伪共享
+template <typename T> class SpscRing
+{
+public:
+    explicit SpscRing(size_t min_capacity)
+    {
+        size_t cap = 2;
+        while (cap < min_capacity)
+            cap <<= 1;
+        slots.resize(cap);
+        mask = cap - 1;
+        head.store(0, std::memory_order_relaxed);
+        tail.store(0, std::memory_order_relaxed);
+        cached_head = 0;
+        cached_tail = 0;
+    }
+
+    // 生产者线程调用, 缓冲区满时返回 false
+    bool tryPush(const T &item)
+    {
+        size_t h = head.load(std::memory_order_relaxed);
+        if (h - cached_tail > mask)
+        {
+            cached_tail = tail.load(std::memory_order_acquire);
+            if (h - cached_tail > mask)
+                return false;
+        }
+        slots[h & mask] = item;
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 消费者线程调用, 一次取出最多 max_count 个元素
+    size_t popBatch(T *out, size_t max_count)
+    {
+        size_t t = tail.load(std::memory_order_relaxed);
+        if (cached_head == t)
+        {
+            cached_head = head.load(std::memory_order_acquire);
+            if (cached_head == t)
+                return 0;
+        }
+        size_t n = cached_head - t;
+        if (n > max_count)
+            n = max_count;
+        for (size_t i = 0; i < n; i++)
+            out[i] = slots[(t + i) & mask];
+        tail.store(t + n, std::memory_order_release);
+        return n;
+    }
+
+    bool tryPop(T &out)
+    {
+        return popBatch(&out, 1) == 1;
+    }
+
+    // 近似占用量, 任意线程可调用
+    size_t size() const
+    {
+        return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire);
+    }
+
+    size_t capacity() const
+    {
+        return mask + 1;
+    }
+
+private:
+    std::vector<T> slots;
+    size_t mask;
+
+    alignas(64) std::atomic<size_t> head; // 下一个写入位置 (生产者)
+    size_t cached_tail;                   // 生产者缓存的读位置
+
+    alignas(64) std::atomic<size_t> tail; // 下一个读取位置 (消费者)
+    size_t cached_head;                   // 消费者缓存的写位置
+};
@@ -0,0 +1,157 @@
+#include "TaskScheduler.h"
+
+TaskScheduler::TaskScheduler(int worker_count) : pending(0), shutting_down(false), next_submit(0)
+{
+    if (worker_count < 1)
+        worker_count = 1;
+
+    for (int i = 0; i < worker_count; i++)
+    {
+        workers.emplace_back(new Worker);
+        workers.back()->tasks_run = 0;
+        workers.back()->tasks_stolen = 0;
+        workers.back()->busy_ns = 0;
+    }
+    stats_start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < worker_count; i++)
+        threads.emplace_back(&TaskScheduler::workerLoop, this, i);
+}
+
+TaskScheduler::~TaskScheduler()
+{
+    wait();
+    shutting_down.store(true);
+    idle_cv.notify_all();
+    for (auto &t : threads)
+        t.join();
+}
+
+int TaskScheduler::getWorkerCount() const
+{
+    return (int)workers.size();
+}
+
+void TaskScheduler::push(int index, Task task, bool to_bottom)
+{
+    pending.fetch_add(1);
+    {
+        std::lock_guard<std::mutex> guard(workers[index]->lock);
+        if (to_bottom)
+            workers[index]->tasks.push_back(std::move(task));
+        else
+            workers[index]->tasks.push_front(std::move(task));
+    }
+    idle_cv.notify_one();
+}
+
+void TaskScheduler::submit(Task task)
+{
+    int index = (int)(next_submit.fetch_add(1) % workers.size());
+    push(index, std::move(task), true);
+}
+
+void TaskScheduler::spawn(int worker, Task task)
+{
+    push(worker, std::move(task), true);
+}
+
+void TaskScheduler::yield(int worker, Task task)
+{
+    push(worker, std::move(task), false);
+}
+
+bool TaskScheduler::popLocal(int index, Task &task)
+{
+    Worker &w = *workers[index];
+    std::lock_guard<std::mutex> guard(w.lock);
+    if (w.tasks.empty())
+        return false;
+    task = std::move(w.tasks.back());
+    w.tasks.pop_back();
+    return true;
+}
+
+bool TaskScheduler::steal(int index, Task &task)
+{
+    int n = (int)workers.size();
+    for (int k = 1; k < n; k++)
+    {
+        Worker &victim = *workers[(index + k) % n];
+        std::lock_guard<std::mutex> guard(victim.lock);
+        if (victim.tasks.empty())
+            continue;
+        task = std::move(victim.tasks.front());
+        victim.tasks.pop_front();
+        workers[index]->tasks_stolen.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+void TaskScheduler::workerLoop(int index)
+{
+    Worker &self = *workers[index];
+
+    while (!shutting_down.load())
+    {
+        Task task;
+        if (popLocal(index, task) || steal(index, task))
+        {
+            auto begin = std::chrono::steady_clock::now();
+            task(index);
+            auto end = std::chrono::steady_clock::now();
+
+            self.busy_ns.fetch_add((uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count(),
+                                   std::memory_order_relaxed);
+            self.tasks_run.fetch_add(1, std::memory_order_relaxed);
+
+            if (pending.fetch_sub(1) == 1)
+            {
+                std::lock_guard<std::mutex> guard(done_lock);
+                done_cv.notify_all();
+            }
+            continue;
+        }
+
+        // 没有可执行的任务, 短暂休眠等待新任务
+        std::unique_lock<std::mutex> lk(idle_lock);
+        idle_cv.wait_for(lk, std::chrono::milliseconds(1));
+    }
+}
+
+void TaskScheduler::wait()
+{
+    std::unique_lock<std::mutex> lk(done_lock);
+    done_cv.wait(lk, [this] { return pending.load() == 0; });
+}
+
+std::vector<WorkerStats> TaskScheduler::getStats() const
+{
+    double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - stats_start).count();
+    if (wall <= 0.0)
+        wall = 1e-9;
+
+    std::vector<WorkerStats> stats;
+    for (const auto &w : workers)
+    {
+        WorkerStats s;
+        s.tasks_run = w->tasks_run.load();
+        s.tasks_stolen = w->tasks_stolen.load();
+        s.busy_seconds = w->busy_ns.load() / 1e9;
+        s.utilization = s.busy_seconds / wall;
+        stats.push_back(s);
+    }
+    return stats;
+}
+
+void TaskScheduler::resetStats()
+{
+    for (auto &w : workers)
+    {
+        w->tasks_run = 0;
+        w->tasks_stolen = 0;
+        w->busy_ns = 0;
+    }
+    stats_start = std::chrono::steady_clock::now();
+}
@@ -0,0 +1,78 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct WorkerStats
+{
+    uint64_t tasks_run;
+    uint64_t tasks_stolen; // 从其他工作线程队列窃取的任务数
+    double busy_seconds;
+    double utilization; // busy_seconds / 统计区间的墙钟时长
+};
+
+// 工作窃取任务调度器: 每个工作线程一个双端队列, 本线程从底部取, 空闲线程从其他队列顶部窃取
+// 用于长短悬殊的仿真任务; 长任务可在检查点用 yield 让出, 使剩余部分能被其他线程接手
+class TaskScheduler
+{
+public:
+    // 参数为执行任务的工作线程编号
+    typedef std::function<void(int)> Task;
+
+    explicit TaskScheduler(int worker_count);
+    ~TaskScheduler();
+
+    int getWorkerCount() const;
+
+    // 外部线程提交任务, 轮流放入各工作线程的队列
+    void submit(Task task);
+
+    // 任务内部调用: 放入本线程队列底部, 由本线程优先执行
+    void spawn(int worker, Task task);
+
+    // 任务内部调用: 放入本线程队列顶部 (窃取端), 先执行其他任务, 其他空闲线程也可接手
+    void yield(int worker, Task task);
+
+    // 阻塞直到所有任务 (包括任务中派生的任务) 执行完毕
+    void wait();
+
+    // 统计区间从构造或 resetStats() 开始
+    std::vector<WorkerStats> getStats() const;
+    void resetStats();
+
+private:
+    struct Worker
+    {
+        std::mutex lock;
+        std::deque<Task> tasks;
+        std::atomic<uint64_t> tasks_run;
+        std::atomic<uint64_t> tasks_stolen;
+        std::atomic<uint64_t> busy_ns;
+    };
+
+    void workerLoop(int index);
+    bool popLocal(int index, Task &task);
+    bool steal(int index, Task &task);
+    void push(int index, Task task, bool to_bottom);
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::vector<std::thread> threads;
+
+    std::atomic<int64_t> pending; // 已提交但未执行完的任务数
+    std::atomic<bool> shutting_down;
+    std::atomic<size_t> next_submit;
+
+    std::mutex idle_lock;
+    std::condition_variable idle_cv;
+    std::mutex done_lock;
+    std::condition_variable done_cv;
+
+    std::chrono::steady_clock::time_point stats_start;
+};
@@ -0,0 +1,402 @@
+#include "TelemetryShm.h"
+#include <cstring>
+#include <new>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+SharedMemoryRegion::SharedMemoryRegion() : base(nullptr), length(0), owner(false)
+{
+#ifdef _WIN32
+    mapping = nullptr;
+#endif
+}
+
+SharedMemoryRegion::~SharedMemoryRegion()
+{
+    close();
+}
+
+#ifdef _WIN32
+
+bool SharedMemoryRegion::create(const std::string &name, size_t size)
+{
+    close();
+    HANDLE h = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, (DWORD)((uint64_t)size >> 32),
+                                  (DWORD)size, name.c_str());
+    if (!h)
+        return false;
+    void *p = MapViewOfFile(h, FILE_MAP_ALL_ACCESS, 0, 0, size);
+    if (!p)
+    {
+        CloseHandle(h);
+        return false;
+    }
+    mapping = h;
+    base = p;
+    length = size;
+    owner = true;
+    shm_name = name;
+    return true;
+}
+
+bool SharedMemoryRegion::openReadOnly(const std::string &name)
+{
+    close();
+    HANDLE h = OpenFileMappingA(FILE_MAP_READ, FALSE, name.c_str());
+    if (!h)
+        return false;
+    void *p = MapViewOfFile(h, FILE_MAP_READ, 0, 0, 0);
+    if (!p)
+    {
+        CloseHandle(h);
+        return false;
+    }
+    MEMORY_BASIC_INFORMATION info;
+    VirtualQuery(p, &info, sizeof(info));
+    mapping = h;
+    base = p;
+    length = info.RegionSize;
+    owner = false;
+    shm_name = name;
+    return true;
+}
+
+void SharedMemoryRegion::close()
+{
+    if (base)
+        UnmapViewOfFile(base);
+    if (mapping)
+        CloseHandle((HANDLE)mapping);
+    base = nullptr;
+    mapping = nullptr;
+    length = 0;
+    owner = false;
+}
+
+#else
+
+// POSIX 共享内存名称必须以 '/' 开头
+static std::string posixName(const std::string &name)
+{
+    return (!name.empty() && name[0] == '/') ? name : "/" + name;
+}
+
+bool SharedMemoryRegion::create(const std::string &name, size_t size)
+{
+    close();
+    std::string path = posixName(name);
+
+    // 先删除旧的同名区域, 避免沿用布局不同的旧数据
+    shm_unlink(path.c_str());
+    int fd = shm_open(path.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0)
+        return false;
+    if (ftruncate(fd, (off_t)size) != 0)
+    {
+        ::close(fd);
+        shm_unlink(path.c_str());
+        return false;
+    }
+    void *p = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (p == MAP_FAILED)
+    {
+        shm_unlink(path.c_str());
+        return false;
+    }
+    base = p;
+    length = size;
+    owner = true;
+    shm_name = path;
+    return true;
+}
+
+bool SharedMemoryRegion::openReadOnly(const std::string &name)
+{
+    close();
+    std::string path = posixName(name);
+    int fd = shm_open(path.c_str(), O_RDONLY, 0);
+    if (fd < 0)
+        return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0)
+    {
+        ::close(fd);
+        return false;
+    }
+    void *p = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (p == MAP_FAILED)
+        return false;
+    base = p;
+    length = (size_t)st.st_size;
+    owner = false;
+    shm_name = path;
+    return true;
+}
+
+void SharedMemoryRegion::close()
+{
+    if (base)
+        munmap(base, length);
+    if (owner)
+        shm_unlink(shm_name.c_str());
+    base = nullptr;
+    length = 0;
+    owner = false;
+}
+
+#endif
+
+void *SharedMemoryRegion::data() const
+{
+    return base;
+}
+
+size_t SharedMemoryRegion::size() const
+{
+    return length;
+}
+
+// ---- 写端 ----
+
+TelemetryPublisher::TelemetryPublisher() : header(nullptr), slots(nullptr), slot_mask(0), next_index(0)
+{
+}
+
+TelemetryPublisher::~TelemetryPublisher()
+{
+    close();
+}
+
+bool TelemetryPublisher::open(const std::string &name, uint32_t slot_count, double step)
+{
+    close();
+
+    uint32_t count = 2;
+    while (count < slot_count)
+        count <<= 1;
+
+    size_t size = sizeof(TelemetryShmHeader) + (size_t)count * sizeof(TelemetrySlot);
+    if (!region.create(name, size))
+        return false;
+
+    // 新建的共享内存内容为 0, 序号从 0 开始即表示所有槽位都未写过
+    header = new (region.data()) TelemetryShmHeader;
+    slots = (TelemetrySlot *)((char *)region.data() + sizeof(TelemetryShmHeader));
+    for (uint32_t i = 0; i < count; i++)
+        slots[i].seq.store(0, std::memory_order_relaxed);
+
+    header->version = TELEMETRY_SHM_VERSION;
+    header->slot_count = count;
+    header->slot_size = sizeof(TelemetrySlot);
+    header->reserved = 0;
+    header->step = step;
+    header->published.store(0, std::memory_order_relaxed);
+    slot_mask = count - 1;
+    next_index = 0;
+
+    // 魔数最后写入, 读端以此判断共享内存已初始化完成
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(header->magic, TELEMETRY_SHM_MAGIC, sizeof(header->magic));
+    return true;
+}
+
+void TelemetryPublisher::close()
+{
+    region.close();
+    header = nullptr;
+    slots = nullptr;
+}
+
+bool TelemetryPublisher::isOpen() const
+{
+    return header != nullptr;
+}
+
+void TelemetryPublisher::publish(double time, const EngineSnapshot &data, EngineState state, uint32_t alert_mask)
+{
+    if (!header)
+        return;
+
+    uint64_t n = next_index++;
+    TelemetrySlot &slot = slots[n & slot_mask];
+
+    slot.seq.store(2 * n + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot.time = time;
+    slot.alert_mask = alert_mask;
+    slot.state = (uint8_t)state;
+    std::memcpy(&slot.data, &data, sizeof(EngineSnapshot));
+
+    slot.seq.store(2 * n + 2, std::memory_order_release);
+    header->published.store(n + 1, std::memory_order_release);
+}
+
+// ---- 读端 ----
+
+TelemetryReader::TelemetryReader()
+    : header(nullptr), slots(nullptr), slot_mask(0), next_index(0), missed(0), retries(0)
+{
+}
+
+bool TelemetryReader::open(const std::string &name)
+{
+    close();
+    if (!region.openReadOnly(name))
+        return false;
+
+    const TelemetryShmHeader *h = (const TelemetryShmHeader *)region.data();
+    if (region.size() < sizeof(TelemetryShmHeader) ||
+        std::memcmp(h->magic, TELEMETRY_SHM_MAGIC, sizeof(h->magic)) != 0 || h->version != TELEMETRY_SHM_VERSION ||
+        h->slot_size != sizeof(TelemetrySlot) ||
+        region.size() < sizeof(TelemetryShmHeader) + (size_t)h->slot_count * sizeof(TelemetrySlot))
+    {
+        region.close();
+        return false;
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    header = h;
+    slots = (const TelemetrySlot *)((const char *)region.data() + sizeof(TelemetryShmHeader));
+    slot_mask = h->slot_count - 1;
+
+    // 从当前位置开始读, 不回放打开之前的历史
+    next_index = h->published.load(std::memory_order_acquire);
+    missed = 0;
+    retries = 0;
+    return true;
+}
+
+void TelemetryReader::close()
+{
+    region.close();
+    header = nullptr;
+    slots = nullptr;
+}
+
+bool TelemetryReader::isOpen() const
+{
+    return header != nullptr;
+}
+
+TelemetryReader::SlotRead TelemetryReader::readSlot(uint64_t index, TelemetryFrame &out)
+{
+    const TelemetrySlot &slot = slots[index & slot_mask];
+    const uint64_t done = 2 * index + 2;
+
+    // 写端在写入中途退出时该槽位会一直是奇数, 重试有上限
+    for (int attempt = 0; attempt < 10000; attempt++)
+    {
+        uint64_t s1 = slot.seq.load(std::memory_order_acquire);
+        if (s1 < done - 1)
+            return SlotRead::NOT_READY;
+        if (s1 > done)
+            return SlotRead::OVERWRITTEN;
+        if (s1 == done - 1)
+        {
+            // 写端正在写这一帧
+            retries++;
+            continue;
+        }
+
+        out.index = index;
+        out.time = slot.time;
+        out.alert_mask = slot.alert_mask;
+        out.state = (EngineState)slot.state;
+        std::memcpy(&out.data, &slot.data, sizeof(EngineSnapshot));
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        uint64_t s2 = slot.seq.load(std::memory_order_relaxed);
+        if (s2 == s1)
+            return SlotRead::OK;
+        if (s2 > done)
+            return SlotRead::OVERWRITTEN;
+        retries++;
+    }
+    return SlotRead::NOT_READY;
+}
+
+bool TelemetryReader::readLatest(TelemetryFrame &out)
+{
+    if (!header)
+        return false;
+    for (;;)
+    {
+        uint64_t published = header->published.load(std::memory_order_acquire);
+        if (published == 0)
+            return false;
+        SlotRead r = readSlot(published - 1, out);
+        if (r == SlotRead::OK)
+        {
+            if (published > next_index)
+                next_index = published;
+            return true;
+        }
+        if (r == SlotRead::NOT_READY)
+            return false;
+        // 读取期间又被覆盖, 用新的最新帧重试
+        retries++;
+    }
+}
+
+bool TelemetryReader::readNext(TelemetryFrame &out)
+{
+    if (!header)
+        return false;
+    for (;;)
+    {
+        uint64_t published = header->published.load(std::memory_order_acquire);
+        if (next_index >= published)
+            return false;
+
+        // 已被覆盖的帧直接跳过, 留出半个缓冲区的余量, 减少刚跳过去又被覆盖的情况
+        uint64_t capacity = (uint64_t)slot_mask + 1;
+        if (published - next_index > capacity)
+        {
+            uint64_t oldest = published - capacity / 2;
+            missed += oldest - next_index;
+            next_index = oldest;
+        }
+
+        SlotRead r = readSlot(next_index, out);
+        if (r == SlotRead::OK)
+        {
+            next_index++;
+            return true;
+        }
+        if (r == SlotRead::NOT_READY)
+            return false;
+        // OVERWRITTEN: 回到循环开头重新定位
+        missed++;
+        next_index++;
+    }
+}
+
+uint64_t TelemetryReader::getPublished() const
+{
+    return header ? header->published.load(std::memory_order_acquire) : 0;
+}
+
+uint64_t TelemetryReader::getMissed() const
+{
+    return missed;
+}
+
+uint64_t TelemetryReader::getRetries() const
+{
+    return retries;
+}
+
+double TelemetryReader::getStep() const
+{
+    return header ? header->step : 0.0;
+}
@@ -0,0 +1,132 @@
+#pragma once
+#include "DataStructrue.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// 共享内存遥测: 仿真每一步的数据快照和告警位掩码写入共享内存环形缓冲区, 供本机其他进程读取
+// 每个槽位一个序号 (seqlock): 写端先置为奇数再写数据, 写完置为偶数; 读端前后两次读到相同的偶数才算有效
+// 写端从不等待读端, 读端数量不限; 读端落后超过环形缓冲区长度时会丢帧
+
+const char TELEMETRY_SHM_MAGIC[8] = {'E', 'N', 'G', 'S', 'H', 'M', '0', '1'};
+const uint32_t TELEMETRY_SHM_VERSION = 1;
+
+struct alignas(64) TelemetryShmHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t slot_count;
+    uint32_t slot_size;
+    uint32_t reserved;
+    double step; // 仿真步长 (秒)
+    alignas(64) std::atomic<uint64_t> published; // 已发布的帧数
+};
+
+struct alignas(64) TelemetrySlot
+{
+    std::atomic<uint64_t> seq; // 2n+1: 正在写第 n 帧; 2n+2: 第 n 帧已写完
+    double time;
+    uint32_t alert_mask; // EICAS 当前显示的告警, errorBit() 组成
+    uint8_t state;       // EngineState
+    EngineSnapshot data;
+};
+
+static_assert(sizeof(TelemetrySlot) == 128, "TelemetrySlot must be two cache lines");
+
+// 读端取到的一帧
+struct TelemetryFrame
+{
+    uint64_t index; // 帧序号, 从 0 开始连续递增
+    double time;
+    EngineSnapshot data;
+    EngineState state;
+    uint32_t alert_mask;
+};
+
+// 共享内存映射的平台封装
+class SharedMemoryRegion
+{
+public:
+    SharedMemoryRegion();
+    ~SharedMemoryRegion();
+
+    bool create(const std::string &name, size_t size);
+    bool openReadOnly(const std::string &name);
+    void close();
+
+    void *data() const;
+    size_t size() const;
+
+private:
+    std::string shm_name;
+    void *base;
+    size_t length;
+    bool owner;
+#ifdef _WIN32
+    void *mapping;
+#endif
+};
+
+// 写端, 只由仿真线程调用
+class TelemetryPublisher
+{
+public:
+    TelemetryPublisher();
+    ~TelemetryPublisher();
+
+    // 创建 (或重建) 名为 name 的共享内存, slot_count 取 2 的整数次幂
+    bool open(const std::string &name, uint32_t slot_count = 4096, double step = 0.005);
+    void close();
+    bool isOpen() const;
+
+    void publish(double time, const EngineSnapshot &data, EngineState state, uint32_t alert_mask);
+
+private:
+    SharedMemoryRegion region;
+    TelemetryShmHeader *header;
+    TelemetrySlot *slots;
+    uint32_t slot_mask;
+    uint64_t next_index;
+};
+
+// 读端
+class TelemetryReader
+{
+public:
+    TelemetryReader();
+
+    bool open(const std::string &name);
+    void close();
+    bool isOpen() const;
+
+    // 最新发布的一帧; 尚无数据时返回 false
+    bool readLatest(TelemetryFrame &out);
+
+    // 按顺序读取下一帧, 没有新帧时返回 false;
+    // 落后超过环形缓冲区长度时跳到仍可读的最旧帧, 跳过的帧数计入 getMissed()
+    bool readNext(TelemetryFrame &out);
+
+    uint64_t getPublished() const;
+    uint64_t getMissed() const;
+    uint64_t getRetries() const; // 读取时遇到写端正在改写而重试的次数
+    double getStep() const;
+
+private:
+    enum class SlotRead
+    {
+        OK,
+        NOT_READY,
+        OVERWRITTEN,
+    };
+
+    SlotRead readSlot(uint64_t index, TelemetryFrame &out);
+
+    SharedMemoryRegion region;
+    const TelemetryShmHeader *header;
+    const TelemetrySlot *slots;
+    uint32_t slot_mask;
+    uint64_t next_index;
+    uint64_t missed;
+    uint64_t retries;
+};
@@ -0,0 +1,428 @@
+#include "TelemetryStream.h"
+#include <cstdio>
+#include <cstring>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#pragma comment(lib, "ws2_32.lib")
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+static const intptr_t INVALID_FD = -1;
+
+#ifdef _WIN32
+
+static bool initSockets()
+{
+    static bool ok = false;
+    if (!ok)
+    {
+        WSADATA wsa;
+        ok = (WSAStartup(MAKEWORD(2, 2), &wsa) == 0);
+    }
+    return ok;
+}
+
+static void closeSocket(intptr_t fd)
+{
+    closesocket((SOCKET)fd);
+}
+
+static bool setNonBlocking(intptr_t fd)
+{
+    u_long on = 1;
+    return ioctlsocket((SOCKET)fd, FIONBIO, &on) == 0;
+}
+
+#else
+
+static bool initSockets()
+{
+    return true;
+}
+
+static void closeSocket(intptr_t fd)
+{
+    ::close((int)fd);
+}
+
+static bool setNonBlocking(intptr_t fd)
+{
+    int flags = fcntl((int)fd, F_GETFL, 0);
+    return flags >= 0 && fcntl((int)fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+#endif
+
+DatagramSocket::DatagramSocket() : fd(INVALID_FD), addr_len(0)
+{
+    std::memset(addr, 0, sizeof(addr));
+}
+
+DatagramSocket::~DatagramSocket()
+{
+    close();
+}
+
+bool DatagramSocket::connectUdp(const std::string &host, uint16_t port)
+{
+    close();
+    if (!initSockets())
+        return false;
+
+    addrinfo hints;
+    std::memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_DGRAM;
+    char port_text[8];
+    std::snprintf(port_text, sizeof(port_text), "%u", (unsigned)port);
+    addrinfo *result = nullptr;
+    if (getaddrinfo(host.c_str(), port_text, &hints, &result) != 0 || !result)
+        return false;
+
+    bool ok = false;
+    if (result->ai_addrlen <= sizeof(addr))
+    {
+        intptr_t s = (intptr_t)socket(result->ai_family, SOCK_DGRAM, IPPROTO_UDP);
+        if (s != INVALID_FD && setNonBlocking(s))
+        {
+            std::memcpy(addr, result->ai_addr, result->ai_addrlen);
+            addr_len = (int)result->ai_addrlen;
+            fd = s;
+            ok = true;
+        }
+        else if (s != INVALID_FD)
+            closeSocket(s);
+    }
+    freeaddrinfo(result);
+    return ok;
+}
+
+bool DatagramSocket::bindUdp(uint16_t port)
+{
+    close();
+    if (!initSockets())
+        return false;
+
+    intptr_t s = (intptr_t)socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (s == INVALID_FD)
+        return false;
+
+    // 加大接收缓冲区, 接收端短暂停顿时少丢包
+    int buffer_size = 4 << 20;
+    setsockopt((int)s, SOL_SOCKET, SO_RCVBUF, (const char *)&buffer_size, sizeof(buffer_size));
+
+    sockaddr_in local;
+    std::memset(&local, 0, sizeof(local));
+    local.sin_family = AF_INET;
+    local.sin_addr.s_addr = htonl(INADDR_ANY);
+    local.sin_port = htons(port);
+    if (bind((int)s, (const sockaddr *)&local, sizeof(local)) != 0)
+    {
+        closeSocket(s);
+        return false;
+    }
+    fd = s;
+    return true;
+}
+
+#ifdef _WIN32
+
+bool DatagramSocket::connectUnix(const std::string &)
+{
+    return false; // Windows 的 AF_UNIX 不支持数据报
+}
+
+bool DatagramSocket::bindUnix(const std::string &)
+{
+    return false;
+}
+
+#else
+
+static bool makeUnixAddress(const std::string &path, sockaddr_un &out)
+{
+    if (path.size() >= sizeof(out.sun_path))
+        return false;
+    std::memset(&out, 0, sizeof(out));
+    out.sun_family = AF_UNIX;
+    std::memcpy(out.sun_path, path.c_str(), path.size() + 1);
+    return true;
+}
+
+bool DatagramSocket::connectUnix(const std::string &path)
+{
+    close();
+    sockaddr_un remote;
+    if (!makeUnixAddress(path, remote))
+        return false;
+    int s = socket(AF_UNIX, SOCK_DGRAM, 0);
+    if (s < 0)
+        return false;
+    if (!setNonBlocking(s))
+    {
+        closeSocket(s);
+        return false;
+    }
+    std::memcpy(addr, &remote, sizeof(remote));
+    addr_len = (int)sizeof(remote);
+    fd = s;
+    return true;
+}
+
+bool DatagramSocket::bindUnix(const std::string &path)
+{
+    close();
+    sockaddr_un local;
+    if (!makeUnixAddress(path, local))
+        return false;
+    int s = socket(AF_UNIX, SOCK_DGRAM, 0);
+    if (s < 0)
+        return false;
+    int buffer_size = 4 << 20;
+    setsockopt(s, SOL_SOCKET, SO_RCVBUF, &buffer_size, sizeof(buffer_size));
+    unlink(path.c_str());
+    if (bind(s, (const sockaddr *)&local, sizeof(local)) != 0)
+    {
+        closeSocket(s);
+        return false;
+    }
+    fd = s;
+    unix_path = path;
+    return true;
+}
+
+#endif
+
+void DatagramSocket::close()
+{
+    if (fd != INVALID_FD)
+        closeSocket(fd);
+    fd = INVALID_FD;
+    addr_len = 0;
+#ifndef _WIN32
+    if (!unix_path.empty())
+        unlink(unix_path.c_str());
+#endif
+    unix_path.clear();
+}
+
+bool DatagramSocket::isOpen() const
+{
+    return fd != INVALID_FD;
+}
+
+bool DatagramSocket::send(const void *data, size_t size)
+{
+    if (fd == INVALID_FD || addr_len == 0)
+        return false;
+#ifdef _WIN32
+    int sent = sendto((SOCKET)fd, (const char *)data, (int)size, 0, (const sockaddr *)addr, addr_len);
+#else
+    ssize_t sent = sendto((int)fd, data, size, MSG_DONTWAIT | MSG_NOSIGNAL, (const sockaddr *)addr, (socklen_t)addr_len);
+#endif
+    // 缓冲区满 (EAGAIN/ENOBUFS)、对端未绑定 (ECONNREFUSED/ENOENT) 等一律视为丢包, 不重试
+    return sent == (decltype(sent))size;
+}
+
+int DatagramSocket::receive(void *buffer, size_t capacity, int timeout_ms)
+{
+    if (fd == INVALID_FD)
+        return -1;
+#ifdef _WIN32
+    WSAPOLLFD p;
+    p.fd = (SOCKET)fd;
+    p.events = POLLRDNORM;
+    p.revents = 0;
+    int ready = WSAPoll(&p, 1, timeout_ms);
+    if (ready <= 0)
+        return ready < 0 ? -1 : 0;
+    int n = recv((SOCKET)fd, (char *)buffer, (int)capacity, 0);
+    return n < 0 ? -1 : n;
+#else
+    pollfd p;
+    p.fd = (int)fd;
+    p.events = POLLIN;
+    p.revents = 0;
+    int ready = poll(&p, 1, timeout_ms);
+    if (ready < 0)
+        return errno == EINTR ? 0 : -1;
+    if (ready == 0)
+        return 0;
+    ssize_t n = recv((int)fd, buffer, capacity, MSG_DONTWAIT);
+    if (n < 0)
+        return (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) ? 0 : -1;
+    return (int)n;
+#endif
+}
+
+TelemetrySender::TelemetrySender() : max_delay(std::chrono::milliseconds(50)), sequence(0), next_step(0), count(0)
+{
+    std::memset(&stats, 0, sizeof(stats));
+}
+
+TelemetrySender::~TelemetrySender()
+{
+    close();
+}
+
+bool TelemetrySender::openUdp(const std::string &host, uint16_t port)
+{
+    close();
+    return socket.connectUdp(host, port);
+}
+
+bool TelemetrySender::openUnix(const std::string &path)
+{
+    close();
+    return socket.connectUnix(path);
+}
+
+void TelemetrySender::close()
+{
+    flush();
+    socket.close();
+}
+
+bool TelemetrySender::isOpen() const
+{
+    return socket.isOpen();
+}
+
+void TelemetrySender::setMaxDelay(double seconds)
+{
+    max_delay = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(seconds));
+}
+
+void TelemetrySender::push(double time, const EngineSnapshot &data, EngineState state, uint32_t alert_mask)
+{
+    if (!socket.isOpen())
+        return;
+
+    TelemetryWireSample *samples = (TelemetryWireSample *)(packet.bytes + sizeof(TelemetryPacketHeader));
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    if (count == 0)
+    {
+        packet.header.first_step = next_step;
+        first_push = now;
+    }
+    samples[count++] = makeWireSample(time, data, state, alert_mask);
+    next_step++;
+    stats.samples++;
+
+    if (count == TELEMETRY_STREAM_SAMPLES_PER_PACKET || now - first_push >= max_delay)
+        flush();
+}
+
+void TelemetrySender::flush()
+{
+    if (count == 0 || !socket.isOpen())
+        return;
+
+    TelemetryPacketHeader &h = packet.header;
+    std::memcpy(h.magic, TELEMETRY_STREAM_MAGIC, sizeof(h.magic));
+    h.version = TELEMETRY_STREAM_VERSION;
+    h.sample_count = (uint16_t)count;
+    h.sequence = sequence++;
+    h.sample_size = (uint16_t)sizeof(TelemetryWireSample);
+    h.reserved = 0;
+
+    size_t size = sizeof(TelemetryPacketHeader) + count * sizeof(TelemetryWireSample);
+    if (socket.send(packet.bytes, size))
+    {
+        stats.packets_sent++;
+        stats.bytes_sent += size;
+    }
+    else
+        stats.packets_dropped++;
+    count = 0;
+}
+
+TelemetrySendStats TelemetrySender::getStats() const
+{
+    return stats;
+}
+
+TelemetryReceiver::TelemetryReceiver() : has_last(false), last_sequence(0), next_step(0)
+{
+    std::memset(&stats, 0, sizeof(stats));
+}
+
+bool TelemetryReceiver::bindUdp(uint16_t port)
+{
+    has_last = false;
+    return socket.bindUdp(port);
+}
+
+bool TelemetryReceiver::bindUnix(const std::string &path)
+{
+    has_last = false;
+    return socket.bindUnix(path);
+}
+
+void TelemetryReceiver::close()
+{
+    socket.close();
+}
+
+bool TelemetryReceiver::isOpen() const
+{
+    return socket.isOpen();
+}
+
+int TelemetryReceiver::receive(const TelemetryPacketHeader *&header, const TelemetryWireSample *&samples,
+                               int timeout_ms)
+{
+    int n = socket.receive(packet.bytes, sizeof(packet.bytes), timeout_ms);
+    if (n <= 0)
+        return n;
+
+    const TelemetryPacketHeader &h = packet.header;
+    if ((size_t)n < sizeof(TelemetryPacketHeader) || std::memcmp(h.magic, TELEMETRY_STREAM_MAGIC, 4) != 0 ||
+        h.version != TELEMETRY_STREAM_VERSION || h.sample_size != sizeof(TelemetryWireSample) ||
+        (size_t)n != sizeof(TelemetryPacketHeader) + h.sample_count * sizeof(TelemetryWireSample))
+    {
+        stats.invalid++;
+        return 0;
+    }
+
+    // 序号按 32 位回绕比较; 晚到的包照常交给调用方, 但不计入缺口
+    if (has_last)
+    {
+        int32_t gap = (int32_t)(h.sequence - last_sequence);
+        if (gap <= 0)
+            stats.reordered++;
+        else
+        {
+            stats.lost_packets += (uint64_t)(gap - 1);
+            if (h.first_step > next_step)
+                stats.lost_samples += h.first_step - next_step;
+        }
+    }
+    if (!has_last || (int32_t)(h.sequence - last_sequence) > 0)
+    {
+        has_last = true;
+        last_sequence = h.sequence;
+        next_step = h.first_step + h.sample_count;
+    }
+
+    stats.packets++;
+    stats.samples += h.sample_count;
+    header = &h;
+    samples = (const TelemetryWireSample *)(packet.bytes + sizeof(TelemetryPacketHeader));
+    return h.sample_count;
+}
+
+TelemetryReceiveStats TelemetryReceiver::getStats() const
+{
+    return stats;
+}
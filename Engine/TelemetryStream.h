@@ -0,0 +1,187 @@
+#pragma once
+#include "DataStructrue.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// 网络遥测流: 仿真每一步的数据、状态和告警位掩码打包成定长样本, 攒满一个 MTU 大小的数据报后经 UDP 或
+// Unix 数据报套接字发出, 供实验室网络上的远程显示使用
+// 数据报 = 24 字节包头 + 若干 40 字节样本, 小端存储; 包头带连续递增的包序号, 接收端据此检测丢包和乱序
+// 发送使用非阻塞套接字, 发送缓冲区满或对端不存在时直接丢弃该包并计数, 仿真循环不会因接收端慢而阻塞
+
+const char TELEMETRY_STREAM_MAGIC[4] = {'E', 'N', 'G', 'U'};
+const uint16_t TELEMETRY_STREAM_VERSION = 1;
+
+// 以太网 MTU 1500 减去 IPv4 和 UDP 头, 保证数据报不分片
+const size_t TELEMETRY_STREAM_MAX_PACKET = 1472;
+
+struct TelemetryPacketHeader
+{
+    char magic[4];
+    uint16_t version;
+    uint16_t sample_count;
+    uint32_t sequence;    // 包序号, 每发一个包 (含因发送失败丢弃的包) 加 1
+    uint16_t sample_size; // sizeof(TelemetryWireSample), 接收端据此校验
+    uint16_t reserved;
+    uint64_t first_step; // 包内第一个样本的全局序号, 同一发送端的样本序号连续递增
+};
+
+struct TelemetryWireSample
+{
+    double time;
+    // rpm_1, rpm_2, egt1_temp, egt2_temp, fuel_v, fuel_c (与 CSV 列顺序一致), 显示用 float 精度足够
+    float values[6];
+    uint16_t validity;   // packSensorValidity 格式
+    uint16_t alert_mask; // EICAS 当前显示的告警, errorBit() 组成
+    uint8_t state;       // EngineState
+    uint8_t reserved[3];
+};
+
+static_assert(sizeof(TelemetryPacketHeader) == 24, "TelemetryPacketHeader must be 24 bytes");
+static_assert(sizeof(TelemetryWireSample) == 40, "TelemetryWireSample must be 40 bytes");
+static_assert(ERROR_TYPE_COUNT <= 16, "alert mask must fit in TelemetryWireSample::alert_mask");
+
+const int TELEMETRY_STREAM_SAMPLES_PER_PACKET =
+    (int)((TELEMETRY_STREAM_MAX_PACKET - sizeof(TelemetryPacketHeader)) / sizeof(TelemetryWireSample));
+
+inline TelemetryWireSample makeWireSample(double time, const EngineSnapshot &data, EngineState state,
+                                          uint32_t alert_mask)
+{
+    TelemetryWireSample s;
+    s.time = time;
+    s.values[0] = (float)data.rpm_1;
+    s.values[1] = (float)data.rpm_2;
+    s.values[2] = (float)data.egt1_temp;
+    s.values[3] = (float)data.egt2_temp;
+    s.values[4] = (float)data.fuel_v;
+    s.values[5] = (float)data.fuel_c;
+    s.validity = packSensorValidity(data);
+    s.alert_mask = (uint16_t)alert_mask;
+    s.state = (uint8_t)state;
+    s.reserved[0] = s.reserved[1] = s.reserved[2] = 0;
+    return s;
+}
+
+inline void wireSampleToSnapshot(const TelemetryWireSample &s, EngineSnapshot &data)
+{
+    data.rpm_1 = s.values[0];
+    data.rpm_2 = s.values[1];
+    data.egt1_temp = s.values[2];
+    data.egt2_temp = s.values[3];
+    data.fuel_v = s.values[4];
+    data.fuel_c = s.values[5];
+    unpackSensorValidity(s.validity, data);
+}
+
+// 数据报套接字的平台封装 (UDP; 非 Windows 平台另支持 Unix 数据报套接字)
+class DatagramSocket
+{
+public:
+    DatagramSocket();
+    ~DatagramSocket();
+
+    // 发送端: 目标地址 host:port 或 Unix 套接字路径, 套接字设为非阻塞
+    bool connectUdp(const std::string &host, uint16_t port);
+    bool connectUnix(const std::string &path);
+    // 接收端: 绑定本地端口或 Unix 套接字路径 (已存在的路径先删除)
+    bool bindUdp(uint16_t port);
+    bool bindUnix(const std::string &path);
+    void close();
+    bool isOpen() const;
+
+    // 非阻塞发送, 返回是否整包发出
+    bool send(const void *data, size_t size);
+    // 最多等待 timeout_ms 毫秒, 返回收到的字节数; 超时返回 0, 出错返回 -1
+    int receive(void *buffer, size_t capacity, int timeout_ms);
+
+private:
+    intptr_t fd;
+    unsigned char addr[128]; // sockaddr_storage / sockaddr_un
+    int addr_len;
+    std::string unix_path; // 接收端绑定的路径, 关闭时删除
+};
+
+struct TelemetrySendStats
+{
+    uint64_t samples;         // push() 的样本数
+    uint64_t packets_sent;    // 成功发出的包
+    uint64_t packets_dropped; // 发送缓冲区满或对端不存在而丢弃的包
+    uint64_t bytes_sent;
+};
+
+// 发送端, 只由仿真线程调用
+class TelemetrySender
+{
+public:
+    TelemetrySender();
+    ~TelemetrySender();
+
+    bool openUdp(const std::string &host, uint16_t port);
+    bool openUnix(const std::string &path);
+    void close(); // 先发出未满的包
+    bool isOpen() const;
+
+    // 包内第一个样本放入后经过 max_delay 秒 (真实时间) 即使未满也发出, 限制实时运行时远程显示的延迟;
+    // 快于实时运行时包总能攒满
+    void setMaxDelay(double seconds);
+
+    void push(double time, const EngineSnapshot &data, EngineState state, uint32_t alert_mask);
+    void flush();
+
+    TelemetrySendStats getStats() const;
+
+private:
+    DatagramSocket socket;
+    std::chrono::steady_clock::duration max_delay;
+    std::chrono::steady_clock::time_point first_push;
+    uint32_t sequence;
+    uint64_t next_step;
+    int count;
+    TelemetrySendStats stats;
+    union
+    {
+        unsigned char bytes[TELEMETRY_STREAM_MAX_PACKET];
+        TelemetryPacketHeader header;
+    } packet;
+};
+
+struct TelemetryReceiveStats
+{
+    uint64_t packets;      // 收到的有效包
+    uint64_t samples;      // 收到的样本
+    uint64_t lost_packets; // 包序号缺口 (含发送端丢弃的包)
+    uint64_t lost_samples; // 样本序号缺口
+    uint64_t reordered;    // 序号小于已收到最大序号的包
+    uint64_t invalid;      // 长度或包头不合法的数据报
+};
+
+// 接收端
+class TelemetryReceiver
+{
+public:
+    TelemetryReceiver();
+
+    bool bindUdp(uint16_t port);
+    bool bindUnix(const std::string &path);
+    void close();
+    bool isOpen() const;
+
+    // 最多等待 timeout_ms 毫秒接收一个包; 成功时 header 和 samples 指向内部缓冲区, 到下一次调用前有效
+    // 返回样本数, 超时或收到非法包返回 0, 出错返回 -1
+    int receive(const TelemetryPacketHeader *&header, const TelemetryWireSample *&samples, int timeout_ms);
+
+    TelemetryReceiveStats getStats() const;
+
+private:
+    DatagramSocket socket;
+    bool has_last;
+    uint32_t last_sequence;
+    uint64_t next_step;
+    TelemetryReceiveStats stats;
+    union
+    {
+        unsigned char bytes[65536];
+        TelemetryPacketHeader header;
+    } packet;
+};
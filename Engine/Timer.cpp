@@ -1,8 +1,16 @@
 #include "Timer.h"
+#include <algorithm>
+#include <thread>
 
 using namespace std::chrono;
 
-Timer::Timer(double step) : fixed_dt(step)
+static const int64_t MAX_FRAME_NS = 250000000; // 单帧最多计入 0.25 秒
+static const int64_t LATE_BUCKET_NS = 10000;
+static const int LATE_BUCKETS = 2000;          // 覆盖 0 ~ 20 毫秒
+
+Timer::Timer(double step)
+    : fixed_dt(step), fixed_dt_ns((int64_t)(step * 1e9 + 0.5)), pacing(false), spin_margin_ns(2000000),
+      late_histogram(LATE_BUCKETS + 1, 0)
 {
     reset();
 }
@@ -10,47 +18,136 @@ Timer::Timer(double step) : fixed_dt(step)
 void Timer::reset()
 {
     last_time = Clock::now();
-    accumulator = 0.0;
-    total_sim_time = 0.0;
+    accumulator_ns = 0;
+    total_steps = 0;
+    dropped_ns = 0;
+
+    std::fill(late_histogram.begin(), late_histogram.end(), 0);
+    wait_count = 0;
+    late_min_ns = 0;
+    late_max_ns = 0;
+    late_sum_ns = 0;
+    sleep_ns = 0;
+    spin_ns = 0;
 }
 
 void Timer::tick()
 {
     TimePoint current_time = Clock::now();
 
-    // ֮֡ʱ
-    duration<double> diff = current_time - last_time;
-    double frame_time = diff.count();
+    // 计算两帧之间的时间差
+    int64_t frame_ns = duration_cast<nanoseconds>(current_time - last_time).count();
 
     last_time = current_time;
 
-    // ֹΪϵ϶ڵµ֡ʱѭ
-    if (frame_time > 0.25)
+    // 防止因为断点或拖动窗口导致单帧时间过长，造成死循环
+    if (frame_ns > MAX_FRAME_NS)
     {
-        frame_time = 0.25;
+        dropped_ns += frame_ns - MAX_FRAME_NS;
+        frame_ns = MAX_FRAME_NS;
     }
 
-    accumulator += frame_time;
+    accumulator_ns += frame_ns;
 }
 
 bool Timer::consumeStep()
 {
-    // ֻҪۻʱ䳬̶ִһ
-    if (accumulator >= fixed_dt)
+    // 只要累积时间超过固定步长，就允许执行一次物理更新
+    if (accumulator_ns >= fixed_dt_ns)
     {
-        accumulator -= fixed_dt;
-        total_sim_time += fixed_dt;
+        accumulator_ns -= fixed_dt_ns;
+        total_steps++;
         return true;
     }
     return false;
 }
 
+void Timer::setPacing(bool enabled, double spin_margin)
+{
+    pacing = enabled;
+    spin_margin_ns = (int64_t)(spin_margin * 1e9 + 0.5);
+}
+
+bool Timer::isPacing() const
+{
+    return pacing;
+}
+
+int64_t Timer::waitNextStep()
+{
+    if (!pacing || accumulator_ns >= fixed_dt_ns)
+        return -1;
+
+    // 下一步的截止时刻: 上次 tick 的时刻加上累积池还差的时间
+    TimePoint deadline = last_time + nanoseconds(fixed_dt_ns - accumulator_ns);
+
+    // 系统休眠的精度较差, 先睡到截止时刻前 spin_margin, 余下的时间忙等
+    TimePoint sleep_start = Clock::now();
+    TimePoint wake_target = deadline - nanoseconds(spin_margin_ns);
+    if (sleep_start < wake_target)
+        std::this_thread::sleep_until(wake_target);
+
+    TimePoint spin_start = Clock::now();
+    TimePoint now = spin_start;
+    while (now < deadline)
+    {
+        std::this_thread::yield();
+        now = Clock::now();
+    }
+
+    sleep_ns += duration_cast<nanoseconds>(spin_start - sleep_start).count();
+    spin_ns += duration_cast<nanoseconds>(now - spin_start).count();
+
+    int64_t late = duration_cast<nanoseconds>(now - deadline).count();
+    if (wait_count == 0 || late < late_min_ns)
+        late_min_ns = late;
+    if (wait_count == 0 || late > late_max_ns)
+        late_max_ns = late;
+    late_sum_ns += late;
+    wait_count++;
+
+    int64_t bucket = late / LATE_BUCKET_NS;
+    late_histogram[bucket < LATE_BUCKETS ? (size_t)bucket : LATE_BUCKETS]++;
+    return late;
+}
+
+PacingStats Timer::getPacingStats() const
+{
+    PacingStats stats;
+    stats.waits = wait_count;
+    stats.min_late_us = late_min_ns / 1000.0;
+    stats.max_late_us = late_max_ns / 1000.0;
+    stats.mean_late_us = wait_count ? (double)late_sum_ns / wait_count / 1000.0 : 0.0;
+    stats.sleep_s = sleep_ns / 1e9;
+    stats.spin_s = spin_ns / 1e9;
+
+    // p99 取直方图中累计达到 99% 的那一格的上沿
+    stats.p99_late_us = 0.0;
+    uint64_t target = (wait_count * 99 + 99) / 100;
+    uint64_t seen = 0;
+    for (size_t i = 0; i < late_histogram.size() && wait_count; i++)
+    {
+        seen += late_histogram[i];
+        if (seen >= target)
+        {
+            stats.p99_late_us = (i < LATE_BUCKETS) ? (i + 1) * LATE_BUCKET_NS / 1000.0 : stats.max_late_us;
+            break;
+        }
+    }
+    return stats;
+}
+
 double Timer::getSimulationTime() const
 {
-    return total_sim_time;
+    return total_steps * fixed_dt;
 }
 
 double Timer::getFixedStep() const
 {
     return fixed_dt;
-}
\ No newline at end of file
+}
+
+uint64_t Timer::getDroppedSteps() const
+{
+    return (uint64_t)(dropped_ns / fixed_dt_ns);
+}
@@ -1,5 +1,19 @@
 #pragma once
 #include <chrono>
+#include <cstdint>
+#include <vector>
+
+// 帧间等待的准时性统计, 迟到量 = 实际醒来时刻 - 下一步的截止时刻
+struct PacingStats
+{
+    uint64_t waits;     // 实际等待的次数
+    double min_late_us;
+    double mean_late_us;
+    double p99_late_us;
+    double max_late_us;
+    double sleep_s;     // 休眠的总时长
+    double spin_s;      // 忙等的总时长
+};
 
 class Timer
 {
@@ -8,22 +22,48 @@ public:
 
     void reset();
 
-    // ϵͳʱ
+    // 更新系统时间
     void tick();
 
-    // Ƿ²
+    // 检查是否满足物理更新步长
     bool consumeStep();
 
+    // 节拍模式: 每帧结束后调用 waitNextStep, 先休眠到截止时刻前 spin_margin 秒, 再忙等到截止时刻
+    void setPacing(bool enabled, double spin_margin = 0.002);
+    bool isPacing() const;
+
+    // 等待到下一个仿真步的截止时刻, 返回醒来时的迟到量 (纳秒); 未开启节拍模式或已落后时立即返回 -1
+    int64_t waitNextStep();
+
+    PacingStats getPacingStats() const;
+
     double getSimulationTime() const;
 
     double getFixedStep() const;
 
+    // 单帧超过 0.25 秒被截断而丢弃的仿真步数
+    uint64_t getDroppedSteps() const;
+
 private:
-    using Clock = std::chrono::high_resolution_clock;
-    using TimePoint = std::chrono::time_point<Clock>;
-
-    TimePoint last_time;   // һ֡ϵͳʱ
-    double accumulator;    // ۻʱ
-    double total_sim_time; // ߼еʱ
-    const double fixed_dt; // ̶ʱ䲽
-};
\ No newline at end of file
+    using Clock = std::chrono::steady_clock;
+    using TimePoint = Clock::time_point;
+
+    TimePoint last_time;      // 上一帧的系统时间
+    int64_t accumulator_ns;   // 累积时间池 (整数纳秒, 长时间运行不漂移)
+    uint64_t total_steps;     // 已执行的仿真步数
+    const double fixed_dt;    // 固定时间步长
+    const int64_t fixed_dt_ns;
+    int64_t dropped_ns;       // 被截断丢弃的时间
+
+    bool pacing;
+    int64_t spin_margin_ns;
+
+    // 迟到量直方图, 每格 10 微秒, 最后一格收容更大的值
+    std::vector<uint32_t> late_histogram;
+    uint64_t wait_count;
+    int64_t late_min_ns;
+    int64_t late_max_ns;
+    int64_t late_sum_ns;
+    int64_t sleep_ns;
+    int64_t spin_ns;
+};
@@ -0,0 +1,416 @@
+// 热路径微基准: 仿真各阶段、EICAS 判断与告警规则求值、日志写入与告警去重、一个完整的仿真周期
+// 结果以 JSON 输出 (每次操作的纳秒数与堆分配次数), 便于跨版本对比
+#include "EICAS.h"
+#include "EICASBatch.h"
+#include "Logger.h"
+#include "SimThread.h"
+#include "Simulator.h"
+#include "TrendPyramid.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <new>
+#include <string>
+#include <vector>
+
+// ---- 堆分配计数: 替换全局 operator new / delete ----
+
+static std::atomic<uint64_t> alloc_count(0);
+static std::atomic<uint64_t> alloc_bytes(0);
+
+static void *countedAlloc(std::size_t size)
+{
+    alloc_count.fetch_add(1, std::memory_order_relaxed);
+    alloc_bytes.fetch_add(size, std::memory_order_relaxed);
+    void *p = std::malloc(size ? size : 1);
+    if (!p)
+        throw std::bad_alloc();
+    return p;
+}
+
+static void *countedAlignedAlloc(std::size_t size, std::align_val_t align)
+{
+    alloc_count.fetch_add(1, std::memory_order_relaxed);
+    alloc_bytes.fetch_add(size, std::memory_order_relaxed);
+    std::size_t a = (std::size_t)align;
+#ifdef _WIN32
+    void *p = _aligned_malloc(size ? size : 1, a);
+#else
+    void *p = std::aligned_alloc(a, ((size ? size : 1) + a - 1) / a * a);
+#endif
+    if (!p)
+        throw std::bad_alloc();
+    return p;
+}
+
+static void countedAlignedFree(void *p)
+{
+#ifdef _WIN32
+    _aligned_free(p);
+#else
+    std::free(p);
+#endif
+}
+
+void *operator new(std::size_t size)
+{
+    return countedAlloc(size);
+}
+void *operator new[](std::size_t size)
+{
+    return countedAlloc(size);
+}
+void *operator new(std::size_t size, std::align_val_t align)
+{
+    return countedAlignedAlloc(size, align);
+}
+void *operator new[](std::size_t size, std::align_val_t align)
+{
+    return countedAlignedAlloc(size, align);
+}
+void operator delete(void *p) noexcept
+{
+    std::free(p);
+}
+void operator delete[](void *p) noexcept
+{
+    std::free(p);
+}
+void operator delete(void *p, std::size_t) noexcept
+{
+    std::free(p);
+}
+void operator delete[](void *p, std::size_t) noexcept
+{
+    std::free(p);
+}
+void operator delete(void *p, std::align_val_t) noexcept
+{
+    countedAlignedFree(p);
+}
+void operator delete[](void *p, std::align_val_t) noexcept
+{
+    countedAlignedFree(p);
+}
+void operator delete(void *p, std::size_t, std::align_val_t) noexcept
+{
+    countedAlignedFree(p);
+}
+void operator delete[](void *p, std::size_t, std::align_val_t) noexcept
+{
+    countedAlignedFree(p);
+}
+
+// ---- 计时框架 ----
+
+struct BenchResult
+{
+    std::string name;
+    uint64_t iterations;
+    double ns_per_op;
+    double allocs_per_op;
+    double bytes_per_op;
+};
+
+// body(n) 执行 n 次被测操作; 逐步加倍次数直到单轮耗时超过 min_time
+static BenchResult runBench(const char *name, double min_time, const std::function<void(uint64_t)> &body)
+{
+    body(16); // 预热
+
+    uint64_t n = 64;
+    for (;;)
+    {
+        uint64_t allocs_before = alloc_count.load();
+        uint64_t bytes_before = alloc_bytes.load();
+        auto start = std::chrono::steady_clock::now();
+        body(n);
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        uint64_t allocs = alloc_count.load() - allocs_before;
+        uint64_t bytes = alloc_bytes.load() - bytes_before;
+
+        if (elapsed >= min_time || n >= (1ull << 32))
+        {
+            BenchResult r;
+            r.name = name;
+            r.iterations = n;
+            r.ns_per_op = elapsed * 1e9 / n;
+            r.allocs_per_op = (double)allocs / n;
+            r.bytes_per_op = (double)bytes / n;
+            return r;
+        }
+        n = (elapsed > 0.0 && elapsed * 4 < min_time) ? n * 4 : n * 2;
+    }
+}
+
+// 防止编译器把结果优化掉
+static volatile double sink_value;
+static volatile uint32_t sink_mask;
+
+// ---- 测试数据 ----
+
+// 把仿真器推进到目标阶段, 之后从这份副本反复恢复, 使每次测量都停留在该阶段
+static Simulator prepareSimulator(EngineState target)
+{
+    Simulator sim;
+    sim.seed(1);
+    if (target == EngineState::OFF)
+        return sim;
+
+    sim.startEngine();
+    if (target == EngineState::STARTING)
+    {
+        // 停在启动阶段中段, 之后 256 步覆盖线性段和对数段
+        for (int i = 0; i < 300; i++)
+            sim.update();
+        return sim;
+    }
+
+    while (sim.getState() != EngineState::RUNNING)
+        sim.update();
+    for (int i = 0; i < 200; i++)
+        sim.update();
+    if (target == EngineState::STOPPING)
+        sim.stopEngine();
+    return sim;
+}
+
+static EngineSnapshot makeRunningData(int faults)
+{
+    Simulator sim = prepareSimulator(EngineState::RUNNING);
+    EngineSnapshot data = sim.getSnapshot();
+    if (faults >= 1)
+        data.rpm_1 = 42400.0; // 转速超过警戒值
+    if (faults > 1)
+    {
+        data.setNSensorValid(2, false);
+        data.setEgtSensorValid(3, false);
+        data.egt1_temp = 1000.0;
+        data.fuel_c = 500.0;
+        data.fuel_v = 55.0;
+    }
+    return data;
+}
+
+static void printUsage(const char *prog)
+{
+    std::printf("usage: %s [options]\n"
+                "  --filter TEXT      只运行名称包含 TEXT 的项目\n"
+                "  --min-time S       每项最短测量时长(秒), 默认 0.2\n"
+                "  --json FILE        JSON 结果写入文件, 默认输出到标准输出\n",
+                prog);
+}
+
+int main(int argc, char **argv)
+{
+    const char *filter = nullptr;
+    double min_time = 0.2;
+    const char *json_path = nullptr;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char *arg = argv[i];
+        bool has_value = (i + 1 < argc);
+        if (std::strcmp(arg, "--filter") == 0 && has_value)
+            filter = argv[++i];
+        else if (std::strcmp(arg, "--min-time") == 0 && has_value)
+            min_time = std::atof(argv[++i]);
+        else if (std::strcmp(arg, "--json") == 0 && has_value)
+            json_path = argv[++i];
+        else
+        {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    std::vector<BenchResult> results;
+    auto bench = [&](const char *name, const std::function<void(uint64_t)> &body) {
+        if (filter && !std::strstr(name, filter))
+            return;
+        results.push_back(runBench(name, min_time, body));
+        const BenchResult &r = results.back();
+        std::fprintf(stderr, "%-28s %12.1f ns/op %8.3f allocs/op\n", r.name.c_str(), r.ns_per_op, r.allocs_per_op);
+    };
+
+    // Simulator::update, 各阶段每 256 步从副本恢复一次 (恢复开销计入)
+    const EngineState sim_states[] = {EngineState::OFF, EngineState::STARTING, EngineState::RUNNING,
+                                      EngineState::STOPPING};
+    for (EngineState st : sim_states)
+    {
+        std::string name = std::string("sim_update_") + getEngineStateName(st);
+        Simulator base = prepareSimulator(st);
+        bench(name.c_str(), [&](uint64_t n) {
+            Simulator sim = base;
+            for (uint64_t i = 0; i < n; i++)
+            {
+                if ((i & 255) == 255)
+                    sim = base;
+                sim.update();
+            }
+            sink_value = sim.getN1();
+        });
+    }
+
+    // EICAS::judge, 0 / 1 / 多个同时存在的故障
+    // 时间固定不变: 告警在出现时刷新 5 秒显示, 时间推进会使告警很快过期, 三种情况就都成了无告警的路径
+    const int fault_cases[] = {0, 1, 5};
+    const char *fault_names[] = {"eicas_judge_0_faults", "eicas_judge_1_fault", "eicas_judge_many_faults"};
+    for (int k = 0; k < 3; k++)
+    {
+        EngineSnapshot data = makeRunningData(fault_cases[k]);
+        bench(fault_names[k], [&](uint64_t n) {
+            EICAS eicas;
+            ErrorType out[ERROR_TYPE_COUNT];
+            int total = 0;
+            for (uint64_t i = 0; i < n; i++)
+                total += eicas.judge(data, EngineState::RUNNING, 1.0, out, ERROR_TYPE_COUNT);
+            sink_mask = (uint32_t)total;
+        });
+    }
+
+    // 两次判断之间的逐步越限采样 (EICAS::sample), 对照上面的完整判断
+    {
+        EngineSnapshot data = makeRunningData(1);
+        bench("eicas_sample_step", [&](uint64_t n) {
+            EICAS eicas;
+            for (uint64_t i = 0; i < n; i++)
+                eicas.sample(data, EngineState::RUNNING);
+            sink_mask = eicas.judgeMask(data, EngineState::RUNNING, 0.0);
+        });
+    }
+
+    // 原始告警位掩码: 内置门限的专用判断、同一门限按规则数组判断、配置门限 (与内置不同) 编译出的规则程序
+    {
+        EngineSnapshot data = makeRunningData(1);
+        const EICASRuleProgram &builtin = EICASRuleProgram::builtin();
+        EngineLimits limits = builtin.getLimits();
+        limits.n1_amber = 41000.0;
+        EICASRuleProgram configured(limits);
+        bench("eicas_rules_specialized", [&](uint64_t n) {
+            uint32_t mask = 0;
+            for (uint64_t i = 0; i < n; i++)
+                mask += builtin.evaluate(data, EngineState::RUNNING);
+            sink_mask = mask;
+        });
+        bench("eicas_rules_table", [&](uint64_t n) {
+            uint32_t mask = 0;
+            for (uint64_t i = 0; i < n; i++)
+                mask += builtin.evaluateRules(data, EngineState::RUNNING);
+            sink_mask = mask;
+        });
+        bench("eicas_rules_configured", [&](uint64_t n) {
+            uint32_t mask = 0;
+            for (uint64_t i = 0; i < n; i++)
+                mask += configured.evaluate(data, EngineState::RUNNING);
+            sink_mask = mask;
+        });
+    }
+
+    // Logger::log / logAlert 写入临时文件
+    const std::string log_path = "benchmark_log.tmp";
+    EngineSnapshot log_data = makeRunningData(0);
+    const LogFormat formats[] = {LogFormat::CSV, LogFormat::BINARY};
+    const char *log_names[] = {"logger_log_csv", "logger_log_binary"};
+    for (int k = 0; k < 2; k++)
+    {
+        Logger logger(log_path, formats[k]);
+        bench(log_names[k], [&](uint64_t n) {
+            for (uint64_t i = 0; i < n; i++)
+                logger.log(i * 0.005, log_data, EngineState::RUNNING);
+        });
+    }
+    {
+        // 5 秒内重复的告警被去重表拦下, 不写文件
+        Logger logger(log_path);
+        const std::string msg = EICAS::getErrorMessage(ErrorType::OVERHEAT_EGT_3);
+        logger.logAlert(0.0, msg);
+        bench("logger_alert_dedup_hit", [&](uint64_t n) {
+            for (uint64_t i = 0; i < n; i++)
+                logger.logAlert(1.0, msg);
+        });
+    }
+    {
+        // 每次间隔超过 5 秒, 去重表未命中, 写入文件
+        Logger logger(log_path);
+        const std::string msg = EICAS::getErrorMessage(ErrorType::OVERHEAT_EGT_3);
+        double t = 0.0;
+        bench("logger_alert_dedup_miss", [&](uint64_t n) {
+            for (uint64_t i = 0; i < n; i++)
+            {
+                t += 5.5;
+                logger.logAlert(t, msg);
+            }
+        });
+    }
+    std::remove(log_path.c_str());
+    {
+        // 趋势金字塔逐样本更新 (每 64 个样本向上合并一次)
+        TrendPyramid trend;
+        bench("trend_pyramid_append", [&](uint64_t n) {
+            for (uint64_t i = 0; i < n; i++)
+            {
+                log_data.egt1_temp = 600.0 + (i & 63);
+                trend.append(i * 0.005, log_data);
+            }
+            sink_value = (double)trend.getSampleCount();
+        });
+    }
+
+    // 无界面的完整周期: SimThread::runCycle (操作、推进、日志、判断、保护、告警日志、发布快照)
+    // 一个 5 毫秒仿真周期, 以及界面 60 帧每秒时一帧对应的约 3 个仿真步;
+    // 故障经操作队列每 500 个周期通断一次, 使告警持续处于显示状态 (告警只在新出现时刷新 5 秒显示)
+    // 同一周期开启各阶段统计, 用于衡量 Profiler 常开的开销
+    const int cycle_steps[] = {1, 3, 1};
+    const char *cycle_names[] = {"frame_sim_cycle_1_step", "frame_60hz_3_steps", "frame_sim_cycle_profiled"};
+    for (int k = 0; k < 3; k++)
+    {
+        Simulator sim = prepareSimulator(EngineState::RUNNING);
+        EICAS eicas;
+        Logger logger(log_path);
+        SimThread cycle(sim, eicas, logger);
+        Profiler profiler;
+        if (k == 2)
+            cycle.setProfiler(&profiler);
+        Simulator base = sim;
+        bench(cycle_names[k], [&](uint64_t n) {
+            for (uint64_t i = 0; i < n; i++)
+            {
+                // 燃油耗尽前恢复到稳态
+                if ((i & 4095) == 4095)
+                    sim = base;
+                if (i % 500 == 0)
+                    cycle.sendCommand(SimCommandType::SET_FAULT,
+                                      (i % 1000 == 0) ? ErrorType::OVERHEAT_EGT_3 : ErrorType::NONE);
+                cycle.runCycle(cycle_steps[k]);
+                cycle.updateSnapshot();
+                sink_value = cycle.getSnapshot().data.rpm_1;
+            }
+        });
+    }
+    std::remove(log_path.c_str());
+
+    std::FILE *out = json_path ? std::fopen(json_path, "w") : stdout;
+    if (!out)
+    {
+        std::fprintf(stderr, "cannot write %s\n", json_path);
+        return 1;
+    }
+    std::fprintf(out, "{\n  \"judge_path\": \"%s\",\n  \"min_time_s\": %.3f,\n  \"benchmarks\": [\n",
+                 judgeBatchUsesAvx2() ? "avx2" : "scalar", min_time);
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        const BenchResult &r = results[i];
+        std::fprintf(out,
+                     "    {\"name\": \"%s\", \"iterations\": %llu, \"ns_per_op\": %.3f, \"allocs_per_op\": %.4f, "
+                     "\"bytes_per_op\": %.2f}%s\n",
+                     r.name.c_str(), (unsigned long long)r.iterations, r.ns_per_op, r.allocs_per_op, r.bytes_per_op,
+                     (i + 1 < results.size()) ? "," : "");
+    }
+    std::fprintf(out, "  ]\n}\n");
+    if (json_path)
+        std::fclose(out);
+    return 0;
+}
@@ -0,0 +1,19 @@
+// 将 BinaryLogger 写出的二进制日志转换为 Logger 的 CSV 格式
+#include "BinaryLogger.h"
+#include <cstdio>
+
+int main(int argc, char **argv)
+{
+    if (argc != 3)
+    {
+        std::printf("usage: %s <input.bin> <output.csv>\n", argv[0]);
+        return 1;
+    }
+
+    if (!BinaryLogger::convertToCsv(argv[1], argv[2]))
+    {
+        std::fprintf(stderr, "convert failed: %s -> %s\n", argv[1], argv[2]);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,74 @@
+// Logger 的 CSV 日志与 ColumnLogger 列式压缩日志互相转换, 按输入文件头自动判断方向
+#include "ColumnLogger.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+static long long fileSize(const char *path)
+{
+    std::FILE *f = std::fopen(path, "rb");
+    if (!f)
+        return -1;
+    std::fseek(f, 0, SEEK_END);
+    long long size = std::ftell(f);
+    std::fclose(f);
+    return size;
+}
+
+static bool isColumnLog(const char *path)
+{
+    std::FILE *f = std::fopen(path, "rb");
+    if (!f)
+        return false;
+    char magic[sizeof(COLUMN_LOG_MAGIC)] = {};
+    size_t n = std::fread(magic, 1, sizeof(magic), f);
+    std::fclose(f);
+    return n == sizeof(magic) && std::memcmp(magic, COLUMN_LOG_MAGIC, sizeof(magic)) == 0;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc != 3)
+    {
+        std::printf("usage: %s <input.csv|input.col> <output>\n"
+                    "  输入为 CSV 时输出列式日志, 输入为列式日志时输出 CSV\n",
+                    argv[0]);
+        return 1;
+    }
+
+    const char *in_path = argv[1];
+    const char *out_path = argv[2];
+    bool to_csv = isColumnLog(in_path);
+
+    auto start = std::chrono::steady_clock::now();
+    if (to_csv)
+    {
+        if (!ColumnLogReader::convertToCsv(in_path, out_path))
+        {
+            std::fprintf(stderr, "convert failed: %s -> %s\n", in_path, out_path);
+            return 1;
+        }
+    }
+    else
+    {
+        std::string error;
+        if (!ColumnLogger::convertFromCsv(in_path, out_path, error))
+        {
+            std::fprintf(stderr, "%s\n", error.c_str());
+            return 1;
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    long long in_size = fileSize(in_path);
+    long long out_size = fileSize(out_path);
+    long long csv_size = to_csv ? out_size : in_size;
+    long long column_size = to_csv ? in_size : out_size;
+    std::printf("direction        %s\n", to_csv ? "columnar -> csv" : "csv -> columnar");
+    std::printf("csv_bytes        %lld\n", csv_size);
+    std::printf("columnar_bytes   %lld\n", column_size);
+    std::printf("ratio            %.1fx\n", column_size > 0 ? (double)csv_size / column_size : 0.0);
+    std::printf("wall_time_s      %.3f\n", seconds);
+    return 0;
+}
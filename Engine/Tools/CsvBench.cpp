@@ -0,0 +1,109 @@
+// CSV 格式化基准: 原 iostream 写法与 CsvWriter 的每秒行数对比, 并校验两者输出逐字节一致
+#include "CsvWriter.h"
+#include "Simulator.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+struct Row
+{
+    double time;
+    EngineSnapshot data;
+};
+
+static double secondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static bool sameFile(const std::string &a, const std::string &b)
+{
+    std::FILE *fa = std::fopen(a.c_str(), "rb");
+    std::FILE *fb = std::fopen(b.c_str(), "rb");
+    bool same = fa && fb;
+    std::vector<char> ba(1 << 16), bb(1 << 16);
+    while (same)
+    {
+        size_t na = std::fread(ba.data(), 1, ba.size(), fa);
+        size_t nb = std::fread(bb.data(), 1, bb.size(), fb);
+        if (na != nb || std::memcmp(ba.data(), bb.data(), na) != 0)
+            same = false;
+        if (na == 0)
+            break;
+    }
+    if (fa)
+        std::fclose(fa);
+    if (fb)
+        std::fclose(fb);
+    return same;
+}
+
+int main(int argc, char **argv)
+{
+    long long rows = (argc > 1) ? std::atoll(argv[1]) : 2000000;
+    const int alert_every = 1000;
+    const char *alert = "CAUTION: EGT OVERHEAT";
+
+    // 用仿真器生成真实的数值分布
+    std::vector<Row> data;
+    data.reserve((size_t)rows);
+    Simulator sim;
+    sim.seed(1);
+    sim.startEngine();
+    for (long long i = 1; i <= rows; i++)
+    {
+        sim.update();
+        data.push_back({i * 0.005, sim.getSnapshot()});
+    }
+
+    const std::string old_path = "csvbench_iostream.csv";
+    const std::string new_path = "csvbench_writer.csv";
+
+    auto start = std::chrono::steady_clock::now();
+    {
+        std::ofstream out(old_path);
+        out << "Time(s),N1(RPM),N2(RPM),EGT1(C),EGT2(C),Fuel_Flow,Fuel_Quantity\n";
+        for (size_t i = 0; i < data.size(); i++)
+        {
+            const Row &r = data[i];
+            out << std::fixed << std::setprecision(3) << r.time << "," << r.data.rpm_1 << "," << r.data.rpm_2 << ","
+                << r.data.egt1_temp << "," << r.data.egt2_temp << "," << r.data.fuel_v << "," << r.data.fuel_c
+                << "\n";
+            if (i % alert_every == 0)
+                out << "ALERT," << std::fixed << std::setprecision(1) << r.time << ",MESSAGE:," << alert << "\n";
+        }
+    }
+    double old_seconds = secondsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    {
+        CsvWriter out;
+        out.open(new_path);
+        out.writeHeader();
+        size_t alert_len = std::strlen(alert);
+        for (size_t i = 0; i < data.size(); i++)
+        {
+            const Row &r = data[i];
+            out.writeSample(r.time, r.data);
+            if (i % alert_every == 0)
+                out.writeAlert(r.time, alert, alert_len);
+        }
+    }
+    double new_seconds = secondsSince(start);
+
+    bool identical = sameFile(old_path, new_path);
+    std::remove(old_path.c_str());
+    std::remove(new_path.c_str());
+
+    std::printf("rows               %lld\n", rows);
+    std::printf("iostream_rows_s    %.0f\n", rows / old_seconds);
+    std::printf("csvwriter_rows_s   %.0f\n", rows / new_seconds);
+    std::printf("speedup            %.2fx\n", old_seconds / new_seconds);
+    std::printf("identical_output   %s\n", identical ? "yes" : "NO");
+    return identical ? 0 : 1;
+}
@@ -0,0 +1,384 @@
+// 无界面批量运行: Simulator -> EICAS -> Logger, 不依赖墙钟时间, 以CPU最快速度推进仿真
+#include "EICAS.h"
+#include "FleetSimulator.h"
+#include "Logger.h"
+#include "Simulator.h"
+#include "TelemetryShm.h"
+#include "TelemetryStream.h"
+#include "Timer.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+static void printUsage(const char *prog)
+{
+    std::printf("usage: %s [options]\n"
+                "  --hours H          仿真时长(小时), 默认 10\n"
+                "  --seconds S        仿真时长(秒), 覆盖 --hours\n"
+                "  --judge-every N    每 N 个仿真步调用一次 EICAS::judge (其余步只采样越限), 默认 1\n"
+                "  --fault NAME       注入故障 (ErrorType 名称)\n"
+                "  --fault-at T       故障注入时刻(秒), 默认 0\n"
+                "  --fault-steps N    故障只持续 N 个仿真步后自动清除, 默认 0 (一直持续)\n"
+                "  --seed N           随机数种子, 默认 1\n"
+                "  --limits FILE      从配置文件加载告警门限 (格式见 eicas_limits.cfg), 默认使用内置门限\n"
+                "  --engine-type NAME 配置文件中的发动机型号, 默认 default\n"
+                "  --fleet N          使用 FleetSimulator 同时推进 N 台发动机并批量判断 (不写日志)\n"
+                "  --threads N        --fleet 模式下的线程数, 默认 1\n"
+                "  --log FILE         日志文件, 默认 headless.csv\n"
+                "  --binary           使用异步二进制日志 (LogFormat::BINARY)\n"
+                "  --columnar         使用列式压缩日志 (LogFormat::COLUMNAR, engine_colconv 转换为 CSV)\n"
+                "  --index            每个日志文件旁写出时间 / 报警索引 (文件名 + .idx, engine_logquery 查询)\n"
+                "  --trend            每个日志文件旁写出趋势图金字塔 (文件名 + .trend, engine_trend 查询)\n"
+                "  --rotate-mb N      日志文件达到 N MB 后换下一个文件 (run.csv, run.1.csv, ...)\n"
+                "  --rotate-seconds S 日志文件覆盖 S 秒仿真时间后换下一个文件\n"
+                "  --no-log           不写日志\n"
+                "  --shm NAME         每步数据和告警位掩码发布到共享内存 NAME (engine_shm_reader 读取)\n"
+                "  --udp HOST:PORT    每步数据按 UDP 数据报批量发送 (engine_telemetry_recv 接收)\n"
+                "  --unix PATH        同上, 发往 Unix 数据报套接字 PATH\n"
+                "  --realtime         按 5ms 实时步长运行, 不以最快速度推进\n",
+                prog);
+}
+
+static int runFleet(size_t engines, int threads, double sim_seconds, bool has_fault, ErrorType fault,
+                    double fault_at, long long fault_steps, uint64_t seed, const EICASRuleProgram &rules)
+{
+    FleetSimulator fleet(engines);
+    std::vector<uint32_t> masks(engines);
+    fleet.seed(seed);
+
+    const double dt = 0.005;
+    const long long total_steps = (long long)(sim_seconds / dt + 0.5);
+    const long long fault_step = (long long)(fault_at / dt + 0.5);
+
+    if (threads < 1)
+        threads = 1;
+    if ((size_t)threads > engines)
+        threads = (int)engines;
+
+    std::vector<long long> alert_counts(threads, 0);
+
+    fleet.startAll();
+
+    auto wall_start = std::chrono::steady_clock::now();
+
+    // 各发动机互不依赖且随机数按发动机独立, 每个线程推进自己的一段发动机直到结束, 结果与线程数无关
+    auto worker = [&](int t) {
+        size_t begin = engines * t / threads;
+        size_t end = engines * (t + 1) / threads;
+        long long alerts = 0;
+        for (long long step = 1; step <= total_steps; step++)
+        {
+            if (has_fault && step == fault_step + 1)
+            {
+                for (size_t i = begin; i < end; i++)
+                    fleet.setErrorType(i, fault);
+            }
+            if (has_fault && fault_steps > 0 && step == fault_step + 1 + fault_steps)
+            {
+                for (size_t i = begin; i < end; i++)
+                    fleet.setErrorType(i, ErrorType::NONE);
+            }
+            fleet.updateRange(begin, end);
+            judgeBatch(fleet.columns(begin, end), masks.data() + begin, rules.getLimits());
+
+            for (size_t i = begin; i < end; i++)
+                alerts += (masks[i] != 0);
+        }
+        alert_counts[t] = alerts;
+    };
+
+    std::vector<std::thread> pool;
+    for (int t = 1; t < threads; t++)
+        pool.emplace_back(worker, t);
+    worker(0);
+    for (auto &th : pool)
+        th.join();
+
+    long long alert_engine_steps = 0;
+    for (long long c : alert_counts)
+        alert_engine_steps += c;
+
+    auto wall_end = std::chrono::steady_clock::now();
+    double wall_seconds = std::chrono::duration<double>(wall_end - wall_start).count();
+    if (wall_seconds <= 0.0)
+        wall_seconds = 1e-9;
+
+    size_t running = 0;
+    for (size_t i = 0; i < engines; i++)
+    {
+        if (fleet.getState(i) == EngineState::RUNNING)
+            running++;
+    }
+
+    std::printf("engines              %zu\n", engines);
+    std::printf("threads              %d\n", threads);
+    std::printf("sim_time_s           %.3f\n", total_steps * dt);
+    std::printf("steps                %lld\n", total_steps);
+    std::printf("engines_running      %zu\n", running);
+    std::printf("alert_engine_steps   %lld\n", alert_engine_steps);
+    std::printf("judge_path           %s\n", judgeBatchUsesAvx2() ? "avx2" : "scalar");
+    std::printf("wall_time_s          %.3f\n", wall_seconds);
+    std::printf("engine_steps_per_sec %.0f\n", (double)total_steps * engines / wall_seconds);
+    std::printf("ns_per_engine_step   %.2f\n", wall_seconds * 1e9 / ((double)total_steps * engines));
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    double sim_seconds = 10.0 * 3600.0;
+    int judge_every = 1;
+    bool has_fault = false;
+    ErrorType fault = ErrorType::NONE;
+    double fault_at = 0.0;
+    long long fault_steps = 0;
+    uint64_t seed = 1;
+    int threads = 1;
+    std::string log_path = "headless.csv";
+    long long fleet_size = 0;
+    LogFormat log_format = LogFormat::CSV;
+    LogOptions log_options;
+    const char *shm_name = nullptr;
+    const char *udp_target = nullptr;
+    const char *unix_path = nullptr;
+    bool realtime = false;
+    const char *limits_path = nullptr;
+    const char *engine_type = "default";
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char *arg = argv[i];
+        bool has_value = (i + 1 < argc);
+        if (std::strcmp(arg, "--hours") == 0 && has_value)
+            sim_seconds = std::atof(argv[++i]) * 3600.0;
+        else if (std::strcmp(arg, "--seconds") == 0 && has_value)
+            sim_seconds = std::atof(argv[++i]);
+        else if (std::strcmp(arg, "--judge-every") == 0 && has_value)
+            judge_every = std::atoi(argv[++i]);
+        else if (std::strcmp(arg, "--fault") == 0 && has_value)
+        {
+            if (!EICAS::parseErrorName(argv[++i], fault) || fault == ErrorType::NONE)
+            {
+                std::fprintf(stderr, "unknown fault: %s\n", argv[i]);
+                return 1;
+            }
+            has_fault = true;
+        }
+        else if (std::strcmp(arg, "--fault-at") == 0 && has_value)
+            fault_at = std::atof(argv[++i]);
+        else if (std::strcmp(arg, "--fault-steps") == 0 && has_value)
+            fault_steps = std::atoll(argv[++i]);
+        else if (std::strcmp(arg, "--seed") == 0 && has_value)
+            seed = std::strtoull(argv[++i], nullptr, 10);
+        else if (std::strcmp(arg, "--log") == 0 && has_value)
+            log_path = argv[++i];
+        else if (std::strcmp(arg, "--threads") == 0 && has_value)
+            threads = std::atoi(argv[++i]);
+        else if (std::strcmp(arg, "--fleet") == 0 && has_value)
+            fleet_size = std::atoll(argv[++i]);
+        else if (std::strcmp(arg, "--binary") == 0)
+            log_format = LogFormat::BINARY;
+        else if (std::strcmp(arg, "--columnar") == 0)
+            log_format = LogFormat::COLUMNAR;
+        else if (std::strcmp(arg, "--index") == 0)
+            log_options.write_index = true;
+        else if (std::strcmp(arg, "--trend") == 0)
+            log_options.write_trend = true;
+        else if (std::strcmp(arg, "--rotate-mb") == 0 && has_value)
+            log_options.rotate_bytes = (uint64_t)(std::atof(argv[++i]) * 1024 * 1024);
+        else if (std::strcmp(arg, "--rotate-seconds") == 0 && has_value)
+            log_options.rotate_seconds = std::atof(argv[++i]);
+        else if (std::strcmp(arg, "--no-log") == 0)
+            log_path.clear();
+        else if (std::strcmp(arg, "--shm") == 0 && has_value)
+            shm_name = argv[++i];
+        else if (std::strcmp(arg, "--udp") == 0 && has_value)
+            udp_target = argv[++i];
+        else if (std::strcmp(arg, "--unix") == 0 && has_value)
+            unix_path = argv[++i];
+        else if (std::strcmp(arg, "--realtime") == 0)
+            realtime = true;
+        else if (std::strcmp(arg, "--limits") == 0 && has_value)
+            limits_path = argv[++i];
+        else if (std::strcmp(arg, "--engine-type") == 0 && has_value)
+            engine_type = argv[++i];
+        else
+        {
+            printUsage(argv[0]);
+            return (std::strcmp(arg, "--help") == 0) ? 0 : 1;
+        }
+    }
+    if (judge_every < 1)
+        judge_every = 1;
+
+    EICASRuleProgram rules;
+    if (limits_path)
+    {
+        EngineLimits limits;
+        std::string error;
+        if (!loadEngineLimits(limits_path, engine_type, limits, error))
+        {
+            std::fprintf(stderr, "%s\n", error.c_str());
+            return 1;
+        }
+        rules.compile(limits);
+    }
+
+    if (fleet_size > 0)
+        return runFleet((size_t)fleet_size, threads, sim_seconds, has_fault, fault, fault_at, fault_steps, seed,
+                        rules);
+
+    Simulator sim;
+    EICAS eicas;
+    eicas.setRules(&rules);
+    // 空路径时文件打开失败, Logger 的各接口自动变为空操作
+    Logger logger(log_path, log_format, log_options);
+
+    sim.seed(seed);
+
+    const double dt = 0.005;
+
+    TelemetryPublisher telemetry;
+    if (shm_name && !telemetry.open(shm_name, 4096, dt))
+    {
+        std::fprintf(stderr, "cannot create shared memory %s\n", shm_name);
+        return 1;
+    }
+    TelemetrySender stream;
+    if (udp_target)
+    {
+        std::string target(udp_target);
+        size_t colon = target.rfind(':');
+        if (colon == std::string::npos ||
+            !stream.openUdp(target.substr(0, colon), (uint16_t)std::atoi(target.c_str() + colon + 1)))
+        {
+            std::fprintf(stderr, "cannot open udp stream to %s\n", udp_target);
+            return 1;
+        }
+    }
+    else if (unix_path && !stream.openUnix(unix_path))
+    {
+        std::fprintf(stderr, "cannot open unix stream to %s\n", unix_path);
+        return 1;
+    }
+    Timer pacer(dt);
+    pacer.setPacing(true);
+
+    const long long total_steps = (long long)(sim_seconds / dt + 0.5);
+    const long long fault_step = (long long)(fault_at / dt + 0.5);
+
+    long long judge_calls = 0;
+    long long alert_frames = 0;
+    long long alerts_raised = 0;
+    long long auto_shutdowns = 0;
+
+    sim.startEngine();
+
+    auto wall_start = std::chrono::steady_clock::now();
+
+    for (long long step = 1; step <= total_steps; step++)
+    {
+        if (realtime)
+        {
+            pacer.tick();
+            while (!pacer.consumeStep())
+            {
+                pacer.waitNextStep();
+                pacer.tick();
+            }
+        }
+
+        // 用整数步数换算时间, 长时间运行不累积误差
+        double sim_time = step * dt;
+
+        if (has_fault && step == fault_step + 1)
+            sim.setErrorType(fault);
+        if (has_fault && fault_steps > 0 && step == fault_step + 1 + fault_steps)
+            sim.setErrorType(ErrorType::NONE);
+
+        sim.update();
+        logger.log(sim_time, sim.getSnapshot(), sim.getState());
+
+        if (step % judge_every != 0)
+        {
+            eicas.sample(sim.getSnapshot(), sim.getState());
+            telemetry.publish(sim_time, sim.getSnapshot(), sim.getState(), eicas.getActiveMask());
+            stream.push(sim_time, sim.getSnapshot(), sim.getState(), eicas.getActiveMask());
+            continue;
+        }
+
+        EngineState eng_state = sim.getState();
+        uint32_t shown_before = eicas.getActiveMask();
+        ErrorType detected_errors[ERROR_TYPE_COUNT];
+        int detected_count = eicas.judge(sim.getSnapshot(), eng_state, sim_time, detected_errors, ERROR_TYPE_COUNT);
+        judge_calls++;
+        if (detected_count > 0)
+            alert_frames++;
+        alerts_raised += countErrorBits(eicas.getActiveMask() & ~shown_before);
+
+        // 自动停车保护逻辑 (与 main.cpp 相同)
+        if (EICAS::hasCritical(eicas.getActiveMask()))
+        {
+            if (eng_state != EngineState::OFF && eng_state != EngineState::STOPPING)
+            {
+                sim.stopEngine();
+                logger.logAlert(sim_time, "SYSTEM: AUTO SHUTDOWN TRIGGERED");
+                auto_shutdowns++;
+            }
+        }
+
+        for (int i = 0; i < detected_count; i++)
+            logger.logAlert(sim_time, EICAS::getErrorMessage(detected_errors[i]));
+
+        telemetry.publish(sim_time, sim.getSnapshot(), eng_state, eicas.getActiveMask());
+        stream.push(sim_time, sim.getSnapshot(), eng_state, eicas.getActiveMask());
+    }
+    stream.flush();
+
+    auto wall_end = std::chrono::steady_clock::now();
+    double wall_seconds = std::chrono::duration<double>(wall_end - wall_start).count();
+    if (wall_seconds <= 0.0)
+        wall_seconds = 1e-9;
+
+    const EngineSnapshot &final_data = sim.getSnapshot();
+    std::printf("sim_time_s       %.3f\n", total_steps * dt);
+    std::printf("steps            %lld\n", total_steps);
+    std::printf("judge_calls      %lld\n", judge_calls);
+    std::printf("alert_frames     %lld\n", alert_frames);
+    std::printf("alerts_raised    %lld\n", alerts_raised);
+    std::printf("auto_shutdowns   %lld\n", auto_shutdowns);
+    std::printf("final_state      %s\n", getEngineStateName(sim.getState()));
+    std::printf("final_fuel_kg    %.3f\n", final_data.fuel_c);
+    std::printf("wall_time_s      %.3f\n", wall_seconds);
+    std::printf("steps_per_sec    %.0f\n", total_steps / wall_seconds);
+    std::printf("speedup          %.1fx\n", total_steps * dt / wall_seconds);
+
+    if (logger.getFileNames().size() > 1)
+        std::printf("log_files        %zu\n", logger.getFileNames().size());
+    if (log_format == LogFormat::BINARY && logger.isOpen())
+    {
+        BinaryLoggerStats stats = logger.getBinaryStats();
+        std::printf("log_pushed       %llu\n", (unsigned long long)stats.records_pushed);
+        std::printf("log_overflows    %llu\n", (unsigned long long)stats.ring_overflows);
+        std::printf("log_max_lag      %llu\n", (unsigned long long)stats.max_lag_records);
+        std::printf("log_max_write_ms %.3f\n", stats.max_write_ms);
+    }
+    if (log_format == LogFormat::COLUMNAR && logger.isOpen())
+    {
+        ColumnLoggerStats stats = logger.getColumnStats();
+        std::printf("log_chunks       %llu\n", (unsigned long long)stats.chunks);
+        std::printf("log_max_encode_ms %.3f\n", stats.max_encode_ms);
+    }
+    if (stream.isOpen())
+    {
+        TelemetrySendStats stats = stream.getStats();
+        std::printf("stream_samples   %llu\n", (unsigned long long)stats.samples);
+        std::printf("stream_packets   %llu\n", (unsigned long long)stats.packets_sent);
+        std::printf("stream_dropped   %llu\n", (unsigned long long)stats.packets_dropped);
+        std::printf("stream_bytes     %llu\n", (unsigned long long)stats.bytes_sent);
+    }
+    return 0;
+}
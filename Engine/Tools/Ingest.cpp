@@ -0,0 +1,250 @@
+// 外部传感器帧输入: 从管道 / 文件 / TCP 接收传感器帧, 全速送入 EICAS 判断、日志和遥测发布, 统计输入到告警的延迟
+// 时间线格式与 engine_replay 相同: Time(s),Event,Alert,Message
+#include "EICAS.h"
+#include "Logger.h"
+#include "Profiler.h"
+#include "SensorIngest.h"
+#include "TelemetryShm.h"
+#include "TelemetryStream.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+static void printUsage(const char *prog)
+{
+    std::printf("usage: %s [options]\n"
+                "  --in PATH          从文件或命名管道读取, \"-\" 为标准输入 (默认)\n"
+                "  --tcp PORT         在 TCP 端口 PORT 上监听, 接收第一个连接的数据\n"
+                "  --log FILE         记录数值数据和告警 (与 engine_headless 的日志格式相同)\n"
+                "  --binary           使用二进制日志格式\n"
+                "  --columnar         使用列式压缩日志 (LogFormat::COLUMNAR, engine_colconv 转换为 CSV)\n"
+                "  --index            每个日志文件旁写出时间 / 报警索引 (文件名 + .idx, engine_logquery 查询)\n"
+                "  --trend            每个日志文件旁写出趋势图金字塔 (文件名 + .trend, engine_trend 查询)\n"
+                "  --rotate-mb N      日志文件达到 N MB 后换下一个文件 (run.csv, run.1.csv, ...)\n"
+                "  --rotate-seconds S 日志文件覆盖 S 秒仿真时间后换下一个文件\n"
+                "  --shm NAME         每帧数据和告警位掩码发布到共享内存 NAME, 供显示端读取\n"
+                "  --udp HOST:PORT    每帧数据按 UDP 数据报批量发往远程显示\n"
+                "  --limits FILE      从配置文件加载告警门限 (格式见 eicas_limits.cfg), 默认使用内置门限\n"
+                "  --engine-type NAME 配置文件中的发动机型号, 默认 default\n"
+                "  --quiet            不输出告警时间线, 只输出统计\n",
+                prog);
+}
+
+static void emitChanges(uint32_t before, uint32_t after, double time, bool quiet, uint64_t &raised_total)
+{
+    uint32_t raised = after & ~before;
+    uint32_t cleared = before & ~after;
+    raised_total += countErrorBits(raised);
+    if (quiet)
+        return;
+
+    for (int i = 1; i < ERROR_TYPE_COUNT; i++)
+    {
+        ErrorType err = (ErrorType)i;
+        if (raised & errorBit(err))
+            std::printf("%.3f,RAISE,%s,%s\n", time, EICAS::getErrorName(err), EICAS::getErrorMessage(err));
+        if (cleared & errorBit(err))
+            std::printf("%.3f,CLEAR,%s,%s\n", time, EICAS::getErrorName(err), EICAS::getErrorMessage(err));
+    }
+}
+
+static void printLatency(const char *name, const LatencyHistogram &h)
+{
+    if (h.getCount() == 0)
+    {
+        std::printf("%-16s n=0\n", name);
+        return;
+    }
+    std::printf("%-16s n=%llu min=%.1fus mean=%.1fus p50=%.1fus p99=%.1fus max=%.1fus\n", name,
+                (unsigned long long)h.getCount(), h.getMin() / 1000.0, h.getMean() / 1000.0,
+                h.getPercentile(50.0) / 1000.0, h.getPercentile(99.0) / 1000.0, h.getMax() / 1000.0);
+}
+
+int main(int argc, char **argv)
+{
+    const char *in_path = "-";
+    int tcp_port = 0;
+    const char *log_path = "";
+    LogFormat log_format = LogFormat::CSV;
+    LogOptions log_options;
+    const char *shm_name = nullptr;
+    const char *udp_target = nullptr;
+    bool quiet = false;
+    const char *limits_path = nullptr;
+    const char *engine_type = "default";
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char *arg = argv[i];
+        bool has_value = (i + 1 < argc);
+        if (std::strcmp(arg, "--in") == 0 && has_value)
+            in_path = argv[++i];
+        else if (std::strcmp(arg, "--tcp") == 0 && has_value)
+            tcp_port = std::atoi(argv[++i]);
+        else if (std::strcmp(arg, "--log") == 0 && has_value)
+            log_path = argv[++i];
+        else if (std::strcmp(arg, "--binary") == 0)
+            log_format = LogFormat::BINARY;
+        else if (std::strcmp(arg, "--columnar") == 0)
+            log_format = LogFormat::COLUMNAR;
+        else if (std::strcmp(arg, "--index") == 0)
+            log_options.write_index = true;
+        else if (std::strcmp(arg, "--trend") == 0)
+            log_options.write_trend = true;
+        else if (std::strcmp(arg, "--rotate-mb") == 0 && has_value)
+            log_options.rotate_bytes = (uint64_t)(std::atof(argv[++i]) * 1024 * 1024);
+        else if (std::strcmp(arg, "--rotate-seconds") == 0 && has_value)
+            log_options.rotate_seconds = std::atof(argv[++i]);
+        else if (std::strcmp(arg, "--shm") == 0 && has_value)
+            shm_name = argv[++i];
+        else if (std::strcmp(arg, "--udp") == 0 && has_value)
+            udp_target = argv[++i];
+        else if (std::strcmp(arg, "--quiet") == 0)
+            quiet = true;
+        else if (std::strcmp(arg, "--limits") == 0 && has_value)
+            limits_path = argv[++i];
+        else if (std::strcmp(arg, "--engine-type") == 0 && has_value)
+            engine_type = argv[++i];
+        else
+        {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    EICASRuleProgram rules;
+    if (limits_path)
+    {
+        EngineLimits limits;
+        std::string error;
+        if (!loadEngineLimits(limits_path, engine_type, limits, error))
+        {
+            std::fprintf(stderr, "%s\n", error.c_str());
+            return 1;
+        }
+        rules.compile(limits);
+    }
+
+    TelemetryPublisher telemetry;
+    if (shm_name && !telemetry.open(shm_name))
+    {
+        std::fprintf(stderr, "cannot create shared memory %s\n", shm_name);
+        return 1;
+    }
+    TelemetrySender stream;
+    if (udp_target)
+    {
+        std::string target(udp_target);
+        size_t colon = target.rfind(':');
+        if (colon == std::string::npos ||
+            !stream.openUdp(target.substr(0, colon), (uint16_t)std::atoi(target.c_str() + colon + 1)))
+        {
+            std::fprintf(stderr, "cannot open udp stream to %s\n", udp_target);
+            return 1;
+        }
+    }
+
+    SensorFrameSource source;
+    bool opened = tcp_port > 0 ? source.listenTcp((uint16_t)tcp_port) : source.openPath(in_path);
+    if (!opened)
+    {
+        if (tcp_port > 0)
+            std::fprintf(stderr, "cannot accept on tcp port %d\n", tcp_port);
+        else
+            std::fprintf(stderr, "cannot open %s\n", in_path);
+        return 1;
+    }
+
+    // 空路径时文件打开失败, Logger 的各接口自动变为空操作
+    Logger logger(log_path, log_format, log_options);
+    EICAS eicas;
+    eicas.setRules(&rules);
+
+    // 输入到判断: 发送端写出到本帧判断完成; 输入到告警: 只统计产生新告警的帧
+    LatencyHistogram judge_latency;
+    LatencyHistogram alert_latency;
+
+    uint64_t alerts_raised = 0;
+    uint64_t shutdown_requests = 0;
+    uint64_t batches = 0;
+    uint32_t shown = 0;
+    bool critical = false;
+
+    auto wall_start = std::chrono::steady_clock::now();
+    auto first_frame = wall_start;
+
+    const SensorFrame *frames = nullptr;
+    int n;
+    while ((n = source.read(frames, 100)) >= 0)
+    {
+        if (n == 0)
+            continue;
+        if (batches++ == 0)
+            first_frame = std::chrono::steady_clock::now();
+
+        for (int i = 0; i < n; i++)
+        {
+            const SensorFrame &f = frames[i];
+            EngineSnapshot data = {};
+            sensorFrameToSnapshot(f, data);
+            EngineState state = (EngineState)f.state;
+
+            logger.log(f.time, data, state);
+
+            ErrorType detected_errors[ERROR_TYPE_COUNT];
+            int detected_count = eicas.judge(data, state, f.time, detected_errors, ERROR_TYPE_COUNT);
+            uint32_t now_shown = eicas.getActiveMask();
+
+            int64_t latency = sensorClockNs() - f.send_ns;
+            if (latency < 0)
+                latency = 0;
+            judge_latency.record((uint64_t)latency);
+            if (now_shown & ~shown)
+                alert_latency.record((uint64_t)latency);
+
+            // 外部数据源无法由本程序停车, 只在出现严重告警时记录一次停车请求
+            bool now_critical = EICAS::hasCritical(now_shown) && state != EngineState::OFF &&
+                                state != EngineState::STOPPING;
+            if (now_critical && !critical)
+            {
+                logger.logAlert(f.time, "SYSTEM: AUTO SHUTDOWN TRIGGERED");
+                shutdown_requests++;
+            }
+            critical = now_critical;
+
+            for (int k = 0; k < detected_count; k++)
+                logger.logAlert(f.time, EICAS::getErrorMessage(detected_errors[k]));
+
+            telemetry.publish(f.time, data, state, now_shown);
+            stream.push(f.time, data, state, now_shown);
+
+            if (now_shown != shown)
+            {
+                emitChanges(shown, now_shown, f.time, quiet, alerts_raised);
+                shown = now_shown;
+            }
+        }
+    }
+    stream.flush();
+
+    double wall_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - first_frame).count();
+    if (wall_seconds <= 0.0)
+        wall_seconds = 1e-9;
+
+    SensorIngestStats stats = source.getStats();
+    std::printf("frames           %llu\n", (unsigned long long)stats.frames);
+    std::printf("bytes            %llu\n", (unsigned long long)stats.bytes);
+    std::printf("reads            %llu\n", (unsigned long long)stats.reads);
+    std::printf("frames_per_read  %.1f\n", stats.reads ? (double)stats.frames / stats.reads : 0.0);
+    std::printf("skipped_bytes    %llu\n", (unsigned long long)stats.skipped);
+    std::printf("missing_frames   %llu\n", (unsigned long long)stats.missing);
+    std::printf("alerts_raised    %llu\n", (unsigned long long)alerts_raised);
+    std::printf("shutdown_reqs    %llu\n", (unsigned long long)shutdown_requests);
+    std::printf("wall_time_s      %.3f\n", wall_seconds);
+    std::printf("frames_per_sec   %.0f\n", stats.frames / wall_seconds);
+    printLatency("ingest_to_judge", judge_latency);
+    printLatency("ingest_to_alert", alert_latency);
+    return 0;
+}
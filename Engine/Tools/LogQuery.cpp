@@ -0,0 +1,214 @@
+// 按时间窗或报警文本查询带索引的日志 (Logger 的 CSV / 列式格式), 通过内存映射只读取命中的块
+#include "CsvWriter.h"
+#include "EICAS.h"
+#include "LogIndex.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+static void printUsage(const char *prog)
+{
+    std::printf("usage: %s <log>... [options]\n"
+                "  --build            先为日志 (重新) 生成索引, 用于已有日志或过期的索引\n"
+                "  --from T           时间窗起点, 秒数或 3h12m5s 形式\n"
+                "  --to T             时间窗终点, 默认起点后 1 秒\n"
+                "  --alert TEXT       列出文本为 TEXT 的报警, 也可以是 ErrorType 名称 (按其告警文本匹配)\n"
+                "  --out FILE         时间窗内的数值行和报警写成 CSV, 默认只输出统计\n"
+                "  多个日志 (如分卷的 run.csv run.1.csv ...) 依次查询\n",
+                prog);
+}
+
+// 秒数, 或由 h / m / s 单位组成的时长 (如 3h12m, 1h30s)
+static bool parseTime(const char *text, double &seconds)
+{
+    seconds = 0.0;
+    const char *p = text;
+    while (*p)
+    {
+        char *end;
+        double v = std::strtod(p, &end);
+        if (end == p)
+            return false;
+        double unit = 1.0;
+        if (*end == 'h')
+            unit = 3600.0;
+        else if (*end == 'm')
+            unit = 60.0;
+        if (*end == 'h' || *end == 'm' || *end == 's')
+            end++;
+        else if (*end != '\0')
+            return false;
+        seconds += v * unit;
+        p = end;
+    }
+    return p != text;
+}
+
+static double elapsedMs(std::chrono::steady_clock::time_point since)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - since).count();
+}
+
+static void writeWindow(CsvWriter &csv, const ColumnChunk &window)
+{
+    EngineSnapshot data = {};
+    size_t next_alert = 0;
+    for (uint32_t i = 0; i <= window.rows; i++)
+    {
+        while (next_alert < window.alerts.size() && window.alerts[next_alert].row <= i)
+        {
+            const ColumnAlert &a = window.alerts[next_alert++];
+            csv.writeAlert(a.time, a.text.data(), a.text.size());
+        }
+        if (i == window.rows)
+            break;
+        data.rpm_1 = window.values[0][i];
+        data.rpm_2 = window.values[1][i];
+        data.egt1_temp = window.values[2][i];
+        data.egt2_temp = window.values[3][i];
+        data.fuel_v = window.values[4][i];
+        data.fuel_c = window.values[5][i];
+        csv.writeSample(window.time[i], data);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    std::vector<const char *> logs;
+    bool build = false;
+    bool has_window = false;
+    double from = 0.0;
+    double to = -1.0;
+    std::string alert_text;
+    const char *out_path = nullptr;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char *arg = argv[i];
+        bool has_value = (i + 1 < argc);
+        if (std::strcmp(arg, "--build") == 0)
+            build = true;
+        else if (std::strcmp(arg, "--from") == 0 && has_value)
+        {
+            if (!parseTime(argv[++i], from))
+            {
+                std::fprintf(stderr, "bad time: %s\n", argv[i]);
+                return 1;
+            }
+            has_window = true;
+        }
+        else if (std::strcmp(arg, "--to") == 0 && has_value)
+        {
+            if (!parseTime(argv[++i], to))
+            {
+                std::fprintf(stderr, "bad time: %s\n", argv[i]);
+                return 1;
+            }
+            has_window = true;
+        }
+        else if (std::strcmp(arg, "--alert") == 0 && has_value)
+        {
+            alert_text = argv[++i];
+            ErrorType error;
+            if (EICAS::parseErrorName(alert_text.c_str(), error) && error != ErrorType::NONE)
+                alert_text = EICAS::getErrorMessage(error);
+        }
+        else if (std::strcmp(arg, "--out") == 0 && has_value)
+            out_path = argv[++i];
+        else if (arg[0] != '-')
+            logs.push_back(arg);
+        else
+        {
+            printUsage(argv[0]);
+            return (std::strcmp(arg, "--help") == 0) ? 0 : 1;
+        }
+    }
+    if (logs.empty())
+    {
+        printUsage(argv[0]);
+        return 1;
+    }
+    if (to < from)
+        to = from + 1.0;
+
+    CsvWriter csv;
+    if (out_path)
+    {
+        if (!csv.open(out_path))
+        {
+            std::fprintf(stderr, "cannot write %s\n", out_path);
+            return 1;
+        }
+        csv.writeHeader();
+    }
+
+    uint64_t total_rows = 0;
+    uint64_t total_alerts = 0;
+    for (const char *path : logs)
+    {
+        std::string error;
+        if (build)
+        {
+            auto start = std::chrono::steady_clock::now();
+            if (!LogIndex::build(path, error))
+            {
+                std::fprintf(stderr, "%s\n", error.c_str());
+                return 1;
+            }
+            std::printf("%s: index built in %.1f ms\n", path, elapsedMs(start));
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        LogIndex index;
+        if (!index.open(path, error))
+        {
+            std::fprintf(stderr, "%s\n", error.c_str());
+            return 1;
+        }
+        const LogIndexHeader &h = index.getHeader();
+        std::printf("%s: %s, %u chunks, %u alerts, %.3f - %.3f s, opened in %.3f ms\n", path,
+                    h.log_format == (uint32_t)LogIndexFormat::COLUMNAR ? "columnar" : "csv", h.chunk_count,
+                    h.alert_count, h.first_time, h.last_time, elapsedMs(start));
+
+        if (has_window)
+        {
+            start = std::chrono::steady_clock::now();
+            size_t first, last;
+            index.findChunks(from, to, first, last);
+            ColumnChunk window;
+            window.rows = 0;
+            if (!index.readWindow(from, to, window))
+            {
+                std::fprintf(stderr, "%s: corrupt chunk in window\n", path);
+                return 1;
+            }
+            std::printf("  window %.3f - %.3f s: %zu chunks read, %u rows, %zu alerts, %.3f ms\n", from, to,
+                        last - first, window.rows, window.alerts.size(), elapsedMs(start));
+            for (const ColumnAlert &a : window.alerts)
+                std::printf("    %.3f  %s\n", a.time, a.text.c_str());
+            if (out_path)
+                writeWindow(csv, window);
+            total_rows += window.rows;
+            total_alerts += window.alerts.size();
+        }
+
+        if (!alert_text.empty())
+        {
+            start = std::chrono::steady_clock::now();
+            std::vector<LogIndexAlert> found;
+            index.findAlerts(alert_text, found);
+            std::printf("  alert \"%s\": %zu found, %.3f ms\n", alert_text.c_str(), found.size(), elapsedMs(start));
+            for (const LogIndexAlert &a : found)
+                std::printf("    %.3f  chunk %u  offset %llu\n", a.time, a.chunk, (unsigned long long)a.offset);
+            total_alerts += found.size();
+        }
+    }
+
+    if (logs.size() > 1)
+        std::printf("total: %llu rows, %llu alerts\n", (unsigned long long)total_rows,
+                    (unsigned long long)total_alerts);
+    return 0;
+}
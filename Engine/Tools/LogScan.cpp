@@ -0,0 +1,155 @@
+// 多个日志文件的并行统计: 各通道极值与均值、高于门限的时长、每次启动循环的最高排气温度、各报警次数
+#include "EICASBatch.h"
+#include "LogScan.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+static void printUsage(const char *prog)
+{
+    std::printf("usage: %s <log>... [options]\n"
+                "  --above CH:VALUE   统计通道 CH 高于 VALUE 的时长, 可重复; CH 为 N1 N2 EGT1 EGT2 FUEL_FLOW FUEL_QTY\n"
+                "  --threads N        扫描线程数, 默认 CPU 核数\n"
+                "  --split-mb N       CSV 每个并行分段的大小 (MB), 默认 16\n"
+                "  --cycles           列出每次启动循环的最高排气温度\n"
+                "  --per-file         逐个文件输出统计\n"
+                "  日志可以是 CSV 或列式格式, 可混合\n",
+                prog);
+}
+
+static bool parseExceed(const char *text, ExceedQuery &q)
+{
+    const char *colon = std::strchr(text, ':');
+    if (!colon)
+        return false;
+    std::string name(text, colon);
+    char *end;
+    q.threshold = std::strtod(colon + 1, &end);
+    return end != colon + 1 && *end == '\0' && parseLogChannel(name.c_str(), q.channel);
+}
+
+static void printResult(const LogScanResult &r, const LogScanOptions &options, bool list_cycles)
+{
+    std::printf("rows             %llu\n", (unsigned long long)r.rows);
+    if (r.bad_lines > 0)
+        std::printf("bad_lines        %llu\n", (unsigned long long)r.bad_lines);
+    std::printf("time_span_s      %.3f - %.3f\n", r.first_time, r.last_time);
+    std::printf("%-10s %12s %12s %12s\n", "channel", "min", "max", "mean");
+    for (int c = 0; c < COLUMN_LOG_CHANNELS; c++)
+    {
+        const ChannelSummary &s = r.channels[c];
+        if (s.count == 0)
+            std::printf("%-10s %12s %12s %12s\n", logChannelName(c), "--", "--", "--");
+        else
+            std::printf("%-10s %12.3f %12.3f %12.3f\n", logChannelName(c), s.min, s.max, s.sum / s.count);
+    }
+    for (size_t k = 0; k < options.exceed.size(); k++)
+    {
+        const ExceedQuery &q = options.exceed[k];
+        std::printf("above %s > %g: %.3f s (%llu rows)\n", logChannelName(q.channel), q.threshold,
+                    r.exceed[k].seconds, (unsigned long long)r.exceed[k].rows);
+    }
+
+    double max_egt = -1.0;
+    for (const StartCycle &c : r.cycles)
+        max_egt = c.max_egt > max_egt ? c.max_egt : max_egt;
+    std::printf("start_cycles     %zu", r.cycles.size());
+    if (!r.cycles.empty())
+        std::printf(", highest EGT %.3f", max_egt);
+    std::printf("\n");
+    if (list_cycles)
+    {
+        for (size_t k = 0; k < r.cycles.size(); k++)
+            std::printf("  cycle %zu: start %.3f s, max EGT %.3f\n", k + 1, r.cycles[k].start_time,
+                        r.cycles[k].max_egt);
+    }
+
+    for (const auto &alert : r.alerts)
+        std::printf("alert %8llu  %s\n", (unsigned long long)alert.second, alert.first.c_str());
+}
+
+int main(int argc, char **argv)
+{
+    std::vector<std::string> logs;
+    LogScanOptions options;
+    options.threads = (int)std::thread::hardware_concurrency();
+    options.split_bytes = 16u << 20;
+    bool list_cycles = false;
+    bool per_file = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char *arg = argv[i];
+        bool has_value = (i + 1 < argc);
+        if (std::strcmp(arg, "--above") == 0 && has_value)
+        {
+            ExceedQuery q;
+            if (!parseExceed(argv[++i], q))
+            {
+                std::fprintf(stderr, "bad --above: %s\n", argv[i]);
+                return 1;
+            }
+            options.exceed.push_back(q);
+        }
+        else if (std::strcmp(arg, "--threads") == 0 && has_value)
+            options.threads = std::atoi(argv[++i]);
+        else if (std::strcmp(arg, "--split-mb") == 0 && has_value)
+            options.split_bytes = (size_t)(std::atof(argv[++i]) * 1024 * 1024);
+        else if (std::strcmp(arg, "--cycles") == 0)
+            list_cycles = true;
+        else if (std::strcmp(arg, "--per-file") == 0)
+            per_file = true;
+        else if (arg[0] != '-')
+            logs.push_back(arg);
+        else
+        {
+            printUsage(argv[0]);
+            return (std::strcmp(arg, "--help") == 0) ? 0 : 1;
+        }
+    }
+    if (logs.empty())
+    {
+        printUsage(argv[0]);
+        return 1;
+    }
+    if (options.threads < 1)
+        options.threads = 1;
+
+    auto start = std::chrono::steady_clock::now();
+    LogScanner scanner(options);
+    std::vector<LogScanResult> results;
+    std::string error;
+    if (!scanner.scan(logs, results, error))
+    {
+        std::fprintf(stderr, "%s\n", error.c_str());
+        return 1;
+    }
+    LogScanResult total;
+    LogScanner::reset(total, options.exceed.size());
+    for (const LogScanResult &r : results)
+        LogScanner::addFile(total, r);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    if (per_file)
+    {
+        for (const LogScanResult &r : results)
+        {
+            std::printf("== %s (%llu bytes)\n", r.path.c_str(), (unsigned long long)r.bytes);
+            printResult(r, options, list_cycles);
+        }
+        std::printf("== total\n");
+    }
+    printResult(total, options, list_cycles && !per_file);
+
+    std::printf("files            %zu\n", logs.size());
+    std::printf("bytes            %llu\n", (unsigned long long)total.bytes);
+    std::printf("threads          %d%s\n", options.threads, judgeBatchUsesAvx2() ? " (avx2)" : "");
+    std::printf("time_to_result_s %.3f\n", seconds);
+    std::printf("throughput_mb_s  %.0f\n", total.bytes / (1024.0 * 1024.0) / (seconds > 0.0 ? seconds : 1e-9));
+    std::printf("rows_per_sec     %.0f\n", total.rows / (seconds > 0.0 ? seconds : 1e-9));
+    return 0;
+}
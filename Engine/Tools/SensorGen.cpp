@@ -0,0 +1,156 @@
+// 传感器帧发生器: 用 Simulator 产生传感器帧, 写到标准输出 / 文件 / 命名管道或 TCP 连接, 供 engine_ingest 测试
+// 帧数据写到标准输出时统计信息输出到标准错误
+#include "EICAS.h"
+#include "SensorIngest.h"
+#include "Simulator.h"
+#include "Timer.h"
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+static void printUsage(const char *prog)
+{
+    std::fprintf(stderr,
+                 "usage: %s [options]\n"
+                 "  --out PATH         输出到文件或命名管道, \"-\" 为标准输出 (默认)\n"
+                 "  --tcp HOST:PORT    连接到 engine_ingest --tcp 监听的端口\n"
+                 "  --seconds S        仿真时长(秒), 默认 60\n"
+                 "  --rate HZ          每秒发送的帧数, 0 表示不限速 (默认); 200 即 5ms 仿真步长的实时速率\n"
+                 "  --batch N          不限速时每次写出的帧数, 默认 64\n"
+                 "  --fault NAME       注入故障 (ErrorType 名称)\n"
+                 "  --fault-at T       故障注入时刻(秒), 默认 0\n"
+                 "  --seed N           随机数种子, 默认 1\n",
+                 prog);
+}
+
+int main(int argc, char **argv)
+{
+    const char *out_path = "-";
+    const char *tcp_target = nullptr;
+    double sim_seconds = 60.0;
+    double rate = 0.0;
+    int batch = 64;
+    bool has_fault = false;
+    ErrorType fault = ErrorType::NONE;
+    double fault_at = 0.0;
+    uint64_t seed = 1;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char *arg = argv[i];
+        bool has_value = (i + 1 < argc);
+        if (std::strcmp(arg, "--out") == 0 && has_value)
+            out_path = argv[++i];
+        else if (std::strcmp(arg, "--tcp") == 0 && has_value)
+            tcp_target = argv[++i];
+        else if (std::strcmp(arg, "--seconds") == 0 && has_value)
+            sim_seconds = std::atof(argv[++i]);
+        else if (std::strcmp(arg, "--rate") == 0 && has_value)
+            rate = std::atof(argv[++i]);
+        else if (std::strcmp(arg, "--batch") == 0 && has_value)
+            batch = std::atoi(argv[++i]);
+        else if (std::strcmp(arg, "--fault") == 0 && has_value)
+        {
+            if (!EICAS::parseErrorName(argv[++i], fault) || fault == ErrorType::NONE)
+            {
+                std::fprintf(stderr, "unknown fault: %s\n", argv[i]);
+                return 1;
+            }
+            has_fault = true;
+        }
+        else if (std::strcmp(arg, "--fault-at") == 0 && has_value)
+            fault_at = std::atof(argv[++i]);
+        else if (std::strcmp(arg, "--seed") == 0 && has_value)
+            seed = std::strtoull(argv[++i], nullptr, 10);
+        else
+        {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+    if (batch < 1)
+        batch = 1;
+    if (rate > 0.0)
+        batch = 1;
+
+#ifndef _WIN32
+    // 接收端退出时 write 返回错误, 而不是被 SIGPIPE 终止
+    std::signal(SIGPIPE, SIG_IGN);
+#endif
+
+    SensorFrameSink sink;
+    if (tcp_target)
+    {
+        std::string target(tcp_target);
+        size_t colon = target.rfind(':');
+        if (colon == std::string::npos ||
+            !sink.connectTcp(target.substr(0, colon), (uint16_t)std::atoi(target.c_str() + colon + 1)))
+        {
+            std::fprintf(stderr, "cannot connect to %s\n", tcp_target);
+            return 1;
+        }
+    }
+    else if (!sink.openPath(out_path))
+    {
+        std::fprintf(stderr, "cannot open %s\n", out_path);
+        return 1;
+    }
+
+    Simulator sim;
+    sim.seed(seed);
+    sim.startEngine();
+
+    const double dt = 0.005;
+    const long long total_steps = (long long)(sim_seconds / dt + 0.5);
+    const long long fault_step = (long long)(fault_at / dt + 0.5);
+
+    Timer pacer(rate > 0.0 ? 1.0 / rate : dt);
+    pacer.setPacing(true);
+
+    std::vector<SensorFrame> frames(batch);
+    int pending = 0;
+    long long sent = 0;
+    bool ok = true;
+
+    auto wall_start = std::chrono::steady_clock::now();
+
+    for (long long step = 1; step <= total_steps && ok; step++)
+    {
+        if (has_fault && step == fault_step + 1)
+            sim.setErrorType(fault);
+        sim.update();
+        frames[pending++] = makeSensorFrame((uint32_t)(step - 1), step * dt, sim.getSnapshot(), sim.getState());
+
+        if (pending < batch && step < total_steps)
+            continue;
+
+        if (rate > 0.0)
+        {
+            pacer.tick();
+            while (!pacer.consumeStep())
+            {
+                pacer.waitNextStep();
+                pacer.tick();
+            }
+        }
+        ok = sink.write(frames.data(), pending);
+        if (ok)
+            sent += pending;
+        pending = 0;
+    }
+    sink.close();
+
+    double wall_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall_start).count();
+    if (wall_seconds <= 0.0)
+        wall_seconds = 1e-9;
+    std::fprintf(stderr, "frames_sent      %lld\n", sent);
+    std::fprintf(stderr, "wall_time_s      %.3f\n", wall_seconds);
+    std::fprintf(stderr, "frames_per_sec   %.0f\n", sent / wall_seconds);
+    if (!ok)
+        std::fprintf(stderr, "receiver closed the stream\n");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,95 @@
+// 共享内存遥测读取示例: 连接 TelemetryPublisher 创建的共享内存, 逐帧读取并统计丢帧
+#include "EICAS.h"
+#include "EICASBatch.h"
+#include "TelemetryShm.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+static void printUsage(const char *prog)
+{
+    std::printf("usage: %s [options]\n"
+                "  --name NAME        共享内存名称, 默认 engine_telemetry\n"
+                "  --seconds S        读取时长(秒), 默认 10\n"
+                "  --print-every N    每 N 帧打印一行, 0 表示不打印, 默认 200 (实时运行时约每秒一行)\n"
+                "  --latest           只读取最新一帧 (仪表盘用法), 不逐帧读取\n",
+                prog);
+}
+
+static void printFrame(const TelemetryFrame &f)
+{
+    std::printf("#%llu t=%.3f %-8s N1=%.1f N2=%.1f EGT1=%.1f EGT2=%.1f fuel=%.1f flow=%.2f alerts=0x%04x",
+                (unsigned long long)f.index, f.time, getEngineStateName(f.state), f.data.rpm_1, f.data.rpm_2,
+                f.data.egt1_temp, f.data.egt2_temp, f.data.fuel_c, f.data.fuel_v, f.alert_mask);
+    ErrorType alerts[ERROR_TYPE_COUNT];
+    int n = expandAlertMask(f.alert_mask, alerts);
+    for (int i = 0; i < n; i++)
+        std::printf(" [%s]", EICAS::getErrorMessage(alerts[i]));
+    std::printf("\n");
+}
+
+int main(int argc, char **argv)
+{
+    const char *name = "engine_telemetry";
+    double seconds = 10.0;
+    long long print_every = 200;
+    bool latest_only = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char *arg = argv[i];
+        bool has_value = (i + 1 < argc);
+        if (std::strcmp(arg, "--name") == 0 && has_value)
+            name = argv[++i];
+        else if (std::strcmp(arg, "--seconds") == 0 && has_value)
+            seconds = std::atof(argv[++i]);
+        else if (std::strcmp(arg, "--print-every") == 0 && has_value)
+            print_every = std::atoll(argv[++i]);
+        else if (std::strcmp(arg, "--latest") == 0)
+            latest_only = true;
+        else
+        {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    TelemetryReader reader;
+    if (!reader.open(name))
+    {
+        std::fprintf(stderr, "cannot open shared memory %s (is the publisher running?)\n", name);
+        return 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    auto deadline = start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                std::chrono::duration<double>(seconds));
+
+    TelemetryFrame frame;
+    long long frames = 0;
+    while (std::chrono::steady_clock::now() < deadline)
+    {
+        bool got = latest_only ? reader.readLatest(frame) : reader.readNext(frame);
+        if (!got)
+        {
+            // 没有新帧时短暂休眠, 读端不占满 CPU
+            std::this_thread::sleep_for(std::chrono::milliseconds(latest_only ? 100 : 1));
+            continue;
+        }
+        frames++;
+        if (latest_only || (print_every > 0 && frames % print_every == 0))
+            printFrame(frame);
+        if (latest_only)
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::printf("frames_read      %lld\n", frames);
+    std::printf("frames_missed    %llu\n", (unsigned long long)reader.getMissed());
+    std::printf("seqlock_retries  %llu\n", (unsigned long long)reader.getRetries());
+    std::printf("published_total  %llu\n", (unsigned long long)reader.getPublished());
+    std::printf("read_rate_hz     %.1f\n", frames / (elapsed > 0.0 ? elapsed : 1e-9));
+    return 0;
+}
@@ -0,0 +1,127 @@
+// 网络遥测接收示例: 接收 TelemetrySender 发出的数据报, 打印样本并统计丢包和乱序
+#include "EICAS.h"
+#include "EICASBatch.h"
+#include "TelemetryStream.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+static void printUsage(const char *prog)
+{
+    std::printf("usage: %s [options]\n"
+                "  --udp PORT         在 UDP 端口 PORT 上接收, 默认 47017\n"
+                "  --unix PATH        在 Unix 数据报套接字 PATH 上接收\n"
+                "  --seconds S        接收时长(秒), 默认 10\n"
+                "  --idle S           连续 S 秒没有数据时提前结束, 0 表示不提前结束, 默认 0\n"
+                "  --print-every N    每 N 个样本打印一行, 0 表示不打印, 默认 200\n",
+                prog);
+}
+
+static void printSample(uint64_t index, const TelemetryWireSample &s)
+{
+    EngineSnapshot data = {};
+    wireSampleToSnapshot(s, data);
+    std::printf("#%llu t=%.3f %-8s N1=%.1f N2=%.1f EGT1=%.1f EGT2=%.1f fuel=%.1f flow=%.2f alerts=0x%04x",
+                (unsigned long long)index, s.time, getEngineStateName((EngineState)s.state), data.rpm_1, data.rpm_2,
+                data.egt1_temp, data.egt2_temp, data.fuel_c, data.fuel_v, s.alert_mask);
+    ErrorType alerts[ERROR_TYPE_COUNT];
+    int n = expandAlertMask(s.alert_mask, alerts);
+    for (int i = 0; i < n; i++)
+        std::printf(" [%s]", EICAS::getErrorMessage(alerts[i]));
+    std::printf("\n");
+}
+
+int main(int argc, char **argv)
+{
+    int udp_port = 47017;
+    const char *unix_path = nullptr;
+    double seconds = 10.0;
+    double idle_seconds = 0.0;
+    long long print_every = 200;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char *arg = argv[i];
+        bool has_value = (i + 1 < argc);
+        if (std::strcmp(arg, "--udp") == 0 && has_value)
+            udp_port = std::atoi(argv[++i]);
+        else if (std::strcmp(arg, "--unix") == 0 && has_value)
+            unix_path = argv[++i];
+        else if (std::strcmp(arg, "--seconds") == 0 && has_value)
+            seconds = std::atof(argv[++i]);
+        else if (std::strcmp(arg, "--idle") == 0 && has_value)
+            idle_seconds = std::atof(argv[++i]);
+        else if (std::strcmp(arg, "--print-every") == 0 && has_value)
+            print_every = std::atoll(argv[++i]);
+        else
+        {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    TelemetryReceiver receiver;
+    bool ok = unix_path ? receiver.bindUnix(unix_path) : receiver.bindUdp((uint16_t)udp_port);
+    if (!ok)
+    {
+        if (unix_path)
+            std::fprintf(stderr, "cannot bind unix socket %s\n", unix_path);
+        else
+            std::fprintf(stderr, "cannot bind udp port %d\n", udp_port);
+        return 1;
+    }
+
+    typedef std::chrono::steady_clock Clock;
+    Clock::time_point start = Clock::now();
+    Clock::time_point last_data = start;
+    Clock::time_point first_data = start;
+    bool got_data = false;
+
+    while (true)
+    {
+        Clock::time_point now = Clock::now();
+        if (std::chrono::duration<double>(now - start).count() >= seconds)
+            break;
+        if (idle_seconds > 0.0 && got_data && std::chrono::duration<double>(now - last_data).count() >= idle_seconds)
+            break;
+
+        const TelemetryPacketHeader *header = nullptr;
+        const TelemetryWireSample *samples = nullptr;
+        int n = receiver.receive(header, samples, 100);
+        if (n < 0)
+        {
+            std::fprintf(stderr, "receive failed\n");
+            return 1;
+        }
+        if (n == 0)
+            continue;
+
+        last_data = Clock::now();
+        if (!got_data)
+            first_data = last_data;
+        got_data = true;
+
+        if (print_every > 0)
+        {
+            for (int i = 0; i < n; i++)
+            {
+                uint64_t index = header->first_step + i;
+                if ((index + 1) % (uint64_t)print_every == 0)
+                    printSample(index, samples[i]);
+            }
+        }
+    }
+
+    TelemetryReceiveStats stats = receiver.getStats();
+    double active = got_data ? std::chrono::duration<double>(last_data - first_data).count() : 0.0;
+    std::printf("packets          %llu\n", (unsigned long long)stats.packets);
+    std::printf("samples          %llu\n", (unsigned long long)stats.samples);
+    std::printf("lost_packets     %llu\n", (unsigned long long)stats.lost_packets);
+    std::printf("lost_samples     %llu\n", (unsigned long long)stats.lost_samples);
+    std::printf("reordered        %llu\n", (unsigned long long)stats.reordered);
+    std::printf("invalid          %llu\n", (unsigned long long)stats.invalid);
+    std::printf("samples_per_pkt  %.1f\n", stats.packets ? (double)stats.samples / stats.packets : 0.0);
+    std::printf("sample_rate_hz   %.1f\n", active > 0.0 ? stats.samples / active : 0.0);
+    return 0;
+}
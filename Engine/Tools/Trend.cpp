@@ -0,0 +1,209 @@
+// 长日志的趋势图数据: 从 TrendPyramid 取出任意时间窗内不超过指定点数的最小值 / 最大值 / 均值,
+// 时间窗比金字塔最细一层还细时改用 LogIndex 读取原始数据再分桶
+#include "LogIndex.h"
+#include "LogScan.h"
+#include "TrendPyramid.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+static void printUsage(const char *prog)
+{
+    std::printf("usage: %s <log | log.trend> [options]\n"
+                "  --build            先由日志 (重新) 生成趋势金字塔 (文件名 + .trend), 用于已有日志\n"
+                "  --from T           时间窗起点, 秒数或 3h12m5s 形式, 默认日志开头\n"
+                "  --to T             时间窗终点, 默认日志结尾\n"
+                "  --points N         最多输出的点数, 默认 2000\n"
+                "  --out FILE         每点的时间范围、样本数和各通道最小值 / 最大值 / 均值写成 CSV\n"
+                "  日志可以是 CSV、二进制或列式格式; 细时间窗读取原始数据需要 engine_logquery 的索引\n",
+                prog);
+}
+
+// 秒数, 或由 h / m / s 单位组成的时长 (如 3h12m, 1h30s)
+static bool parseTime(const char *text, double &seconds)
+{
+    seconds = 0.0;
+    const char *p = text;
+    while (*p)
+    {
+        char *end;
+        double v = std::strtod(p, &end);
+        if (end == p)
+            return false;
+        double unit = 1.0;
+        if (*end == 'h')
+            unit = 3600.0;
+        else if (*end == 'm')
+            unit = 60.0;
+        if (*end == 'h' || *end == 'm' || *end == 's')
+            end++;
+        else if (*end != '\0')
+            return false;
+        seconds += v * unit;
+        p = end;
+    }
+    return p != text;
+}
+
+static double elapsedMs(std::chrono::steady_clock::time_point since)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - since).count();
+}
+
+static bool writePoints(const char *path, const std::vector<TrendBucket> &points)
+{
+    std::FILE *f = std::fopen(path, "w");
+    if (!f)
+        return false;
+    std::fprintf(f, "Time_Start,Time_End,Samples");
+    for (int c = 0; c < COLUMN_LOG_CHANNELS; c++)
+        std::fprintf(f, ",%s_min,%s_max,%s_mean", logChannelName(c), logChannelName(c), logChannelName(c));
+    std::fprintf(f, "\n");
+    for (const TrendBucket &b : points)
+    {
+        std::fprintf(f, "%.3f,%.3f,%u", b.first_time, b.last_time, b.count);
+        for (int c = 0; c < COLUMN_LOG_CHANNELS; c++)
+            std::fprintf(f, ",%.3f,%.3f,%.3f", b.min[c], b.max[c], b.sum[c] / b.count);
+        std::fprintf(f, "\n");
+    }
+    bool ok = std::ferror(f) == 0;
+    return std::fclose(f) == 0 && ok;
+}
+
+int main(int argc, char **argv)
+{
+    std::string log_path;
+    bool build = false;
+    double from = 0.0;
+    double to = 0.0;
+    bool has_from = false;
+    bool has_to = false;
+    size_t max_points = 2000;
+    const char *out_path = nullptr;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char *arg = argv[i];
+        bool has_value = (i + 1 < argc);
+        if (std::strcmp(arg, "--build") == 0)
+            build = true;
+        else if ((std::strcmp(arg, "--from") == 0 || std::strcmp(arg, "--to") == 0) && has_value)
+        {
+            bool is_from = (arg[2] == 'f');
+            if (!parseTime(argv[++i], is_from ? from : to))
+            {
+                std::fprintf(stderr, "bad time: %s\n", argv[i]);
+                return 1;
+            }
+            has_from = has_from || is_from;
+            has_to = has_to || !is_from;
+        }
+        else if (std::strcmp(arg, "--points") == 0 && has_value)
+            max_points = (size_t)std::atoll(argv[++i]);
+        else if (std::strcmp(arg, "--out") == 0 && has_value)
+            out_path = argv[++i];
+        else if (arg[0] != '-' && log_path.empty())
+            log_path = arg;
+        else
+        {
+            printUsage(argv[0]);
+            return (std::strcmp(arg, "--help") == 0) ? 0 : 1;
+        }
+    }
+    if (log_path.empty())
+    {
+        printUsage(argv[0]);
+        return 1;
+    }
+    if (max_points == 0)
+        max_points = 1;
+
+    // 也接受直接给出 .trend 文件
+    const std::string suffix = trendPyramidPath("");
+    if (log_path.size() > suffix.size() && log_path.compare(log_path.size() - suffix.size(), suffix.size(), suffix) == 0)
+        log_path.resize(log_path.size() - suffix.size());
+
+    std::string error;
+    TrendPyramid pyramid;
+    if (build)
+    {
+        auto start = std::chrono::steady_clock::now();
+        if (!TrendPyramid::build(log_path, pyramid, error))
+        {
+            std::fprintf(stderr, "%s\n", error.c_str());
+            return 1;
+        }
+        if (!pyramid.save(trendPyramidPath(log_path)))
+        {
+            std::fprintf(stderr, "cannot write %s\n", trendPyramidPath(log_path).c_str());
+            return 1;
+        }
+        std::printf("%s: trend built in %.1f ms\n", log_path.c_str(), elapsedMs(start));
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    if (!pyramid.load(trendPyramidPath(log_path), error))
+    {
+        std::fprintf(stderr, "%s (use --build)\n", error.c_str());
+        return 1;
+    }
+    std::printf("%s: %llu samples, %d levels (%u - %llu samples per point), loaded in %.3f ms\n",
+                log_path.c_str(), (unsigned long long)pyramid.getSampleCount(), pyramid.getLevelCount(),
+                1u << pyramid.getBaseShift(),
+                (unsigned long long)1 << (pyramid.getBaseShift() + pyramid.getLevelCount() - 1), elapsedMs(start));
+
+    if (!has_from)
+        from = -1e300;
+    if (!has_to || to < from)
+        to = 1e300;
+
+    start = std::chrono::steady_clock::now();
+    std::vector<TrendBucket> points;
+    int level = pyramid.render(from, to, max_points, points);
+    bool raw = false;
+    // 最细一层连一半点数都用不满时, 由索引读取原始数据, 按点数重新分桶
+    if (level == 0 && points.size() * 2 <= max_points)
+    {
+        LogIndex index;
+        ColumnChunk window;
+        window.rows = 0;
+        if (index.open(log_path, error) && index.readWindow(from, to, window))
+        {
+            TrendPyramid::decimate(window, max_points, points);
+            raw = true;
+        }
+    }
+    double render_ms = elapsedMs(start);
+
+    if (raw)
+        std::printf("  raw rows via index: %zu points, %.3f ms\n", points.size(), render_ms);
+    else if (level >= 0)
+        std::printf("  level %d (%llu samples per point): %zu points, %.3f ms\n", level,
+                    (unsigned long long)1 << (pyramid.getBaseShift() + level), points.size(), render_ms);
+    if (points.empty())
+    {
+        std::printf("  no samples in window\n");
+        return 0;
+    }
+
+    // 整个时间窗的合计, 极值与原始数据一致
+    TrendBucket total;
+    total.count = 0;
+    for (const TrendBucket &b : points)
+        TrendPyramid::mergeBucket(total, b);
+    std::printf("  window %.3f - %.3f s, %u samples\n", total.first_time, total.last_time, total.count);
+    std::printf("  %-10s %12s %12s %12s\n", "channel", "min", "max", "mean");
+    for (int c = 0; c < COLUMN_LOG_CHANNELS; c++)
+        std::printf("  %-10s %12.3f %12.3f %12.3f\n", logChannelName(c), total.min[c], total.max[c],
+                    total.sum[c] / total.count);
+
+    if (out_path && !writePoints(out_path, points))
+    {
+        std::fprintf(stderr, "cannot write %s\n", out_path);
+        return 1;
+    }
+    return 0;
+}
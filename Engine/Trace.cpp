@@ -0,0 +1,175 @@
+#include "Trace.h"
+
+#ifdef ENGINE_ENABLE_TRACING
+
+#include <atomic>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// 单个线程的环形事件缓冲区, 只由所属线程写入
+struct ThreadBuffer
+{
+    std::vector<TraceEvent> events;
+    std::atomic<uint64_t> written;
+    int tid;
+    const char *thread_name;
+};
+
+struct TraceRegistry
+{
+    std::mutex lock;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    size_t capacity = 1 << 18;
+    std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+};
+
+static TraceRegistry &registry()
+{
+    static TraceRegistry r;
+    return r;
+}
+
+// 线程第一次写事件时分配缓冲区并登记; 登记表持有所有权, 线程退出后数据仍可导出
+static ThreadBuffer &threadBuffer()
+{
+    thread_local ThreadBuffer *buffer = nullptr;
+    if (!buffer)
+    {
+        TraceRegistry &r = registry();
+        std::lock_guard<std::mutex> guard(r.lock);
+        std::shared_ptr<ThreadBuffer> b(new ThreadBuffer);
+        b->events.resize(r.capacity);
+        b->written = 0;
+        b->tid = (int)r.buffers.size() + 1;
+        b->thread_name = nullptr;
+        r.buffers.push_back(b);
+        buffer = b.get();
+    }
+    return *buffer;
+}
+
+static void push(const TraceEvent &e)
+{
+    ThreadBuffer &b = threadBuffer();
+    uint64_t n = b.written.load(std::memory_order_relaxed);
+    b.events[n % b.events.size()] = e;
+    b.written.store(n + 1, std::memory_order_release);
+}
+
+static void writeJsonString(std::FILE *f, const char *s)
+{
+    std::fputc('"', f);
+    for (; *s; s++)
+    {
+        char c = *s;
+        if (c == '"' || c == '\\')
+        {
+            std::fputc('\\', f);
+            std::fputc(c, f);
+        }
+        else if ((unsigned char)c < 0x20)
+            std::fprintf(f, "\\u%04x", c);
+        else
+            std::fputc(c, f);
+    }
+    std::fputc('"', f);
+}
+
+void Trace::setCapacity(size_t events_per_thread)
+{
+    TraceRegistry &r = registry();
+    std::lock_guard<std::mutex> guard(r.lock);
+    r.capacity = events_per_thread ? events_per_thread : 1;
+}
+
+void Trace::setThreadName(const char *name)
+{
+    threadBuffer().thread_name = name;
+}
+
+uint64_t Trace::now()
+{
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() -
+                                                                          registry().epoch)
+        .count();
+}
+
+void Trace::complete(const char *category, const char *name, uint64_t start_ns, uint64_t end_ns)
+{
+    TraceEvent e;
+    e.category = category;
+    e.name = name;
+    e.detail = nullptr;
+    e.start_ns = start_ns;
+    e.duration_ns = end_ns - start_ns;
+    e.phase = 'X';
+    push(e);
+}
+
+void Trace::instant(const char *category, const char *name, const char *detail)
+{
+    TraceEvent e;
+    e.category = category;
+    e.name = name;
+    e.detail = detail;
+    e.start_ns = now();
+    e.duration_ns = 0;
+    e.phase = 'i';
+    push(e);
+}
+
+bool Trace::exportJson(const std::string &path)
+{
+    std::FILE *f = std::fopen(path.c_str(), "w");
+    if (!f)
+        return false;
+
+    TraceRegistry &r = registry();
+    std::lock_guard<std::mutex> guard(r.lock);
+
+    std::fprintf(f, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+    bool first = true;
+    for (const auto &b : r.buffers)
+    {
+        if (b->thread_name)
+        {
+            std::fprintf(f, "%s{\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"name\":\"thread_name\",\"args\":{\"name\":",
+                         first ? "" : ",\n", b->tid);
+            writeJsonString(f, b->thread_name);
+            std::fprintf(f, "}}");
+            first = false;
+        }
+
+        // 环形缓冲区写满后只保留最近的事件
+        uint64_t written = b->written.load(std::memory_order_acquire);
+        uint64_t cap = b->events.size();
+        uint64_t begin = (written > cap) ? written - cap : 0;
+        for (uint64_t i = begin; i < written; i++)
+        {
+            const TraceEvent &e = b->events[i % cap];
+            std::fprintf(f, "%s{\"ph\":\"%c\",\"pid\":1,\"tid\":%d,\"cat\":", first ? "" : ",\n", e.phase, b->tid);
+            writeJsonString(f, e.category);
+            std::fprintf(f, ",\"name\":");
+            writeJsonString(f, e.name);
+            std::fprintf(f, ",\"ts\":%.3f", e.start_ns / 1000.0);
+            if (e.phase == 'X')
+                std::fprintf(f, ",\"dur\":%.3f", e.duration_ns / 1000.0);
+            else
+                std::fprintf(f, ",\"s\":\"t\"");
+            if (e.detail)
+            {
+                std::fprintf(f, ",\"args\":{\"detail\":");
+                writeJsonString(f, e.detail);
+                std::fprintf(f, "}");
+            }
+            std::fprintf(f, "}");
+            first = false;
+        }
+    }
+    std::fprintf(f, "\n]}\n");
+    return std::fclose(f) == 0;
+}
+
+#endif
@@ -0,0 +1,76 @@
+#pragma once
+// 时间线追踪: 作用域区间与瞬时事件写入各线程自己的缓冲区, 导出为 Chrome trace JSON (可用 Perfetto 打开)
+// 只有定义了 ENGINE_ENABLE_TRACING 才会编译进来, 否则下面的宏全部展开为空
+//
+//   TRACE_THREAD_NAME("sim");
+//   TRACE_SCOPE("sim", "cycle");
+//   TRACE_INSTANT("eicas", "alert_raised", EICAS::getErrorMessage(err));
+//
+// 名称、类别和附加文本必须是静态存储期的字符串 (字符串字面量或 getErrorMessage 的返回值)
+
+#ifdef ENGINE_ENABLE_TRACING
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+struct TraceEvent
+{
+    const char *category;
+    const char *name;
+    const char *detail; // 瞬时事件的附加文本, 可为空
+    uint64_t start_ns;  // 相对追踪起点
+    uint64_t duration_ns;
+    char phase;         // 'X' 区间, 'i' 瞬时
+};
+
+class Trace
+{
+public:
+    // 每个线程缓冲区保留最近的 events_per_thread 个事件
+    static void setCapacity(size_t events_per_thread);
+
+    static void setThreadName(const char *name);
+
+    static uint64_t now();
+    static void complete(const char *category, const char *name, uint64_t start_ns, uint64_t end_ns);
+    static void instant(const char *category, const char *name, const char *detail);
+
+    // 在各线程停止写入后调用
+    static bool exportJson(const std::string &path);
+};
+
+class TraceScope
+{
+public:
+    TraceScope(const char *category, const char *name) : category(category), name(name), start(Trace::now())
+    {
+    }
+    ~TraceScope()
+    {
+        Trace::complete(category, name, start, Trace::now());
+    }
+
+    TraceScope(const TraceScope &) = delete;
+    TraceScope &operator=(const TraceScope &) = delete;
+
+private:
+    const char *category;
+    const char *name;
+    uint64_t start;
+};
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+#define TRACE_SCOPE(category, name) TraceScope TRACE_CONCAT(trace_scope_, __LINE__)(category, name)
+#define TRACE_INSTANT(category, name, detail) Trace::instant(category, name, detail)
+#define TRACE_THREAD_NAME(name) Trace::setThreadName(name)
+
+#else
+
+#define TRACE_SCOPE(category, name) ((void)0)
+#define TRACE_INSTANT(category, name, detail) ((void)0)
+#define TRACE_THREAD_NAME(name) ((void)0)
+
+#endif
@@ -0,0 +1,284 @@
+#include "TrendPyramid.h"
+#include "LogReplay.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+std::string trendPyramidPath(const std::string &log_path)
+{
+    return log_path + ".trend";
+}
+
+TrendPyramid::TrendPyramid(uint32_t base_shift) : base_shift(base_shift)
+{
+    clear();
+}
+
+void TrendPyramid::clear()
+{
+    sample_count = 0;
+    levels.assign(1, std::vector<TrendBucket>());
+    TrendBucket empty;
+    std::memset(&empty, 0, sizeof(empty));
+    pending.assign(1, empty);
+}
+
+void TrendPyramid::startBucket(TrendBucket &bucket, double time, const double *values)
+{
+    bucket.first_time = time;
+    bucket.last_time = time;
+    bucket.count = 1;
+    bucket.reserved = 0;
+    for (int c = 0; c < COLUMN_LOG_CHANNELS; c++)
+    {
+        bucket.min[c] = values[c];
+        bucket.max[c] = values[c];
+        bucket.sum[c] = values[c];
+    }
+}
+
+void TrendPyramid::mergeBucket(TrendBucket &into, const TrendBucket &from)
+{
+    if (from.count == 0)
+        return;
+    if (into.count == 0)
+    {
+        into = from;
+        return;
+    }
+    into.first_time = std::min(into.first_time, from.first_time);
+    into.last_time = std::max(into.last_time, from.last_time);
+    into.count += from.count;
+    for (int c = 0; c < COLUMN_LOG_CHANNELS; c++)
+    {
+        into.min[c] = std::min(into.min[c], from.min[c]);
+        into.max[c] = std::max(into.max[c], from.max[c]);
+        into.sum[c] += from.sum[c];
+    }
+}
+
+void TrendPyramid::append(double time, const double *values)
+{
+    sample_count++;
+    TrendBucket &bucket = pending[0];
+    if (bucket.count == 0)
+        startBucket(bucket, time, values);
+    else
+    {
+        bucket.last_time = time;
+        bucket.count++;
+        for (int c = 0; c < COLUMN_LOG_CHANNELS; c++)
+        {
+            double v = values[c];
+            bucket.min[c] = v < bucket.min[c] ? v : bucket.min[c];
+            bucket.max[c] = v > bucket.max[c] ? v : bucket.max[c];
+            bucket.sum[c] += v;
+        }
+    }
+    if (bucket.count == (1u << base_shift))
+        completeBucket(0);
+}
+
+void TrendPyramid::append(double time, const EngineSnapshot &data)
+{
+    // CSV 列顺序: 燃油流量在燃油余量之前
+    const double values[COLUMN_LOG_CHANNELS] = {data.rpm_1,     data.rpm_2,  data.egt1_temp,
+                                                data.egt2_temp, data.fuel_v, data.fuel_c};
+    append(time, values);
+}
+
+// 第 level 层的桶已满: 存入该层, 并累积到上一层的桶中 (两个合成一个)
+void TrendPyramid::completeBucket(int level)
+{
+    while (true)
+    {
+        if (level + 1 == (int)pending.size())
+        {
+            pending.emplace_back();
+            levels.emplace_back();
+            std::memset(&pending.back(), 0, sizeof(TrendBucket));
+        }
+        levels[level].push_back(pending[level]);
+        mergeBucket(pending[level + 1], pending[level]);
+        std::memset(&pending[level], 0, sizeof(TrendBucket));
+
+        level++;
+        if (pending[level].count != (1u << (base_shift + level)))
+            break;
+    }
+}
+
+uint64_t TrendPyramid::getSampleCount() const
+{
+    return sample_count;
+}
+
+uint32_t TrendPyramid::getBaseShift() const
+{
+    return base_shift;
+}
+
+int TrendPyramid::getLevelCount() const
+{
+    return (int)levels.size();
+}
+
+const std::vector<TrendBucket> &TrendPyramid::getLevel(int level) const
+{
+    return levels[level];
+}
+
+bool TrendPyramid::tailBucket(int level, TrendBucket &out) const
+{
+    out.count = 0;
+    for (int l = 0; l <= level; l++)
+        mergeBucket(out, pending[l]);
+    return out.count > 0;
+}
+
+int TrendPyramid::render(double t0, double t1, size_t max_points, std::vector<TrendBucket> &out) const
+{
+    out.clear();
+    if (sample_count == 0)
+        return -1;
+    if (max_points == 0)
+        max_points = 1;
+
+    // 最高一层只有未填满的桶, 一定满足点数限制
+    for (int level = 0; level < (int)levels.size(); level++)
+    {
+        const std::vector<TrendBucket> &buckets = levels[level];
+        auto first = std::partition_point(buckets.begin(), buckets.end(),
+                                          [t0](const TrendBucket &b) { return b.last_time < t0; });
+        auto last = std::partition_point(first, buckets.end(),
+                                         [t1](const TrendBucket &b) { return b.first_time <= t1; });
+        TrendBucket tail;
+        bool has_tail = tailBucket(level, tail) && tail.first_time <= t1 && tail.last_time >= t0;
+        size_t count = (size_t)(last - first) + (has_tail ? 1 : 0);
+        if (count > max_points && level + 1 < (int)levels.size())
+            continue;
+
+        out.assign(first, last);
+        if (has_tail)
+            out.push_back(tail);
+        return level;
+    }
+    return -1;
+}
+
+bool TrendPyramid::save(const std::string &path) const
+{
+    TrendPyramidHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, TREND_PYRAMID_MAGIC, sizeof(header.magic));
+    header.version = TREND_PYRAMID_VERSION;
+    header.base_shift = base_shift;
+    header.level_count = (uint32_t)levels.size();
+    header.sample_count = sample_count;
+
+    std::FILE *f = std::fopen(path.c_str(), "wb");
+    if (!f)
+        return false;
+    std::fwrite(&header, sizeof(header), 1, f);
+    for (size_t l = 0; l < levels.size(); l++)
+    {
+        uint64_t count = levels[l].size();
+        std::fwrite(&count, sizeof(count), 1, f);
+        std::fwrite(&pending[l], sizeof(TrendBucket), 1, f);
+        if (count > 0)
+            std::fwrite(levels[l].data(), sizeof(TrendBucket), levels[l].size(), f);
+    }
+    bool ok = std::ferror(f) == 0;
+    return std::fclose(f) == 0 && ok;
+}
+
+bool TrendPyramid::load(const std::string &path, std::string &error)
+{
+    std::FILE *f = std::fopen(path.c_str(), "rb");
+    if (!f)
+    {
+        error = "cannot open " + path;
+        return false;
+    }
+    TrendPyramidHeader header;
+    bool ok = std::fread(&header, sizeof(header), 1, f) == 1;
+    if (!ok || std::memcmp(header.magic, TREND_PYRAMID_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != TREND_PYRAMID_VERSION || header.base_shift > 24 || header.level_count == 0 ||
+        header.level_count > 64)
+    {
+        std::fclose(f);
+        error = path + ": not a trend pyramid";
+        return false;
+    }
+
+    base_shift = header.base_shift;
+    sample_count = header.sample_count;
+    levels.assign(header.level_count, std::vector<TrendBucket>());
+    pending.resize(header.level_count);
+    for (uint32_t l = 0; l < header.level_count && ok; l++)
+    {
+        uint64_t count;
+        ok = std::fread(&count, sizeof(count), 1, f) == 1 && std::fread(&pending[l], sizeof(TrendBucket), 1, f) == 1;
+        // 第 l 层的桶数不会超过样本数 / 2^(base_shift + l)
+        uint32_t shift = base_shift + l;
+        if (!ok || count > (shift < 64 ? sample_count >> shift : 0))
+        {
+            ok = false;
+            break;
+        }
+        levels[l].resize((size_t)count);
+        if (count > 0)
+            ok = std::fread(levels[l].data(), sizeof(TrendBucket), levels[l].size(), f) == levels[l].size();
+    }
+    std::fclose(f);
+    if (!ok)
+    {
+        clear();
+        error = path + ": truncated";
+        return false;
+    }
+    return true;
+}
+
+bool TrendPyramid::build(const std::string &log_path, TrendPyramid &pyramid, std::string &error)
+{
+    LogReplayReader reader;
+    if (!reader.open(log_path))
+    {
+        error = "cannot open " + log_path;
+        return false;
+    }
+    pyramid.clear();
+    ReplayFrame frame;
+    while (reader.next(frame))
+        pyramid.append(frame.time, frame.data);
+    return true;
+}
+
+void TrendPyramid::decimate(const ColumnChunk &rows, size_t max_points, std::vector<TrendBucket> &out)
+{
+    out.clear();
+    if (rows.rows == 0)
+        return;
+    if (max_points == 0)
+        max_points = 1;
+    size_t per_bucket = (rows.rows + max_points - 1) / max_points;
+    out.reserve((rows.rows + per_bucket - 1) / per_bucket);
+
+    double values[COLUMN_LOG_CHANNELS];
+    for (size_t begin = 0; begin < rows.rows; begin += per_bucket)
+    {
+        size_t end = std::min(begin + per_bucket, (size_t)rows.rows);
+        TrendBucket bucket;
+        bucket.count = 0;
+        for (size_t i = begin; i < end; i++)
+        {
+            for (int c = 0; c < COLUMN_LOG_CHANNELS; c++)
+                values[c] = rows.values[c][i];
+            TrendBucket one;
+            startBucket(one, rows.time[i], values);
+            mergeBucket(bucket, one);
+        }
+        out.push_back(bucket);
+    }
+}
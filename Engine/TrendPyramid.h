@@ -0,0 +1,87 @@
+#pragma once
+#include "ColumnLogger.h"
+#include "DataStructrue.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// 趋势图用的多分辨率金字塔: 第 k 层每桶汇总 2^(base_shift + k) 个样本的各通道最小值、最大值与总和,
+// 逐样本增量更新; 任意时间窗都能从某一层取出不超过指定点数的桶, 每桶保留极值, 峰值不会被平均掉
+// 通道顺序与 CSV 列一致: N1, N2, EGT1, EGT2, 燃油流量, 燃油余量 (传感器失效的标志值照常计入)
+// 文件格式 (日志路径 + ".trend"): 32 字节文件头, 之后每层依次为桶数 (8 字节)、未填满的末尾桶、已完成的桶
+
+const char TREND_PYRAMID_MAGIC[8] = {'E', 'N', 'G', 'T', 'R', 'N', 'D', '1'};
+const uint32_t TREND_PYRAMID_VERSION = 1;
+
+struct TrendBucket
+{
+    double first_time;
+    double last_time;
+    uint32_t count; // 样本数
+    uint32_t reserved;
+    double min[COLUMN_LOG_CHANNELS];
+    double max[COLUMN_LOG_CHANNELS];
+    double sum[COLUMN_LOG_CHANNELS];
+};
+
+struct TrendPyramidHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t base_shift;
+    uint32_t level_count;
+    uint32_t reserved;
+    uint64_t sample_count;
+};
+
+static_assert(sizeof(TrendBucket) == 168, "TrendBucket must be 168 bytes");
+static_assert(sizeof(TrendPyramidHeader) == 32, "TrendPyramidHeader must be 32 bytes");
+
+std::string trendPyramidPath(const std::string &log_path);
+
+class TrendPyramid
+{
+public:
+    // 最细一层每桶 2^base_shift 个样本 (默认 64 个, 即 0.32 秒仿真时间); 更细的缩放直接读日志 (LogIndex)
+    explicit TrendPyramid(uint32_t base_shift = 6);
+
+    void clear();
+
+    // values 为 6 个通道的值
+    void append(double time, const double *values);
+    void append(double time, const EngineSnapshot &data);
+
+    uint64_t getSampleCount() const;
+    uint32_t getBaseShift() const;
+    int getLevelCount() const;
+
+    // 第 level 层已填满的桶
+    const std::vector<TrendBucket> &getLevel(int level) const;
+
+    // 从能使 [t0, t1] 内的桶数不超过 max_points 的最细一层取桶 (含尚未填满的末尾桶), 返回所用层号;
+    // 还没有样本时返回 -1
+    int render(double t0, double t1, size_t max_points, std::vector<TrendBucket> &out) const;
+
+    bool save(const std::string &path) const;
+    bool load(const std::string &path, std::string &error);
+
+    // 事后由日志 (CSV / 二进制 / 列式) 生成
+    static bool build(const std::string &log_path, TrendPyramid &pyramid, std::string &error);
+
+    // 把一段原始数据按时间顺序均分成不超过 max_points 个桶, 用于比最细一层更细的缩放
+    static void decimate(const ColumnChunk &rows, size_t max_points, std::vector<TrendBucket> &out);
+
+    // 单个样本构成的桶, 以及两个桶的合并
+    static void startBucket(TrendBucket &bucket, double time, const double *values);
+    static void mergeBucket(TrendBucket &into, const TrendBucket &from);
+
+private:
+    // 第 level 层与其下各层未填满的桶合并而成的末尾桶
+    bool tailBucket(int level, TrendBucket &out) const;
+    void completeBucket(int level);
+
+    uint32_t base_shift;
+    uint64_t sample_count;
+    std::vector<std::vector<TrendBucket>> levels;
+    std::vector<TrendBucket> pending; // 每层正在累积的桶, count 为 0 表示为空
+};
@@ -0,0 +1,56 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+// 单写者单读者的无锁三缓冲: 写端总有一块空闲缓冲可写, 读端总能立即取到最新发布的完整数据,
+// 双方都不会阻塞; 读端来不及读取的旧数据直接被覆盖
+template <typename T> class TripleBuffer
+{
+public:
+    TripleBuffer() : write_index(0), read_index(1)
+    {
+        middle.store(2, std::memory_order_relaxed);
+    }
+
+    // 写端: 取得当前可写的缓冲, 写完后调用 publish
+    T &writeBuffer()
+    {
+        return slots[write_index].value;
+    }
+
+    // 写端: 把写好的缓冲与中间缓冲交换, 并标记为新数据
+    void publish()
+    {
+        write_index = middle.exchange(write_index | FRESH, std::memory_order_acq_rel) & INDEX_MASK;
+    }
+
+    // 读端: 有新发布的数据时换到读端, 返回是否取到了新数据
+    bool update()
+    {
+        if (!(middle.load(std::memory_order_relaxed) & FRESH))
+            return false;
+        read_index = middle.exchange(read_index, std::memory_order_acq_rel) & INDEX_MASK;
+        return true;
+    }
+
+    // 读端: 最近一次 update 取到的数据
+    const T &readBuffer() const
+    {
+        return slots[read_index].value;
+    }
+
+private:
+    static const uint8_t INDEX_MASK = 3;
+    static const uint8_t FRESH = 4;
+
+    // 每块缓冲独占缓存行, 避免读写两端伪共享
+    struct alignas(64) Slot
+    {
+        T value;
+    };
+
+    Slot slots[3];
+    uint8_t write_index; // 只由写端访问
+    uint8_t read_index;  // 只由读端访问
+    alignas(64) std::atomic<uint8_t> middle;
+};
@@ -1,6 +1,8 @@
 #include "UI.h"
+#include "EICAS.h"
 #include <cmath>
 #include <cstdio>
+#include <cstring>
 
 #define COLOR_BG RGB(30, 30, 35)
 #define COLOR_GAUGE_FACE RGB(60, 60, 65)
@@ -54,47 +56,15 @@ COLORREF getAlertColor(ErrorType error)
 
 std::wstring UI::getErrorString(ErrorType error)
 {
-    switch (error)
-    {
-    case ErrorType::SENSOR_N_ONE:
-        return _T("ADVISORY: N1 SENSOR FAULT");
-    case ErrorType::SENSOR_N_TWO:
-        return _T("CAUTION: ENG N1 SENSOR FAIL");
-    case ErrorType::SENSOR_EGT_ONE:
-        return _T("ADVISORY: EGT SENSOR FAULT");
-    case ErrorType::SENSOR_EGT_TWO:
-        return _T("CAUTION: ENG EGT SENSOR FAIL");
-    case ErrorType::SENSOR_FUEL:
-        return _T("WARNING: FUEL SENSOR FAIL");
-    case ErrorType::SENSOR_ALL:
-        return _T("WARNING: DUAL ENG FAIL");
-
-    case ErrorType::LOW_FUEL:
-        return _T("CAUTION: LOW FUEL QTY");
-    case ErrorType::OVERSPEED_FUEL:
-        return _T("CAUTION: HIGH FUEL FLOW");
-
-    case ErrorType::OVERSPEED_N1_1:
-        return _T("CAUTION: N1 OVERSPEED");
-    case ErrorType::OVERSPEED_N1_2:
-        return _T("WARNING: ENG OVERSPEED");
-
-    case ErrorType::OVERHEAT_EGT_1:
-        return _T("CAUTION: EGT OVERHEAT");
-    case ErrorType::OVERHEAT_EGT_2:
-        return _T("WARNING: EGT CRITICAL");
-    case ErrorType::OVERHEAT_EGT_3:
-        return _T("CAUTION: EGT OVERHEAT");
-    case ErrorType::OVERHEAT_EGT_4:
-        return _T("WARNING: EGT CRITICAL");
-
-    default:
-        return _T("");
-    }
+    // 告警文本均为ASCII, 直接拓宽为宽字符
+    const char *msg = EICAS::getErrorMessage(error);
+    return std::wstring(msg, msg + strlen(msg));
 }
 
 UI::UI()
 {
+    rules = &EICASRuleProgram::builtin();
+
     int center_x = 512;
     int start_y = 540;
 
@@ -140,6 +110,11 @@ void UI::init()
     setbkmode(TRANSPARENT);
 }
 
+void UI::setRules(const EICASRuleProgram *value)
+{
+    rules = value ? value : &EICASRuleProgram::builtin();
+}
+
 void UI::drawGauge(int x, int y, int radius, double val, double min_val, double max_val, const std::wstring &label,
                    int status)
 {
@@ -150,7 +125,7 @@ void UI::drawGauge(int x, int y, int radius, double val, double min_val, double
         settextcolor(RGB(80, 80, 80));
         settextstyle(24, 0, _T("Consolas"));
         outtextxy(x - 20, y - 10, _T("---"));
-        settextstyle(18, 0, _T("΢ź"));
+        settextstyle(18, 0, _T("微软雅黑"));
         int w = textwidth(label.c_str());
         outtextxy(x - w / 2, y + 25, label.c_str());
         return;
@@ -199,7 +174,7 @@ void UI::drawGauge(int x, int y, int radius, double val, double min_val, double
     outtextxy(x - w / 2, y - 15, str);
 
     settextcolor(COLOR_NORMAL);
-    settextstyle(18, 0, _T("΢ź"));
+    settextstyle(18, 0, _T("微软雅黑"));
     w = textwidth(label.c_str());
     outtextxy(x - w / 2, y + 25, label.c_str());
 }
@@ -215,11 +190,11 @@ void UI::drawButton(RECT r, const std::wstring &text, COLORREF color, COLORREF h
     settextcolor(WHITE);
     if (r.bottom - r.top < 40)
     {
-        settextstyle(14, 0, _T("΢ź"));
+        settextstyle(14, 0, _T("微软雅黑"));
     }
     else
     {
-        settextstyle(20, 0, _T("΢ź"));
+        settextstyle(20, 0, _T("微软雅黑"));
     }
 
     int w = textwidth(text.c_str());
@@ -247,120 +222,63 @@ void UI::drawInfoBox(int x, int y, const std::wstring &label, double value, cons
     }
 }
 
-void UI::draw(double time, const EngineData &data, EngineState state, bool is_running_light_on, double n1, double n2,
-              const std::vector<ErrorType> &detected_errors)
+void UI::draw(double time, const EngineSnapshot &data, EngineState state, bool is_running_light_on, double n1, double n2,
+              const ErrorType *detected_errors, int detected_count)
 {
 
     setbkcolor(COLOR_BG);
     cleardevice();
 
     settextcolor(WHITE);
-    settextstyle(24, 0, _T("΢ź"));
+    settextstyle(24, 0, _T("微软雅黑"));
     outtextxy(20, 20, _T("EICAS Display System"));
     TCHAR time_buf[32];
     _stprintf_s(time_buf, _T("T+ %.1f s"), time);
     outtextxy(850, 20, time_buf);
 
-    int status_n1_l = 0;
-    if (!data.is_n_sensor_valid[0] && !data.is_n_sensor_valid[1])
-    {
-        status_n1_l = -1;
-    }
-    else
-    {
-        if (n1 > 120)
-            status_n1_l = 2;
-        else if (n1 > 105)
-            status_n1_l = 1;
-        else
-            status_n1_l = 0;
-    }
+    // 仪表颜色与 EICAS 告警使用同一份门限; 两个传感器均失效时显示无效
+    const double rpm_per_percent = rules->getLimits().rpm_reference / 100.0;
 
-    int status_n1_r = 0;
-    if (!data.is_n_sensor_valid[2] && !data.is_n_sensor_valid[3])
-    {
-        status_n1_r = -1;
-    }
-    else
-    {
-        if (n2 > 120)
-            status_n1_r = 2;
-        else if (n2 > 105)
-            status_n1_r = 1;
-        else
-            status_n1_r = 0;
-    }
+    int status_n1_l = -1;
+    if (data.isNSensorValid(0) || data.isNSensorValid(1))
+        status_n1_l = rules->gaugeLevel(SensorChannel::RPM_1, n1 * rpm_per_percent, state);
 
-    int status_egt_l = 0;
-    if (!data.is_egt_sensor_valid[0] && !data.is_egt_sensor_valid[1])
-    {
-        status_egt_l = -1;
-    }
-    else
-    {
-        if (state == EngineState::STARTING)
-        {
-            if (data.egt1_temp > 1000)
-                status_egt_l = 2;
-            else if (data.egt1_temp > 850)
-                status_egt_l = 1;
-        }
-        else
-        {
-            if (data.egt1_temp > 1100)
-                status_egt_l = 2;
-            else if (data.egt1_temp > 950)
-                status_egt_l = 1;
-        }
-    }
+    int status_n1_r = -1;
+    if (data.isNSensorValid(2) || data.isNSensorValid(3))
+        status_n1_r = rules->gaugeLevel(SensorChannel::RPM_2, n2 * rpm_per_percent, state);
 
-    int status_egt_r = 0;
-    if (!data.is_egt_sensor_valid[2] && !data.is_egt_sensor_valid[3])
-    {
-        status_egt_r = -1;
-    }
-    else
-    {
-        if (state == EngineState::STARTING)
-        {
-            if (data.egt2_temp > 1000)
-                status_egt_r = 2;
-            else if (data.egt2_temp > 850)
-                status_egt_r = 1;
-        }
-        else
-        {
-            if (data.egt2_temp > 1100)
-                status_egt_r = 2;
-            else if (data.egt2_temp > 950)
-                status_egt_r = 1;
-        }
-    }
+    int status_egt_l = -1;
+    if (data.isEgtSensorValid(0) || data.isEgtSensorValid(1))
+        status_egt_l = rules->gaugeLevel(SensorChannel::EGT_1, data.egt1_temp, state);
+
+    int status_egt_r = -1;
+    if (data.isEgtSensorValid(2) || data.isEgtSensorValid(3))
+        status_egt_r = rules->gaugeLevel(SensorChannel::EGT_2, data.egt2_temp, state);
 
     drawGauge(300, 200, 110, n1, 0, 125, _T("N1 % (L)"), status_n1_l);
     drawGauge(724, 200, 110, n2, 0, 125, _T("N1 % (R)"), status_n1_r);
-    drawGauge(300, 420, 90, data.egt1_temp, -5, 1200, _T("EGT C (L)"), status_egt_l);
-    drawGauge(724, 420, 90, data.egt2_temp, -5, 1200, _T("EGT C (R)"), status_egt_r);
+    drawGauge(300, 420, 90, data.egt1_temp, -5, 1200, _T("EGT °C (L)"), status_egt_l);
+    drawGauge(724, 420, 90, data.egt2_temp, -5, 1200, _T("EGT °C (R)"), status_egt_r);
 
     for (int i = 0; i < 14; i++)
     {
         drawButton(fault_buttons[i], fault_labels[i], COLOR_BTN_FAULT);
     }
 
-    drawCASList(detected_errors);
+    drawCASList(detected_errors, detected_count);
 
     int info_x = 430;
     int info_y = 250;
     setlinecolor(COLOR_GAUGE_FACE);
 
     drawInfoBox(info_x, info_y, _T("Fuel Flow"), data.fuel_v, _T("kg/h"), true);
-    drawInfoBox(info_x, info_y + 30, _T("Fuel Qty"), data.fuel_c, _T("kg"), data.is_fuel_valid);
+    drawInfoBox(info_x, info_y + 30, _T("Fuel Qty"), data.fuel_c, _T("kg"), data.fuel_valid != 0);
 
     bool is_start = (state == EngineState::STARTING);
     setfillcolor(is_start ? COLOR_CAUTION : RGB(40, 40, 40));
     solidcircle(info_x + 50, info_y + 80, 8);
     settextcolor(is_start ? COLOR_CAUTION : RGB(100, 100, 100));
-    settextstyle(16, 0, _T("΢ź"));
+    settextstyle(16, 0, _T("微软雅黑"));
     outtextxy(info_x + 70, info_y + 70, _T("STARTING"));
 
     setfillcolor(is_running_light_on ? RGB(0, 255, 0) : RGB(40, 40, 40));
@@ -376,9 +294,9 @@ void UI::draw(double time, const EngineData &data, EngineState state, bool is_ru
     FlushBatchDraw();
 }
 
-void UI::drawCASList(const std::vector<ErrorType> &errors)
+void UI::drawCASList(const ErrorType *errors, int count)
 {
-    if (errors.empty())
+    if (count <= 0)
         return;
 
     int start_x = 362;
@@ -388,7 +306,7 @@ void UI::drawCASList(const std::vector<ErrorType> &errors)
 
     settextstyle(22, 0, _T("Consolas"));
 
-    for (size_t i = 0; i < errors.size(); i++)
+    for (int i = 0; i < count; i++)
     {
         ErrorType err = errors[i];
         std::wstring msg = getErrorString(err);
@@ -396,7 +314,7 @@ void UI::drawCASList(const std::vector<ErrorType> &errors)
             continue;
 
         COLORREF color = getAlertColor(err);
-        int current_y = start_y + (int)i * item_height;
+        int current_y = start_y + i * item_height;
 
         setfillcolor(RGB(20, 20, 20));
         setlinecolor(color);
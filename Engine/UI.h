@@ -1,5 +1,6 @@
 #pragma once
 #include "DataStructrue.h"
+#include "EICASRules.h"
 #include <graphics.h>
 #include <string>
 #include <vector>
@@ -11,8 +12,11 @@ public:
     ~UI();
 
     void init();
-    void draw(double time, const EngineData &data, EngineState state, bool is_running_light_on, double n1, double n2,
-              const std::vector<ErrorType> &detected_errors);
+
+    // 仪表着色使用的告警门限, 应与 EICAS::setRules 传入同一份 (为空时使用内置门限)
+    void setRules(const EICASRuleProgram *rules);
+    void draw(double time, const EngineSnapshot &data, EngineState state, bool is_running_light_on, double n1, double n2,
+              const ErrorType *detected_errors, int detected_count);
 
     std::wstring getErrorString(ErrorType error);
 
@@ -24,7 +28,7 @@ private:
     void drawButton(RECT r, const std::wstring &text, COLORREF color, COLORREF hover_color = 0);
     void drawInfoBox(int x, int y, const std::wstring &label, double value, const std::wstring &unit,
                      bool is_valid = true);
-    void drawCASList(const std::vector<ErrorType> &errors);
+    void drawCASList(const ErrorType *errors, int count);
 
     RECT btn_start_rect;
     RECT btn_stop_rect;
@@ -33,4 +37,6 @@ private:
 
     RECT fault_buttons[14];
     const wchar_t *fault_labels[14];
+
+    const EICASRuleProgram *rules;
 };
\ No newline at end of file
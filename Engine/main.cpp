@@ -1,10 +1,18 @@
 #include "EICAS.h"
 #include "Logger.h"
+#include "Profiler.h"
+#include "SimThread.h"
+#include "Trace.h"
 #include "Simulator.h"
+#include "TelemetryShm.h"
 #include "Timer.h"
 #include "UI.h"
 #include <Windows.h>
-#include <comdef.h>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#pragma comment(lib, "winmm.lib")
 
 int main()
 {
@@ -12,30 +20,82 @@ int main()
     EICAS eicas;
     UI ui;
     Logger logger;
-    Timer timer(0.005);
 
-    srand((unsigned int)time(0));
+    sim.seed((uint64_t)time(0));
+
+    // 告警门限: 工作目录下有 eicas_limits.cfg 时按环境变量 ENGINE_TYPE 指定的型号 (默认 default) 加载,
+    // 否则使用内置门限; EICAS 判断和仪表着色共用这一份
+    EICASRuleProgram rules;
+    {
+        char *env = nullptr;
+        size_t env_size = 0;
+        bool has_type = _dupenv_s(&env, &env_size, "ENGINE_TYPE") == 0 && env != nullptr;
+        std::string engine_type = has_type ? env : "default";
+        std::free(env);
+
+        EngineLimits limits;
+        std::string error;
+        if (loadEngineLimits("eicas_limits.cfg", engine_type, limits, error))
+            rules.compile(limits);
+        else if (has_type)
+            std::printf("%s, using built-in limits\n", error.c_str());
+    }
+    eicas.setRules(&rules);
+    ui.setRules(&rules);
+
+    // 仿真、告警判断和日志在独立线程上按 5ms 定步长运行, 本线程只负责输入和绘制
+    SimThread sim_thread(sim, eicas, logger, 0.005);
+
+    // 各阶段耗时统计常开, 按 F8 输出到控制台, 退出时也会输出
+    Profiler profiler;
+    sim_thread.setProfiler(&profiler);
+
+    // 每步快照写入共享内存环形缓冲, 外部工具可用 engine_shm_reader 旁路读取; 创建失败不影响仿真
+    TelemetryPublisher telemetry;
+    if (telemetry.open("engine_telemetry", 4096, 0.005))
+        sim_thread.setTelemetry(&telemetry);
+
+    // 界面按约 60 帧每秒刷新, 帧间休眠; 提高系统定时器精度以减少休眠误差
+    Timer frame_timer(1.0 / 60.0);
+    timeBeginPeriod(1);
+    frame_timer.setPacing(true);
 
     ui.init();
     BeginBatchDraw();
+    sim_thread.start();
+
+    TRACE_THREAD_NAME("ui");
 
     bool running = true;
     while (running)
     {
-        timer.tick();
+        frame_timer.tick();
+        while (frame_timer.consumeStep())
+        {
+            // 界面帧计时只用于控制刷新节拍
+        }
 
-        int cmd = ui.handleInput();
+        TRACE_SCOPE("ui", "frame");
+        Profiler::Clock::time_point frame_start = Profiler::Clock::now();
+        profiler.add(ProfileCounter::UI_FRAMES);
+
+        int cmd;
+        {
+            TRACE_SCOPE("ui", "input");
+            ProfileScope scope(&profiler, ProfilePhase::UI_INPUT);
+            cmd = ui.handleInput();
+        }
 
         if (cmd == 1)
-            sim.startEngine();
+            sim_thread.sendCommand(SimCommandType::START);
         if (cmd == 2)
-            sim.stopEngine();
+            sim_thread.sendCommand(SimCommandType::STOP);
         if (cmd == 3)
-            sim.addDash();
+            sim_thread.sendCommand(SimCommandType::ADD_DASH);
         if (cmd == 4)
-            sim.reduceDash();
+            sim_thread.sendCommand(SimCommandType::REDUCE_DASH);
 
-        // ע
+        // 注入故障
         if (cmd >= 100 && cmd < 114)
         {
             int fault_index = cmd - 100;
@@ -44,55 +104,47 @@ int main()
                                  ErrorType::LOW_FUEL,       ErrorType::OVERSPEED_N1_1, ErrorType::OVERSPEED_N1_2,
                                  ErrorType::OVERHEAT_EGT_1, ErrorType::OVERHEAT_EGT_2, ErrorType::OVERHEAT_EGT_3,
                                  ErrorType::OVERHEAT_EGT_4, ErrorType::OVERSPEED_FUEL};
-            sim.setErrorType(types[fault_index]);
+            sim_thread.sendCommand(SimCommandType::SET_FAULT, types[fault_index]);
         }
 
-        while (timer.consumeStep())
-        {
-            sim.update();
-            logger.log(timer.getSimulationTime(), sim.getData());
-        }
-
-        EngineData raw_data = sim.getData();
-        EngineState eng_state = sim.getState();
+        // 取仿真线程最新发布的状态, 不等待
+        sim_thread.updateSnapshot();
+        const SimSnapshot &snap = sim_thread.getSnapshot();
 
-        std::vector<ErrorType> detected_errors = eicas.judge(raw_data, eng_state, timer.getSimulationTime());
-
-        // Զͣ߼
-        bool critical_failure = false;
-        for (const auto &err : detected_errors)
         {
-            if (err == ErrorType::SENSOR_ALL || err == ErrorType::OVERSPEED_N1_2 || err == ErrorType::OVERHEAT_EGT_2 ||
-                err == ErrorType::OVERHEAT_EGT_4)
-            {
-                critical_failure = true;
-                break;
-            }
+            TRACE_SCOPE("ui", "draw");
+            ProfileScope scope(&profiler, ProfilePhase::UI_DRAW);
+            ui.draw(snap.time, snap.data, snap.state, snap.stabilized, snap.n1, snap.n2, snap.alerts,
+                    snap.alert_count);
         }
 
-        if (critical_failure)
-        {
-            if (eng_state != EngineState::OFF && eng_state != EngineState::STOPPING)
-            {
-                sim.stopEngine();
-                logger.logAlert(timer.getSimulationTime(), "SYSTEM: AUTO SHUTDOWN TRIGGERED");
-            }
-        }
+        if (GetAsyncKeyState(VK_ESCAPE))
+            running = false;
 
-        for (const auto &err : detected_errors)
+        if (GetAsyncKeyState(VK_F8) & 1)
+            profiler.dump(stdout);
+
+        profiler.record(ProfilePhase::UI_FRAME, (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                                    Profiler::Clock::now() - frame_start)
+                                                    .count());
         {
-            std::wstring w_msg = ui.getErrorString(err);
-            std::string msg = (const char *)_bstr_t(w_msg.c_str());
-            logger.logAlert(timer.getSimulationTime(), msg);
+            TRACE_SCOPE("ui", "wait");
+            frame_timer.waitNextStep();
         }
-
-        ui.draw(timer.getSimulationTime(), raw_data, sim.getState(), sim.isStabilized(), sim.getN1(), sim.getN2(),
-                detected_errors);
-
-        if (GetAsyncKeyState(VK_ESCAPE))
-            running = false;
     }
 
+    sim_thread.stop();
+#ifdef ENGINE_ENABLE_TRACING
+    Trace::exportJson("engine_trace.json");
+#endif
     EndBatchDraw();
+    timeEndPeriod(1);
+
+    profiler.dump(stdout);
+
+    PacingStats pacing = sim_thread.getPacingStats();
+    std::printf("sim pacing: %llu waits, late min %.1f us, mean %.1f us, p99 %.1f us, max %.1f us\n",
+                (unsigned long long)pacing.waits, pacing.min_late_us, pacing.mean_late_us, pacing.p99_late_us,
+                pacing.max_late_us);
     return 0;
-}
\ No newline at end of file
+}